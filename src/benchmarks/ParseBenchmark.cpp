@@ -0,0 +1,127 @@
+//
+//  Times the parse of a single function of N statements for growing N, to check that the cost
+//  of a statement does not depend on how many came before it. The driver runs syntax only, so
+//  nothing is analysed or generated. Preprocessing is timed on its own and taken away, leaving
+//  the scanner and the bison parser with its grammar actions
+//
+//  Usage : del_parse_benchmark [N ...]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "del_driver.hpp"
+#include "Errors.hpp"
+#include "Preprocessor.hpp"
+
+namespace
+{
+    // Each size is run this many times and the fastest kept, to take out scheduling noise
+    constexpr int RUNS = 3;
+
+    //  Write a function that reassigns the same variable 'statements' times
+    std::string write_source(const std::string & directory, uint64_t statements)
+    {
+        std::string path = directory + "/bench_" + std::to_string(statements) + ".del";
+
+        std::ofstream out(path);
+        out << "def main() -> int {\n";
+        out << "    int a = 0;\n";
+        for(uint64_t i = 0; i < statements; i++)
+        {
+            out << "    a = a + 1;\n";
+        }
+        out << "    return a;\n";
+        out << "}\n";
+        return path;
+    }
+
+    double time_preprocess(const std::string & source)
+    {
+        DEL::DEL_Driver driver;
+        DEL::Errors errors(driver);
+        DEL::Preprocessor preproc(errors);
+
+        auto start = std::chrono::steady_clock::now();
+        preproc.process(source.c_str());
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double time_parse(const std::string & source, bool & parsed)
+    {
+        DEL::DEL_Driver driver;
+        driver.set_syntax_only(true);
+
+        auto start = std::chrono::steady_clock::now();
+        parsed = driver.parse(source.c_str());
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    std::vector<uint64_t> sizes;
+    for(int i = 1; i < argc; i++)
+    {
+        sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+    }
+    if(sizes.empty())
+    {
+        sizes = { 25000, 50000, 100000 };
+    }
+
+    char pattern[] = "/tmp/del_bench_XXXXXX";
+    if(::mkdtemp(pattern) == nullptr)
+    {
+        std::cerr << "Unable to create a directory for the generated sources" << std::endl;
+        return 1;
+    }
+    std::string directory = pattern;
+
+    std::cout << std::setw(10) << "N" << std::setw(14) << "preprocess s" << std::setw(10) << "parse s"
+              << std::setw(16) << "us / statement" << std::endl;
+
+    int result = 0;
+    for(auto statements : sizes)
+    {
+        std::string source = write_source(directory, statements);
+
+        double preprocess = 0.0;
+        double total = 0.0;
+        for(int run = 0; run < RUNS; run++)
+        {
+            bool parsed = false;
+            double p = time_preprocess(source);
+            double t = time_parse(source, parsed);
+
+            if(!parsed)
+            {
+                std::cerr << "Parse of " << statements << " statements failed" << std::endl;
+                result = 1;
+            }
+
+            preprocess = (run == 0) ? p : std::min(preprocess, p);
+            total      = (run == 0) ? t : std::min(total, t);
+        }
+
+        double parse = std::max(total - preprocess, 0.0);
+
+        std::cout << std::setw(10) << statements << std::fixed
+                  << std::setw(14) << std::setprecision(3) << preprocess
+                  << std::setw(10) << std::setprecision(3) << parse
+                  << std::setw(16) << std::setprecision(2) << (parse * 1e6 / statements) << std::endl;
+
+        ::unlink(source.c_str());
+    }
+
+    ::rmdir(directory.c_str());
+    return result;
+}
@@ -0,0 +1,16 @@
+set(DEL_BENCHMARK_DIR
+    ${CMAKE_CURRENT_SOURCE_DIR}/benchmarks
+)
+
+# Not run as part of the build, timings are only meaningful on a quiet machine. Times the front end
+# alone, see ParseBenchmark.cpp
+add_executable(del_parse_benchmark
+        ${DEL_BENCHMARK_DIR}/ParseBenchmark.cpp
+        ${DEL_COMPILER_SOURCES}
+)
+
+target_link_libraries(del_parse_benchmark
+    PRIVATE
+        ${LIBNABLA_LIBRARIES}
+        Threads::Threads
+)
@@ -0,0 +1,85 @@
+#include "Arena.hpp"
+
+#include <cstdint>
+
+namespace DEL
+{
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    Arena::Arena(std::size_t block_size) : block_size(block_size),
+                                           current_block(0),
+                                           offset(0)
+    {
+
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    Arena::~Arena()
+    {
+        reset();
+
+        for(auto & block : blocks)
+        {
+            ::operator delete(block.data);
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Arena::reset()
+    {
+        // Destroy in reverse so objects go before anything they were built from
+        for(auto it = destructors.rbegin(); it != destructors.rend(); ++it)
+        {
+            it->destroy(it->object);
+        }
+        destructors.clear();
+
+        current_block = 0;
+        offset = 0;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void * Arena::allocate(std::size_t size, std::size_t alignment)
+    {
+        while(true)
+        {
+            while(current_block < blocks.size())
+            {
+                // Align the address rather than the offset, the block itself may be less aligned than asked for
+                uintptr_t base      = reinterpret_cast<uintptr_t>(blocks[current_block].data);
+                std::size_t aligned = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+
+                if(aligned + size <= blocks[current_block].size)
+                {
+                    offset = aligned + size;
+                    return blocks[current_block].data + aligned;
+                }
+
+                // Move on to the next block, if there is one from before a reset
+                current_block++;
+                offset = 0;
+            }
+
+            // Out of blocks, get a new one. Anything larger than a block gets a block of its own.
+            // Blocks from operator new are only aligned for the fundamental types, so leave room to
+            // align anything stricter than that within the block
+            std::size_t needed = size + alignment - 1;
+            std::size_t new_size = (needed > block_size) ? needed : block_size;
+
+            blocks.push_back({static_cast<char*>(::operator new(new_size)), new_size});
+            current_block = blocks.size() - 1;
+            offset = 0;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef DEL_ARENA_HPP
+#define DEL_ARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DEL
+{
+    //! \brief A bump allocator that owns everything made from it. Objects are never freed
+    //!        individually, instead the whole arena is reset at once and its blocks are reused
+    class Arena
+    {
+    public:
+        //! \brief Create an arena
+        //! \param block_size Size of each block of memory requested from the system
+        Arena(std::size_t block_size = 64 * 1024);
+
+        //! \brief Destroy all objects and release all blocks
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        //! \brief Construct an object within the arena
+        //! \param args Arguments for the object's constructor
+        //! \returns Pointer to the object, valid until the next reset
+        template<class T, class... Args>
+        T * make(Args&&... args)
+        {
+            T * object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+            // Only objects that own something need to be told when the arena is reset
+            if constexpr (!std::is_trivially_destructible<T>::value)
+            {
+                destructors.push_back({object, [](void * o) { static_cast<T*>(o)->~T(); }});
+            }
+            return object;
+        }
+
+        //! \brief Destroy every object made since the last reset, keeping the memory for reuse
+        void reset();
+
+    private:
+
+        void * allocate(std::size_t size, std::size_t alignment);
+
+        struct Block
+        {
+            char * data;
+            std::size_t size;
+        };
+
+        struct Destructor
+        {
+            void * object;
+            void (*destroy)(void*);
+        };
+
+        std::size_t block_size;
+        std::vector<Block> blocks;
+        std::size_t current_block;
+        std::size_t offset;
+
+        std::vector<Destructor> destructors;
+    };
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define DEL_AST_HPP
 
 #include "Types.hpp"
+#include <utility>
 #include <vector>
 
 namespace DEL
@@ -12,34 +13,67 @@ namespace DEL
     class Node
     {
     public:
-        Node(NodeType type) : node_type(type), val_type(ValType::NONE) {}
+        Node(NodeType type) : node_type(type), val_type(ValType::NONE), symbol(NO_SYMBOL) {}
 
         NodeType node_type;
         ValType val_type;
-        std::string value;
+        Literal value;      // Set for NodeType::VAL
+        SymbolId symbol;    // Set for NodeType::ID
     };
 
+    class Call;
+
     //
     //  A tree
     //
     class AST : public Node 
     {
     public: 
-        AST() : Node(NodeType::ROOT), l(nullptr), r(nullptr) {}
+        AST() : Node(NodeType::ROOT), l(nullptr), r(nullptr), call(nullptr) {}
         AST(NodeType type, AST*lhs, AST*rhs) : Node(type),
                                                l(lhs), 
-                                               r(rhs) {}
+                                               r(rhs),
+                                               call(nullptr) {}
 
-        AST(NodeType type, AST*lhs, AST*rhs, ValType v, std::string a): Node(type),
+        AST(NodeType type, AST*lhs, AST*rhs, ValType v, Literal a): Node(type),
                                                l(lhs), 
-                                               r(rhs) 
+                                               r(rhs),
+                                               call(nullptr)
         {
             this->val_type = v;
             this->value = a;
         }
 
+        AST(NodeType type, AST*lhs, AST*rhs, ValType v, SymbolId s): Node(type),
+                                               l(lhs), 
+                                               r(rhs),
+                                               call(nullptr)
+        {
+            this->val_type = v;
+            this->symbol = s;
+        }
+
+        // A call used within an expression
+        AST(Call * call);
+
         AST * l;
         AST * r;
+        Call * call;    // Set for NodeType::CALL
+    };
+
+    //
+    //  A range bound or step, given as a raw value or as a variable
+    //
+    class Bound
+    {
+    public:
+        explicit Bound(Literal value) : symbol(NO_SYMBOL), value(value) {}
+        explicit Bound(SymbolId symbol) : symbol(symbol) {}
+
+        bool is_variable() const { return symbol != NO_SYMBOL; }
+
+        SymbolId symbol;
+        Literal value;
     };
 
     //
@@ -49,12 +83,12 @@ namespace DEL
     {
     public: 
         // Create a range
-        Range(ValType type, std::string from, std::string to, int line) : 
+        Range(ValType type, Bound from, Bound to, int line) : 
             type(type), from(from), to(to), line_no(line){}
 
         ValType type;
-        std::string from;
-        std::string to;
+        Bound from;
+        Bound to;
         int line_no;
     };
 
@@ -64,10 +98,10 @@ namespace DEL
     class Step
     {
     public:
-        Step(ValType type, std::string val) : type(type), val(val){}
+        Step(ValType type, Bound val) : type(type), val(val){}
 
         ValType type;
-        std::string val;
+        Bound val;
     };
     
     //
@@ -101,13 +135,13 @@ namespace DEL
     class Assignment : public Element
     {
     public:
-        Assignment(ValType type, std::string lhs, AST * rhs) : data_type(type),
-                                                                lhs(lhs),
-                                                                rhs(rhs){}
+        Assignment(ValType type, SymbolId lhs, AST * rhs) : data_type(type),
+                                                             lhs(lhs),
+                                                             rhs(rhs){}
         virtual void visit(Visitor &visit) override;
 
         ValType data_type;
-        std::string lhs;
+        SymbolId lhs;
         AST * rhs;
     };
 
@@ -117,14 +151,14 @@ namespace DEL
     class If : public Element
     {
     public:
-        If(IfType type, AST * expr, ElementList elements, Element * trail, int line) : type(type), expr(expr), element_list(elements), trail(trail)
+        If(IfType type, AST * expr, ElementList elements, Element * trail, int line) : type(type), expr(expr), element_list(std::move(elements)), trail(trail), var_name(NO_SYMBOL)
         {
             line_no = line;
         }
 
         virtual void visit(Visitor &visit) override;
 
-        void set_var_name(std::string var)
+        void set_var_name(SymbolId var)
         {
             var_name = var;
         }
@@ -133,7 +167,7 @@ namespace DEL
         AST * expr;
         ElementList element_list;
         Element * trail;
-        std::string var_name;
+        SymbolId var_name;
     };
 
     //
@@ -157,13 +191,13 @@ namespace DEL
     class ForLoop : public Element
     {
     public: 
-        ForLoop(ValType type, std::string id, Range * range, Step * step, ElementList elements) : 
-            type(type), id(id), range(range), step(step), elements(elements){}
+        ForLoop(ValType type, SymbolId id, Range * range, Step * step, ElementList elements) : 
+            type(type), id(id), range(range), step(step), elements(std::move(elements)){}
 
         virtual void visit(Visitor &visit) override;
         
         ValType type;
-        std::string id;
+        SymbolId id;
         Range * range;
         Step * step;
         ElementList elements;
@@ -175,7 +209,7 @@ namespace DEL
     class WhileLoop : public Element
     {
     public:
-        WhileLoop(AST * expression, ElementList list) : expr(expression), elements(list){}
+        WhileLoop(AST * expression, ElementList list) : expr(expression), elements(std::move(list)){}
 
         virtual void visit(Visitor &visit) override;
         
@@ -192,8 +226,8 @@ namespace DEL
     
         virtual void visit(Visitor &visit) override;
 
-        AnnulStmt(std::string variable) : var(variable) {}
-        std::string var;
+        AnnulStmt(SymbolId variable) : var(variable) {}
+        SymbolId var;
     };
 
     //
@@ -202,34 +236,27 @@ namespace DEL
     class NamedLoop : public Element
     {
     public:
-        NamedLoop(std::string name, ElementList list) : name(name), elements(list){}
+        NamedLoop(SymbolId name, ElementList list) : name(name), elements(std::move(list)){}
 
         virtual void visit(Visitor &visit) override;
         
-        std::string name;
+        SymbolId name;
         ElementList elements;
     };
 
     //
     //  A call 
     //
-    class Call : public Element, public AST
+    class Call : public Element
     {
     public:
         // Creation for something to use it as an element
-        Call(std::string name, std::vector<FunctionParam> params) : 
-            AST(NodeType::CALL, nullptr, nullptr), 
-            name(name), params(params) {}
-
-        // Creation for something to use it as part of an AST
-        Call(std::string name, std::vector<FunctionParam> params, AST * lhs, AST * rhs) : 
-            AST(NodeType::CALL, lhs, rhs, ValType::REQ_CHECK, name),
-            name(name), params(params){}
+        Call(SymbolId name, std::vector<FunctionParam> params) : 
+            name(name), params(std::move(params)) {}
 
         // A call created given a line number
-        Call(std::string name, std::vector<FunctionParam> params, AST * lhs, AST * rhs, int line_no) : 
-            AST(NodeType::CALL, lhs, rhs, ValType::REQ_CHECK, name),
-            name(name), params(params)
+        Call(SymbolId name, std::vector<FunctionParam> params, int line_no) : 
+            name(name), params(std::move(params))
             {
                 this->line_no = line_no;
             }
@@ -237,10 +264,18 @@ namespace DEL
         // Let the visitor visit us
         virtual void visit(Visitor &visit) override;
 
-        std::string name;
+        SymbolId name;
         std::vector<FunctionParam> params;
     };
 
+    inline AST::AST(Call * call) : Node(NodeType::CALL), 
+                                   l(nullptr), 
+                                   r(nullptr), 
+                                   call(call)
+    {
+        this->val_type = ValType::REQ_CHECK;
+        this->symbol = call->name;
+    }
 
     //
     //  A function
@@ -248,10 +283,10 @@ namespace DEL
     class Function
     {
     public:
-        Function(std::string name, std::vector<FunctionParam> params, ValType return_type, ElementList elements, int line) :
-            name(name), params(params), return_type(return_type), elements(elements), line_no(line){}
+        Function(SymbolId name, std::vector<FunctionParam> params, ValType return_type, ElementList elements, int line) :
+            name(name), params(std::move(params)), return_type(return_type), elements(std::move(elements)), line_no(line){}
 
-        std::string name;
+        SymbolId name;
         std::vector<FunctionParam> params;
         ValType return_type;
         ElementList elements;
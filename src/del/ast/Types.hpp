@@ -1,10 +1,29 @@
 #ifndef DEL_TYPES_HPP
 #define DEL_TYPES_HPP
 
+#include <stdint.h>
 #include <string>
+#include <utility>
 
 namespace DEL
 {
+    //! \brief Id of an interned identifier, see Interner
+    typedef uint32_t SymbolId;
+
+    //! \brief A SymbolId that names nothing
+    static constexpr SymbolId NO_SYMBOL = UINT32_MAX;
+
+    //! \brief A raw value, decoded once by the scanner. Chars are held as integers
+    union Literal
+    {
+        Literal() : integer(0) {}
+        explicit Literal(uint64_t integer) : integer(integer) {}
+        explicit Literal(double real) : real(real) {}
+
+        uint64_t integer;
+        double real;
+    };
+
     enum class NodeType
     {
         ROOT,
@@ -76,9 +95,11 @@ namespace DEL
     // This maybe should move to another location 
     struct FunctionParam
     {
-        FunctionParam(ValType t, std::string id) : type(t), id(id) {}
-        ValType type;   // Type
-        std::string id; // The param name
+        FunctionParam(ValType t, SymbolId id) : type(t), id(id) {}
+        FunctionParam(ValType t, Literal value) : type(t), id(NO_SYMBOL), value(value) {}
+        ValType type;       // Type
+        SymbolId id;        // The param name
+        Literal value;      // Raw value given to a call in place of a name
     };
 
     static inline std::string ValType_to_string(ValType v)
@@ -1,16 +1,5 @@
 #include "Codegen.hpp"
 
-#include "Codeblock.hpp"
-#include "Alloc.hpp"
-#include "BlockAggregator.hpp"
-#include "LoadStore.hpp"
-#include "Operations.hpp"
-#include "Primitives.hpp"
-#include "ConditionalContext.hpp"
-#include "ForLoopContext.hpp"
-#include "WhileLoopContext.hpp"
-
-#include <iostream>
 #include <vector>
 
 namespace DEL
@@ -19,12 +8,12 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    Codegen::Codegen(Errors & err, SymbolTable & symbolTable, Memory & memory) : 
-                                                                error_man(err), 
+    Codegen::Codegen(Errors & err, SymbolTable & symbolTable, Memory & memory) :
+                                                                error_man(err),
                                                                 symbol_table(symbolTable),
                                                                 memory_man(memory),
                                                                 building_function(false),
-                                                                label_id(0)
+                                                                worker_count(1)
     {
 
     }
@@ -35,31 +24,93 @@ namespace DEL
 
     Codegen::~Codegen()
     {
-        
+
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Codegen::set_worker_count(std::size_t count)
+    {
+        worker_count = (count == 0) ? 1 : count;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Codegen::reset()
+    {
+        // Functions may still be generating if the program was abandoned part way through. Whatever
+        // they ran into belongs to the abandoned program
+        if(pool)
+        {
+            try
+            {
+                pool->wait();
+            }
+            catch(InternalError &) {}
+        }
+        lowered.clear();
+
+        current_function.reset();
+        building_function = false;
+
+        generator.reset();
+        peephole_stats = PeepholeStats();
     }
 
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    std::vector<std::string> Codegen::indicate_complete()
+    const PeepholeStats & Codegen::get_peephole_stats() const
+    {
+        return peephole_stats;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    std::string Codegen::indicate_complete()
     {
         // Ensure we're not building a function
         if(building_function)
         {
-            std::cerr << "Developer Error : Codegen asked to indicate_complete while building a function " << std::endl;
-            exit(EXIT_FAILURE);
+            error_man.report_custom("Codegen", "Developer Error : Codegen asked to indicate_complete while building a function", true);
         }
 
         // Lock the symbol table so if an error comes out the dev (me) knows they did something dumb
         symbol_table.lock();
 
-        // Create a vector for the result
-        std::vector<std::string> result; 
-        
+        // Wait for the functions handed to the pool, and merge them in the order they were written
+        if(pool)
+        {
+            try
+            {
+                pool->wait();
+            }
+            catch(InternalError & e)
+            {
+                error_man.report_custom(e.from, e.what(), true);
+            }
+            pool.reset();
+        }
+
+        for(auto & lowering : lowered)
+        {
+            merge(*lowering);
+        }
+        lowered.clear();
+
+        // Create a string for the result
+        std::string result;
+
         // Indicate to the generator that we are complete
         generator.complete_code_generation(result);
- 
+
         // Return the asm
         return result;
     }
@@ -72,18 +123,15 @@ namespace DEL
     {
         if(building_function)
         {
-            std::cerr << "Internal Error >>> Codegen asked to start function while building function "
-                      << "grammar should have prevented this!!!" << std::endl;
-            exit(EXIT_FAILURE);
+            error_man.report_custom("Codegen", "Internal Error : Codegen asked to start function while building function. "
+                                               "grammar should have prevented this!!!", true);
         }
 
         // Flag function building
         building_function = true;
 
-        // Create a new function object
-        current_function = new CODE::Function(name, params);
-
-        current_aggregator = current_function;
+        // Create a new function record
+        current_function.reset(new Lowering(name, params));
     }
 
     // ----------------------------------------------------------
@@ -95,26 +143,59 @@ namespace DEL
         // Ensure we're building a function
         if(!building_function)
         {
-            std::cerr << "Developer Error : Codegen asked to end function while not building function "
-                      << "grammar should have prevented this!!!" << std::endl;
-            exit(EXIT_FAILURE);
+            error_man.report_custom("Codegen", "Developer Error : Codegen asked to end function while not building function. "
+                                               "grammar should have prevented this!!!", true);
         }
 
         // Unflag function building
         building_function = false;
 
-        // Reset label id
-        label_id = 0;
+        //  Indicate how many bytes the function will require to perform all of its operations. The memory
+        //  manager is reset once the function ends, so this has to be read now
+        current_function->record_end(memory_man.get_currently_allocated_bytes_amnt());
 
-        //  Indicate how many bytes the function will require to perform all of its operations
-        current_function->add_required_bytes(memory_man.get_currently_allocated_bytes_amnt());
+        // Generate the function here and now
+        if(worker_count == 1)
+        {
+            try
+            {
+                current_function->run();
+            }
+            catch(InternalError & e)
+            {
+                error_man.report_custom(e.from, e.what(), true);
+            }
+            merge(*current_function);
+            current_function.reset();
+            return;
+        }
 
-        // Finalize the function build with building_complete() and pass the result to the generator to store the 
-        // resulting code
-        generator.add_instructions(current_function->building_complete());
+        // Hand the function to the pool. The output keeps source order as the results are merged at the end
+        if(!pool)
+        {
+            pool.reset(new WorkPool(worker_count));
+        }
+
+        Lowering * lowering = current_function.get();
+        lowered.push_back(std::move(current_function));
 
-        // Delete the function object
-        delete current_function;
+        pool->submit([lowering]() { lowering->run(); });
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Codegen::merge(Lowering & lowering)
+    {
+        for(auto & module : lowering.get_builtins())
+        {
+            generator.include_builtin_math(module);
+        }
+
+        peephole_stats += lowering.get_peephole_stats();
+
+        generator.add_instructions(lowering.take_code());
     }
 
     // ----------------------------------------------------------
@@ -123,10 +204,7 @@ namespace DEL
 
     void Codegen::begin_conditional(CODEGEN::TYPES::ConditionalInitiation conditional_init)
     {
-        aggregators.push(new CODE::ConditionalContext(conditional_init));
-        
-        // Switch the current aggregator to the conditional context
-        current_aggregator = aggregators.top();
+        current_function->record_begin_conditional(conditional_init);
     }
 
     // ----------------------------------------------------------
@@ -135,12 +213,7 @@ namespace DEL
 
     void Codegen::extend_conditional(CODEGEN::TYPES::ConditionalInitiation conditional_init)
     {
-        // Extend the current conditional context with the information given
-        // Aggregator should not change here
-
-        CODE::ConditionalContext * cc = static_cast<CODE::ConditionalContext*>(aggregators.top());
-        
-        cc->extend_context(conditional_init);
+        current_function->record_extend_conditional(conditional_init);
     }
 
     // ----------------------------------------------------------
@@ -149,37 +222,7 @@ namespace DEL
 
     void Codegen::end_conditional()
     {
-        if(aggregators.empty())
-        {
-            std::cerr << "Developer Error : Codegen asked to end a conditional, but no conditional detected" << std::endl;
-            exit(EXIT_FAILURE);
-        }
-
-        // Get the context off of the stack
-        CODE::ConditionalContext * conditional = static_cast<CODE::ConditionalContext*>(aggregators.top());
-
-        // Pop
-        aggregators.pop();
-
-        // Export the conditional as a block - It will be consumed (and deleted by) current_aggregator
-        CODE::Block * exported_block = conditional->export_as_block();
-
-        // If the stack is empty redirect the aggregator to be the current function
-        if(aggregators.empty())
-        {
-            current_aggregator = current_function;
-        }
-        else
-        {
-            // Otherwise, we want the next context in the stack
-            current_aggregator = aggregators.top();
-        }
-
-        // Add contents to aggregator - might be the function, might be another context
-        current_aggregator->add_block(exported_block);
-
-        // Delete the conditional
-        delete conditional;
+        current_function->record_end_conditional();
     }
 
     // ----------------------------------------------------------
@@ -188,24 +231,7 @@ namespace DEL
 
     void Codegen::begin_loop(CODEGEN::TYPES::LoopIf * loop_if)
     {
-        switch(loop_if->type)
-        {
-            case CODEGEN::TYPES::LoopType::FOR:   
-                aggregators.push(new CODE::ForLoopContext(static_cast<CODEGEN::TYPES::ForLoopInitiation*>(loop_if))); 
-                break;
-            case CODEGEN::TYPES::LoopType::WHILE: 
-                aggregators.push(new CODE::WhileLoopContext(static_cast<CODEGEN::TYPES::WhileInitiation*>(loop_if))); 
-                break;
-            default:
-            {
-                std::cerr << "Codegen::begin_loop >>> Attempting to start loop, but an invalid loop type was given" << std::endl;
-                exit(EXIT_FAILURE);
-                break;
-            }
-        }
-
-        // Switch the current aggregator to the while loop context
-        current_aggregator = aggregators.top();
+        current_function->record_begin_loop(loop_if);
     }
 
     // ----------------------------------------------------------
@@ -214,68 +240,7 @@ namespace DEL
 
     void Codegen::end_loop(CODEGEN::TYPES::LoopType type)
     {
-        if(aggregators.empty())
-        {
-            std::cerr << "Developer Error : Codegen asked to end a for loop, but no loop detected" << std::endl;
-            exit(EXIT_FAILURE);
-        }
-
-        CODE::Block * exported_block;
-        CODE::BlockAggregator* block_agg;
-
-        switch(type)
-        {
-            case CODEGEN::TYPES::LoopType::FOR:
-            {
-                // Get the context off of the stack
-                CODE::ForLoopContext * loop = static_cast<CODE::ForLoopContext*>(aggregators.top());
-                block_agg = aggregators.top();
-
-                // Pop
-                aggregators.pop();
-
-                // Export the loop as a block - It will be consumed (and deleted by) current_aggregator
-                // Pass in the allocations so it can generate code to clean each loop pass
-                exported_block = loop->export_as_block();
-                break;
-            }
-            case CODEGEN::TYPES::LoopType::WHILE:
-            {
-                // Get the context off of the stack
-                CODE::WhileLoopContext * loop = static_cast<CODE::WhileLoopContext*>(aggregators.top());
-                block_agg = aggregators.top();
-
-                // Pop
-                aggregators.pop();
-
-                // Export the loop as a block - It will be consumed (and deleted by) current_aggregator
-                // Pass in the allocations so it can generate code to clean each loop pass
-                exported_block = loop->export_as_block();
-                break;
-            }
-            default:
-            {
-                std::cerr << "Codegen::end_loop >>> Attempting to end loop, but an invalid loop type was given" << std::endl;
-                exit(EXIT_FAILURE);
-                break;
-            }
-        }
-
-        // If the stack is empty redirect the aggregator to be the current function
-        if(aggregators.empty())
-        {
-            current_aggregator = current_function;
-        }
-        else
-        {
-            // Otherwise, we want the next context in the stack
-            current_aggregator = aggregators.top();
-        }
-
-        // Add contents to aggregator - might be the function, might be another context
-        current_aggregator->add_block(exported_block);
-
-        delete block_agg;
+        current_function->record_end_loop(type);
     }
 
     // ----------------------------------------------------------
@@ -287,91 +252,11 @@ namespace DEL
         // Ensure we're building a function
         if(!building_function)
         {
-            std::cerr << "Developer Error : Codegen asked to execute_command while not building function " << std::endl;
-            exit(EXIT_FAILURE);
+            error_man.report_custom("Codegen", "Developer Error : Codegen asked to execute_command while not building function", true);
         }
 
-        /*
-            command.id                    -> The name of the thing we are assigning for comments
-            command.memory_info           -> Where we need to store the thing
-            command.classification -> How to treat the given data (int, char, real)
-            command.instructions          -> What to do to the data in RPN form
-        */
-
-        // Execute the command from the caller
-        //
-        for(auto & ins : command.instructions)
-        {
-            switch(ins->instruction)
-            {
-                case CODEGEN::TYPES::InstructionSet::ADD:    current_aggregator->add_block(new CODE::Addition(command.classification));        break;                                          
-                case CODEGEN::TYPES::InstructionSet::SUB:    current_aggregator->add_block(new CODE::Subtraction(command.classification));     break;
-                case CODEGEN::TYPES::InstructionSet::DIV:    current_aggregator->add_block(new CODE::Division(command.classification));        break;
-                case CODEGEN::TYPES::InstructionSet::MUL:    current_aggregator->add_block(new CODE::Multiplication(command.classification));  break;
-
-                case CODEGEN::TYPES::InstructionSet::RSH:    current_aggregator->add_block(new CODE::RightShift());   break;
-                case CODEGEN::TYPES::InstructionSet::LSH:    current_aggregator->add_block(new CODE::LeftShift());    break;
-                case CODEGEN::TYPES::InstructionSet::BW_OR:  current_aggregator->add_block(new CODE::BwOr());         break;
-                case CODEGEN::TYPES::InstructionSet::BW_NOT: current_aggregator->add_block(new CODE::BwNot());        break;
-                case CODEGEN::TYPES::InstructionSet::BW_XOR: current_aggregator->add_block(new CODE::BwXor());        break;
-                case CODEGEN::TYPES::InstructionSet::BW_AND: current_aggregator->add_block(new CODE::BwAnd());        break;
-
-                case CODEGEN::TYPES::InstructionSet::LTE:    current_aggregator->add_block(new CODE::Lte(label_id++, command.classification)); break;
-                case CODEGEN::TYPES::InstructionSet::LT:     current_aggregator->add_block(new CODE::Lt (label_id++, command.classification)); break;
-                case CODEGEN::TYPES::InstructionSet::GTE:    current_aggregator->add_block(new CODE::Gte(label_id++, command.classification)); break;
-                case CODEGEN::TYPES::InstructionSet::GT:     current_aggregator->add_block(new CODE::Gt (label_id++, command.classification)); break;
-                case CODEGEN::TYPES::InstructionSet::EQ:     current_aggregator->add_block(new CODE::Eq (label_id++, command.classification)); break;
-                case CODEGEN::TYPES::InstructionSet::NE:     current_aggregator->add_block(new CODE::Neq(label_id++, command.classification)); break;
-                case CODEGEN::TYPES::InstructionSet::OR:     current_aggregator->add_block(new CODE::Or (label_id++, command.classification)); break;
-                case CODEGEN::TYPES::InstructionSet::AND:    current_aggregator->add_block(new CODE::And(label_id++, command.classification)); break;
-
-                case CODEGEN::TYPES::InstructionSet::NEGATE: current_aggregator->add_block(new CODE::Negate(label_id++, command.classification)); break;
-
-                case CODEGEN::TYPES::InstructionSet::CALL:   current_aggregator->add_block(new CODE::Call(static_cast<CODEGEN::TYPES::CallInstruction*>(ins))); break;
-
-                case CODEGEN::TYPES::InstructionSet::LOAD:  current_aggregator->add_block(new CODE::Load(static_cast<CODEGEN::TYPES::AddressValueInstruction*>(ins))); break;
-
-                case CODEGEN::TYPES::InstructionSet::STORE: current_aggregator->add_block(new CODE::Store(command.memory_info.start_pos, command.memory_info.bytes_requested, command.id)); break;
- 
-                case CODEGEN::TYPES::InstructionSet::MOVE_ADDRESS: current_aggregator->add_block(new CODE::MoveAddress(static_cast<CODEGEN::TYPES::MoveInstruction*>(ins))); break;
-
-                case CODEGEN::TYPES::InstructionSet::USE_RAW: current_aggregator->add_block(new CODE::SetupPrimitive(command.id, static_cast<CODEGEN::TYPES::RawValueInstruction*>(ins))); break;
-
-                case CODEGEN::TYPES::InstructionSet::POW:
-                {
-                    std::string function_name;
-                    generator.include_builtin_math_pow(command.classification, function_name);
-                    current_aggregator->add_block(new CODE::BuiltIn("POW", function_name));
-                    break;
-                }
-                case CODEGEN::TYPES::InstructionSet::MOD:
-                {
-                    std::string function_name;
-                    generator.include_builtin_math_mod(command.classification, function_name);
-                    current_aggregator->add_block(new CODE::BuiltIn("MOD", function_name));
-                    break;
-                }
-                case CODEGEN::TYPES::InstructionSet::RETURN:
-                {
-                    current_function->build_return();
-                    break;
-                }
-                case CODEGEN::TYPES::InstructionSet::DS_ALLOC:
-                {
-                    current_aggregator->add_block(new CODE::DSAllocate(static_cast<CODEGEN::TYPES::DSAllocInstruction*>(ins), command.memory_info.start_pos));
-
-                    current_aggregator->add_memory_alloc(command.memory_info);
-                    break;
-                }
-                default:
-                    error_man.report_custom("Codegen", "Developer error : Default accessed in command.", true);
-                    break;
-            }
-
-            /*
-                Instruction pointers are deleted by intermediate layer once this function returns
-            */
-        }
+        // The instructions now belong to the function record
+        current_function->record_command(std::move(command));
     }
 
     // ----------------------------------------------------------
@@ -383,11 +268,10 @@ namespace DEL
         // Ensure we're building a function
         if(!building_function)
         {
-            std::cerr << "Developer Error : Codegen asked to make a null_return while not building function " << std::endl;
-            exit(EXIT_FAILURE);
+            error_man.report_custom("Codegen", "Developer Error : Codegen asked to make a null_return while not building function", true);
         }
 
         // Tell the function to return without getting information from the stack
-        current_function->build_return(false);
+        current_function->record_null_return();
     }
-}
\ No newline at end of file
+}
@@ -9,9 +9,11 @@
 
 #include "CodegenTypes.hpp"
 #include "Generator.hpp"
-#include "Function.hpp"
+#include "Lowering.hpp"
+#include "WorkPool.hpp"
 
-#include <stack>
+#include <memory>
+#include <vector>
 
 namespace DEL
 {
@@ -29,9 +31,21 @@ namespace DEL
         //! \brief Deconstrut the code generator
         ~Codegen();
 
+        //! \brief Set how many functions may be generated at once
+        //! \param count Number of workers. 1 generates each function as it ends, on the calling thread
+        //! \note The output is the same for any count. Must be set before the first function is begun
+        void set_worker_count(std::size_t count);
+
+        //! \brief Discard everything generated, including a function being built, so the code
+        //!        generator can be used for another program
+        void reset();
+
+        //! \brief Get what the peephole optimizer changed in the functions generated so far
+        const PeepholeStats & get_peephole_stats() const;
+
         //! \brief Complete the generation of code
         //! \retval ASM generated by codegen
-        std::vector<std::string> indicate_complete();
+        std::string indicate_complete();
 
         //! \brief Begin function
         //! \param name The function name
@@ -75,23 +89,20 @@ namespace DEL
         Memory & memory_man;
         bool building_function;
 
-        uint64_t label_id;
-
         Generator generator;
+        PeepholeStats peephole_stats;
 
-        std::vector<std::string> program_init;
-        std::vector<std::string> program_instructions;
-
-        // A function being generated (an aggregator)
-        CODE::Function * current_function;
+        // The function being recorded
+        std::unique_ptr<Lowering> current_function;
 
-        // Directs block generation to destination for aggregation
-        CODE::BlockAggregator * current_aggregator;
+        // Functions handed to the pool, kept in source order until they are merged. The pool is
+        // declared last so it is destroyed (finishing its work) before the functions it is working on
+        std::size_t worker_count;
+        std::vector<std::unique_ptr<Lowering>> lowered;
+        std::unique_ptr<WorkPool> pool;
 
-        // As conditional statements come in they are pushed into this stack
-        // so we can have nested conditionals handled as they need to be.
-        // ConditionalContext objects are BlockAggregators
-        std::stack<CODE::BlockAggregator*> aggregators;
+        // Add a generated function to the output
+        void merge(Lowering & lowering);
     };
 }
 
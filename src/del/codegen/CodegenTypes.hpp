@@ -172,6 +172,7 @@ namespace TYPES
     {
     public:
         LoopIf(LoopType type) : type(type){}
+        virtual ~LoopIf() = default;
 
         LoopType type;
     };
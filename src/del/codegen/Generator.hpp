@@ -2,6 +2,7 @@
 #define DEL_GENERATOR_HPP
 
 #include "AsmSupport.hpp"
+#include "Buffer.hpp"
 #include "CodegenTypes.hpp"
 
 #include <vector>
@@ -22,28 +23,25 @@ namespace DEL
         //! \brief Destruct the generator
         ~Generator();
 
+        //! \brief Discard everything generated so the generator can be used for another program
+        void reset();
+
         //! \brief Inidcate complete
-        //! \param [out] output Vector to store resulting ASM
-        void complete_code_generation(std::vector<std::string> & output);
+        //! \param [out] output String to store resulting ASM
+        void complete_code_generation(std::string & output);
 
         //! \brief Add a group of instructions to the final ASM output
-        //! \param instructions The list of ASM instructions to be added
-        void add_instructions(std::vector<std::string> instructions);
-
-        //! \brief Indicate that we need to include the builtin POW function
-        //! \param classification The type (INTEGER, DOUBLE) that the function must be able to accomodate
-        //! \param out_function_name The name of the function that the caller can use to access the POW function
-        void include_builtin_math_pow(CODEGEN::TYPES::DataClassification classification, std::string & out_function_name);
+        //! \param instructions The ASM instructions to be added, linked in without copying
+        void add_instructions(CODE::Buffer instructions);
 
-        //! \brief Indicate that we need to include the builtin MOD function
-        //! \param classification The type (INTEGER, DOUBLE) that the function must be able to accomodate
-        //! \param out_function_name The name of the function that the caller can use to access the MOD function
-        void include_builtin_math_mod(CODEGEN::TYPES::DataClassification classification, std::string & out_function_name);
+        //! \brief Indicate that we need to include a builtin math module
+        //! \param module The module to include. Only one copy of each module is ever included
+        void include_builtin_math(AsmSupport::Math module);
 
     private:
         AsmSupport asm_support;
-        std::vector<std::string> built_ins_triggered;
-        std::vector<std::string> program_instructions;
+        std::string built_ins_triggered;
+        CODE::Buffer program_instructions;
     };
 }
 
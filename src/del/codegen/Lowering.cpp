@@ -0,0 +1,649 @@
+#include "Lowering.hpp"
+
+#include "Alloc.hpp"
+#include "BlockAggregator.hpp"
+#include "Expression.hpp"
+#include "LoadStore.hpp"
+#include "Operations.hpp"
+#include "Primitives.hpp"
+#include "ConditionalContext.hpp"
+#include "ForLoopContext.hpp"
+#include "WhileLoopContext.hpp"
+#include "RegisterAllocator.hpp"
+#include "Errors.hpp"
+
+#include <algorithm>
+
+namespace DEL
+{
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    Lowering::Lowering(std::string name, std::vector<CODEGEN::TYPES::ParamInfo> params) :
+                                                                name(std::move(name)),
+                                                                params(std::move(params)),
+                                                                bytes_required(0),
+                                                                current_function(nullptr),
+                                                                current_aggregator(nullptr)
+    {
+
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    Lowering::~Lowering()
+    {
+        // Anything left was recorded but never generated
+        for(auto & e : events)
+        {
+            for(auto & i : e.command.instructions)
+            {
+                delete i;
+            }
+        }
+
+        // A generation abandoned part way through leaves its contexts behind
+        while(!aggregators.empty())
+        {
+            delete aggregators.top();
+            aggregators.pop();
+        }
+        delete current_function;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::record_command(CODEGEN::TYPES::Command command)
+    {
+        events.push_back(Event{ EventType::COMMAND, std::move(command), {}, nullptr, {} });
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::record_begin_conditional(CODEGEN::TYPES::ConditionalInitiation conditional_init)
+    {
+        events.push_back(Event{ EventType::BEGIN_CONDITIONAL, {}, conditional_init.mem_info, nullptr, {} });
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::record_extend_conditional(CODEGEN::TYPES::ConditionalInitiation conditional_init)
+    {
+        events.push_back(Event{ EventType::EXTEND_CONDITIONAL, {}, conditional_init.mem_info, nullptr, {} });
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::record_end_conditional()
+    {
+        events.push_back(Event{ EventType::END_CONDITIONAL, {}, {}, nullptr, {} });
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::record_begin_loop(CODEGEN::TYPES::LoopIf * loop_if)
+    {
+        events.push_back(Event{ EventType::BEGIN_LOOP, {}, {}, std::unique_ptr<CODEGEN::TYPES::LoopIf>(loop_if), {} });
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::record_end_loop(CODEGEN::TYPES::LoopType type)
+    {
+        events.push_back(Event{ EventType::END_LOOP, {}, {}, nullptr, type });
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::record_null_return()
+    {
+        events.push_back(Event{ EventType::NULL_RETURN, {}, {}, nullptr, {} });
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::record_end(uint64_t bytes)
+    {
+        bytes_required = bytes;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::run()
+    {
+        // Every slot given space in the DS Device is freed on return, wherever the return is
+        std::vector<uint64_t> ds_slots;
+        for(auto & e : events)
+        {
+            for(auto & ins : e.command.instructions)
+            {
+                if(ins->instruction == CODEGEN::TYPES::InstructionSet::DS_ALLOC)
+                {
+                    ds_slots.push_back(e.command.memory_info.start_pos);
+                }
+            }
+        }
+
+        allocate_registers(!ds_slots.empty());
+
+        current_function = new CODE::Function(name, params, std::move(ds_slots), labels, registers);
+
+        current_aggregator = current_function;
+
+        for(auto & e : events)
+        {
+            switch(e.type)
+            {
+                case EventType::COMMAND:            execute_command(e.command);                                                      break;
+                case EventType::BEGIN_CONDITIONAL:  begin_conditional(CODEGEN::TYPES::ConditionalInitiation(e.conditional));         break;
+                case EventType::EXTEND_CONDITIONAL: extend_conditional(CODEGEN::TYPES::ConditionalInitiation(e.conditional));        break;
+                case EventType::END_CONDITIONAL:    end_conditional();                                                               break;
+                case EventType::BEGIN_LOOP:         begin_loop(e.loop.get());                                                        break;
+                case EventType::END_LOOP:           end_loop(e.loop_type);                                                           break;
+                case EventType::NULL_RETURN:        current_function->build_return(false);                                         break;
+            }
+        }
+
+        // Release the recording, and with it the loop information the loop contexts were given
+        events.clear();
+        events.shrink_to_fit();
+
+        //  Indicate how many bytes the function will require to perform all of its operations
+        current_function->add_required_bytes(bytes_required);
+
+        // Finalize the function build, and clean up the seams between its blocks
+        Peephole peephole;
+        code = peephole.optimize(current_function->building_complete());
+        peephole_stats = peephole.get_stats();
+
+        // Delete the function object
+        delete current_function;
+        current_function = nullptr;
+        current_aggregator = nullptr;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::allocate_registers(bool frees_in_contexts)
+    {
+        RegisterAllocator allocator;
+
+        // Items that live in the DS Device keep their address in the frame for the loads, stores and frees
+        auto read = [&](const Memory::MemAlloc & mem) {
+            if(Memory::is_frame_resident(mem.bytes_requested)) { allocator.use(mem.start_pos); } else { allocator.pin(mem.start_pos); }
+        };
+        auto write = [&](const Memory::MemAlloc & mem) {
+            if(Memory::is_frame_resident(mem.bytes_requested)) { allocator.define(mem.start_pos); } else { allocator.pin(mem.start_pos); }
+        };
+
+        // Contexts free what they allocated when they end, which costs the registers __del__ds__free uses
+        auto context_frees = [&]() {
+            if(!frees_in_contexts) { return; }
+            for(auto reg : CODE::REG_DS_FREE_CLOBBER) { allocator.clobber(reg); }
+        };
+
+        // Parameters are copied in from the caller's frame as the function starts
+        for(auto & p : params)
+        {
+            if(p.end_pos - p.start_pos == SETTINGS::SYSTEM_WORD_SIZE_BYTES) { allocator.define(p.start_pos); } else { allocator.pin(p.start_pos); }
+        }
+
+        // Walk the events in the order they were recorded. That is the order the code is laid out, except
+        // for conditionals. A ConditionalContext places the loads of every branch's condition ahead of all
+        // of the branch bodies, but the walk reads each condition as its branch begins. The conditions are
+        // all stored before the conditional starts, so this only keeps a later branch's condition live
+        // through the earlier bodies. That costs a register there, but is never wrong
+        std::stack<CODEGEN::TYPES::LoopIf*> loops;
+        for(auto & e : events)
+        {
+            allocator.step();
+
+            switch(e.type)
+            {
+                case EventType::COMMAND:
+                {
+                    const Memory::MemAlloc & destination = e.command.memory_info;
+                    for(auto & ins : e.command.instructions)
+                    {
+                        allocator.step();
+                        switch(ins->instruction)
+                        {
+                            case CODEGEN::TYPES::InstructionSet::LOAD:
+                            {
+                                auto * load = static_cast<CODEGEN::TYPES::AddressValueInstruction*>(ins);
+                                if(Memory::is_frame_resident(load->bytes)) { allocator.use(load->value); } else { allocator.pin(load->value); }
+                                break;
+                            }
+                            case CODEGEN::TYPES::InstructionSet::STORE:        write(destination);                                                     break;
+                            // The callee reads arguments out of this frame by address
+                            case CODEGEN::TYPES::InstructionSet::MOVE_ADDRESS: allocator.pin(static_cast<CODEGEN::TYPES::MoveInstruction*>(ins)->source); break;
+                            case CODEGEN::TYPES::InstructionSet::DS_ALLOC:     allocator.pin(destination.start_pos);                                    break;
+                            case CODEGEN::TYPES::InstructionSet::CALL:         allocator.clobber_all();                                                break;
+                            default:
+                                break;
+                        }
+                    }
+                    break;
+                }
+                case EventType::BEGIN_CONDITIONAL:
+                    read(e.conditional);
+                    break;
+                case EventType::EXTEND_CONDITIONAL:
+                    read(e.conditional);
+                    context_frees();
+                    break;
+                case EventType::END_CONDITIONAL:
+                    context_frees();
+                    break;
+                case EventType::BEGIN_LOOP:
+                {
+                    allocator.begin_loop();
+                    loops.push(e.loop.get());
+                    if(e.loop->type == CODEGEN::TYPES::LoopType::WHILE)
+                    {
+                        read(static_cast<CODEGEN::TYPES::WhileInitiation*>(e.loop.get())->condition);
+                    }
+                    break;
+                }
+                case EventType::END_LOOP:
+                {
+                    if(loops.top()->type == CODEGEN::TYPES::LoopType::FOR)
+                    {
+                        auto * loop = static_cast<CODEGEN::TYPES::ForLoopInitiation*>(loops.top());
+                        read(loop->end_var);
+                        read(loop->loop_var);
+                        read(loop->step);
+
+                        allocator.step();
+                        write(loop->loop_var);
+                    }
+                    allocator.step();
+                    context_frees();
+
+                    allocator.end_loop();
+                    loops.pop();
+                    break;
+                }
+                case EventType::NULL_RETURN:
+                    break;
+            }
+        }
+
+        registers = allocator.allocate();
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    CODE::Buffer Lowering::take_code()
+    {
+        return std::move(code);
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    const std::vector<AsmSupport::Math> & Lowering::get_builtins() const
+    {
+        return builtins;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    const PeepholeStats & Lowering::get_peephole_stats() const
+    {
+        return peephole_stats;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::begin_conditional(CODEGEN::TYPES::ConditionalInitiation conditional_init)
+    {
+        aggregators.push(new CODE::ConditionalContext(conditional_init, labels, registers));
+
+        // Switch the current aggregator to the conditional context
+        current_aggregator = aggregators.top();
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::extend_conditional(CODEGEN::TYPES::ConditionalInitiation conditional_init)
+    {
+        // Extend the current conditional context with the information given
+        // Aggregator should not change here
+
+        CODE::ConditionalContext * cc = static_cast<CODE::ConditionalContext*>(aggregators.top());
+
+        cc->extend_context(conditional_init);
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::end_conditional()
+    {
+        if(aggregators.empty())
+        {
+            throw InternalError("Lowering", "Developer Error : Codegen asked to end a conditional, but no conditional detected");
+        }
+
+        // Get the context off of the stack
+        CODE::ConditionalContext * conditional = static_cast<CODE::ConditionalContext*>(aggregators.top());
+
+        // Pop
+        aggregators.pop();
+
+        // Export the conditional as a buffer - It will be linked into current_aggregator
+        CODE::Buffer exported = conditional->export_as_buffer();
+
+        // If the stack is empty redirect the aggregator to be the current function
+        if(aggregators.empty())
+        {
+            current_aggregator = current_function;
+        }
+        else
+        {
+            // Otherwise, we want the next context in the stack
+            current_aggregator = aggregators.top();
+        }
+
+        // Add contents to aggregator - might be the function, might be another context
+        current_aggregator->add_buffer(std::move(exported));
+
+        // Delete the conditional
+        delete conditional;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::begin_loop(CODEGEN::TYPES::LoopIf * loop_if)
+    {
+        switch(loop_if->type)
+        {
+            case CODEGEN::TYPES::LoopType::FOR:
+                aggregators.push(new CODE::ForLoopContext(static_cast<CODEGEN::TYPES::ForLoopInitiation*>(loop_if), labels, registers));
+                break;
+            case CODEGEN::TYPES::LoopType::WHILE:
+                aggregators.push(new CODE::WhileLoopContext(static_cast<CODEGEN::TYPES::WhileInitiation*>(loop_if), labels, registers));
+                break;
+            default:
+            {
+                throw InternalError("Lowering::begin_loop", "Attempting to start loop, but an invalid loop type was given");
+            }
+        }
+
+        // Switch the current aggregator to the while loop context
+        current_aggregator = aggregators.top();
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::end_loop(CODEGEN::TYPES::LoopType type)
+    {
+        if(aggregators.empty())
+        {
+            throw InternalError("Lowering", "Developer Error : Codegen asked to end a for loop, but no loop detected");
+        }
+
+        CODE::Buffer exported;
+        CODE::BlockAggregator* block_agg;
+
+        switch(type)
+        {
+            case CODEGEN::TYPES::LoopType::FOR:
+            {
+                // Get the context off of the stack
+                CODE::ForLoopContext * loop = static_cast<CODE::ForLoopContext*>(aggregators.top());
+                block_agg = aggregators.top();
+
+                // Pop
+                aggregators.pop();
+
+                // Export the loop as a buffer - It will be linked into current_aggregator
+                exported = loop->export_as_buffer();
+                break;
+            }
+            case CODEGEN::TYPES::LoopType::WHILE:
+            {
+                // Get the context off of the stack
+                CODE::WhileLoopContext * loop = static_cast<CODE::WhileLoopContext*>(aggregators.top());
+                block_agg = aggregators.top();
+
+                // Pop
+                aggregators.pop();
+
+                // Export the loop as a buffer - It will be linked into current_aggregator
+                exported = loop->export_as_buffer();
+                break;
+            }
+            default:
+            {
+                throw InternalError("Lowering::end_loop", "Attempting to end loop, but an invalid loop type was given");
+            }
+        }
+
+        // If the stack is empty redirect the aggregator to be the current function
+        if(aggregators.empty())
+        {
+            current_aggregator = current_function;
+        }
+        else
+        {
+            // Otherwise, we want the next context in the stack
+            current_aggregator = aggregators.top();
+        }
+
+        // Add contents to aggregator - might be the function, might be another context
+        current_aggregator->add_buffer(std::move(exported));
+
+        delete block_agg;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::note_builtin(AsmSupport::Math module)
+    {
+        // Track each module once, in the order they are first needed so the output is the same
+        // regardless of which thread generated the function
+        if(std::find(builtins.begin(), builtins.end(), module) == builtins.end())
+        {
+            builtins.push_back(module);
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::use_builtin(AsmSupport::Math module, std::string title)
+    {
+        note_builtin(module);
+
+        current_aggregator->add_block(new CODE::BuiltIn(title, AsmSupport::get_math_function_name(module)));
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::execute_command(CODEGEN::TYPES::Command & command)
+    {
+        /*
+            command.id                    -> The name of the thing we are assigning for comments
+            command.memory_info           -> Where we need to store the thing
+            command.classification -> How to treat the given data (int, char, real)
+            command.instructions          -> What to do to the data in RPN form
+        */
+
+        // Word sized calculations are worked in registers, anything else goes through the calc stack
+        if(!evaluate_in_registers(command))
+        {
+            execute_on_calc_stack(command);
+        }
+
+        // The instructions are owned by the lowering once recorded
+        for(auto & i : command.instructions)
+        {
+            delete i;
+        }
+        command.instructions.clear();
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool Lowering::evaluate_in_registers(CODEGEN::TYPES::Command & command)
+    {
+        if(command.instructions.size() < 2)
+        {
+            return false;
+        }
+
+        // Only calculations of a word, that are stored or returned
+        CODEGEN::TYPES::InstructionSet tail = command.instructions.back()->instruction;
+        if(tail == CODEGEN::TYPES::InstructionSet::STORE)
+        {
+            if(!Memory::is_frame_resident(command.memory_info.bytes_requested))
+            {
+                return false;
+            }
+        }
+        else if(tail != CODEGEN::TYPES::InstructionSet::RETURN)
+        {
+            return false;
+        }
+
+        std::vector<CODEGEN::TYPES::BaseInstruction*> rpn(command.instructions.begin(), command.instructions.end() - 1);
+        if(!CODE::Expression::accepts(rpn))
+        {
+            return false;
+        }
+
+        CODE::Expression * expression = new CODE::Expression(rpn, command.classification, labels, registers);
+
+        for(auto & module : expression->get_builtins())
+        {
+            note_builtin(module);
+        }
+
+        int result = expression->get_result();
+        current_aggregator->add_block(expression);
+
+        if(tail == CODEGEN::TYPES::InstructionSet::STORE)
+        {
+            current_aggregator->add_block(new CODE::Store(command.memory_info.start_pos, command.memory_info.bytes_requested, command.id, labels, registers, result));
+        }
+        else
+        {
+            current_function->build_return_register(result);
+        }
+        return true;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Lowering::execute_on_calc_stack(CODEGEN::TYPES::Command & command)
+    {
+        bool is_double = (command.classification == CODEGEN::TYPES::DataClassification::DOUBLE);
+
+        // Execute the command from the caller
+        //
+        for(auto & ins : command.instructions)
+        {
+            switch(ins->instruction)
+            {
+                case CODEGEN::TYPES::InstructionSet::ADD:    current_aggregator->add_block(new CODE::Addition(command.classification));        break;
+                case CODEGEN::TYPES::InstructionSet::SUB:    current_aggregator->add_block(new CODE::Subtraction(command.classification));     break;
+                case CODEGEN::TYPES::InstructionSet::DIV:    current_aggregator->add_block(new CODE::Division(command.classification));        break;
+                case CODEGEN::TYPES::InstructionSet::MUL:    current_aggregator->add_block(new CODE::Multiplication(command.classification));  break;
+
+                case CODEGEN::TYPES::InstructionSet::RSH:    current_aggregator->add_block(new CODE::RightShift());   break;
+                case CODEGEN::TYPES::InstructionSet::LSH:    current_aggregator->add_block(new CODE::LeftShift());    break;
+                case CODEGEN::TYPES::InstructionSet::BW_OR:  current_aggregator->add_block(new CODE::BwOr());         break;
+                case CODEGEN::TYPES::InstructionSet::BW_NOT: current_aggregator->add_block(new CODE::BwNot());        break;
+                case CODEGEN::TYPES::InstructionSet::BW_XOR: current_aggregator->add_block(new CODE::BwXor());        break;
+                case CODEGEN::TYPES::InstructionSet::BW_AND: current_aggregator->add_block(new CODE::BwAnd());        break;
+
+                case CODEGEN::TYPES::InstructionSet::LTE:    current_aggregator->add_block(new CODE::Lte(labels.expression++, command.classification)); break;
+                case CODEGEN::TYPES::InstructionSet::LT:     current_aggregator->add_block(new CODE::Lt (labels.expression++, command.classification)); break;
+                case CODEGEN::TYPES::InstructionSet::GTE:    current_aggregator->add_block(new CODE::Gte(labels.expression++, command.classification)); break;
+                case CODEGEN::TYPES::InstructionSet::GT:     current_aggregator->add_block(new CODE::Gt (labels.expression++, command.classification)); break;
+                case CODEGEN::TYPES::InstructionSet::EQ:     current_aggregator->add_block(new CODE::Eq (labels.expression++, command.classification)); break;
+                case CODEGEN::TYPES::InstructionSet::NE:     current_aggregator->add_block(new CODE::Neq(labels.expression++, command.classification)); break;
+                case CODEGEN::TYPES::InstructionSet::OR:     current_aggregator->add_block(new CODE::Or (labels.expression++, command.classification)); break;
+                case CODEGEN::TYPES::InstructionSet::AND:    current_aggregator->add_block(new CODE::And(labels.expression++, command.classification)); break;
+
+                case CODEGEN::TYPES::InstructionSet::NEGATE: current_aggregator->add_block(new CODE::Negate(labels.expression++, command.classification)); break;
+
+                case CODEGEN::TYPES::InstructionSet::CALL:   current_aggregator->add_block(new CODE::Call(static_cast<CODEGEN::TYPES::CallInstruction*>(ins))); break;
+
+                case CODEGEN::TYPES::InstructionSet::LOAD:  current_aggregator->add_block(new CODE::Load(static_cast<CODEGEN::TYPES::AddressValueInstruction*>(ins), labels, registers)); break;
+
+                case CODEGEN::TYPES::InstructionSet::STORE: current_aggregator->add_block(new CODE::Store(command.memory_info.start_pos, command.memory_info.bytes_requested, command.id, labels, registers)); break;
+
+                case CODEGEN::TYPES::InstructionSet::MOVE_ADDRESS: current_aggregator->add_block(new CODE::MoveAddress(static_cast<CODEGEN::TYPES::MoveInstruction*>(ins))); break;
+
+                case CODEGEN::TYPES::InstructionSet::USE_RAW: current_aggregator->add_block(new CODE::SetupPrimitive(command.id, static_cast<CODEGEN::TYPES::RawValueInstruction*>(ins))); break;
+
+                case CODEGEN::TYPES::InstructionSet::POW: use_builtin((is_double) ? AsmSupport::Math::POW_D : AsmSupport::Math::POW_I, "POW"); break;
+                case CODEGEN::TYPES::InstructionSet::MOD: use_builtin((is_double) ? AsmSupport::Math::MOD_D : AsmSupport::Math::MOD_I, "MOD"); break;
+
+                case CODEGEN::TYPES::InstructionSet::RETURN:
+                {
+                    current_function->build_return();
+                    break;
+                }
+                case CODEGEN::TYPES::InstructionSet::DS_ALLOC:
+                {
+                    current_aggregator->add_block(new CODE::DSAllocate(static_cast<CODEGEN::TYPES::DSAllocInstruction*>(ins), command.memory_info.start_pos));
+
+                    current_aggregator->add_memory_alloc(command.memory_info);
+                    break;
+                }
+                default:
+                    throw InternalError("Lowering::execute_command()", "Developer Error : default accessed in command");
+            }
+        }
+    }
+}
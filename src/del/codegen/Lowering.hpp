@@ -0,0 +1,128 @@
+#ifndef DEL_LOWERING_HPP
+#define DEL_LOWERING_HPP
+
+#include "AsmSupport.hpp"
+#include "Buffer.hpp"
+#include "Codeblock.hpp"
+#include "CodegenTypes.hpp"
+#include "Function.hpp"
+#include "Peephole.hpp"
+
+#include <memory>
+#include <stack>
+#include <string>
+#include <vector>
+
+namespace DEL
+{
+    //! \class Lowering
+    //! \brief The code generation for a single function. The code generator records everything it is told
+    //!        about a function, and the lowering turns the record into ASM. A lowering shares no state with
+    //!        the rest of the compiler, so it can be run on any thread once the function has been recorded
+    class Lowering
+    {
+    public:
+
+        //! \brief Create a lowering for a function
+        //! \param name The function name
+        //! \param params The function's parameters
+        Lowering(std::string name, std::vector<CODEGEN::TYPES::ParamInfo> params);
+
+        //! \brief Destruct the lowering, and anything recorded or part built that was not generated
+        ~Lowering();
+
+        Lowering(const Lowering&) = delete;
+        Lowering& operator=(const Lowering&) = delete;
+
+        //! \brief Record a command. The lowering takes ownership of the command's instructions
+        void record_command(CODEGEN::TYPES::Command command);
+
+        //! \brief Record the start of a conditional
+        void record_begin_conditional(CODEGEN::TYPES::ConditionalInitiation conditional_init);
+
+        //! \brief Record the extension of the current conditional
+        void record_extend_conditional(CODEGEN::TYPES::ConditionalInitiation conditional_init);
+
+        //! \brief Record the end of the current conditional
+        void record_end_conditional();
+
+        //! \brief Record the start of a loop. The lowering takes ownership of loop_if
+        void record_begin_loop(CODEGEN::TYPES::LoopIf * loop_if);
+
+        //! \brief Record the end of the current loop
+        void record_end_loop(CODEGEN::TYPES::LoopType type);
+
+        //! \brief Record a return that doesn't return a value
+        void record_null_return();
+
+        //! \brief Record the end of the function
+        //! \param bytes_required Bytes the function requires to perform all of its operations
+        void record_end(uint64_t bytes_required);
+
+        //! \brief Generate the ASM for everything recorded
+        //! \post The recording is released, the result is available from take_code()
+        void run();
+
+        //! \brief Take the generated ASM. Only valid after run()
+        CODE::Buffer take_code();
+
+        //! \brief Get the built in modules the function calls, in the order they were first called
+        const std::vector<AsmSupport::Math> & get_builtins() const;
+
+        //! \brief Get what the peephole optimizer changed in the function. Only valid after run()
+        const PeepholeStats & get_peephole_stats() const;
+
+    private:
+
+        enum class EventType
+        {
+            COMMAND,
+            BEGIN_CONDITIONAL,
+            EXTEND_CONDITIONAL,
+            END_CONDITIONAL,
+            BEGIN_LOOP,
+            END_LOOP,
+            NULL_RETURN
+        };
+
+        struct Event
+        {
+            EventType type;
+            CODEGEN::TYPES::Command command;            // COMMAND
+            Memory::MemAlloc conditional;               // BEGIN_CONDITIONAL, EXTEND_CONDITIONAL
+            std::unique_ptr<CODEGEN::TYPES::LoopIf> loop; // BEGIN_LOOP
+            CODEGEN::TYPES::LoopType loop_type;         // END_LOOP
+        };
+
+        std::string name;
+        std::vector<CODEGEN::TYPES::ParamInfo> params;
+        uint64_t bytes_required;
+        std::vector<Event> events;
+
+        // Generation state, only used within run()
+        CODE::Labels labels;
+        CODE::Function * current_function;
+        CODE::BlockAggregator * current_aggregator;
+        std::stack<CODE::BlockAggregator*> aggregators;
+        CODE::Registers registers;
+
+        // Result
+        CODE::Buffer code;
+        std::vector<AsmSupport::Math> builtins;
+        PeepholeStats peephole_stats;
+
+        void allocate_registers(bool frees_in_contexts);
+        void execute_command(CODEGEN::TYPES::Command & command);
+        bool evaluate_in_registers(CODEGEN::TYPES::Command & command);
+        void execute_on_calc_stack(CODEGEN::TYPES::Command & command);
+        void begin_conditional(CODEGEN::TYPES::ConditionalInitiation conditional_init);
+        void extend_conditional(CODEGEN::TYPES::ConditionalInitiation conditional_init);
+        void end_conditional();
+        void begin_loop(CODEGEN::TYPES::LoopIf * loop_if);
+        void end_loop(CODEGEN::TYPES::LoopType type);
+        void note_builtin(AsmSupport::Math module);
+        void use_builtin(AsmSupport::Math module, std::string title);
+    };
+}
+
+#endif
@@ -0,0 +1,537 @@
+#include "Peephole.hpp"
+
+#include <cstring>
+#include <iomanip>
+
+namespace DEL
+{
+    namespace
+    {
+        // Writing r10 triggers a device, which answers in r11 and r12
+        constexpr int REG_DEVICE_FIRST = 10;
+        constexpr int REG_DEVICE_LAST  = 12;
+
+        // Largest constant folded into an arithmetic instruction
+        constexpr uint64_t MAX_FOLDED_CONSTANT = 32767;
+
+        // The word of the local stack holding the function's stack pointer
+        const CODE::Operand SP_ADDRESS = CODE::Operand::fixed(0, CODE::Stack::LS);
+
+        //  Register number of a register operand, or NO_REGISTER
+        //
+        int register_of(const CODE::Operand & operand)
+        {
+            return (operand.kind == CODE::Operand::Kind::REGISTER) ? operand.number : CODE::Operand::NO_REGISTER;
+        }
+
+        //  Base register of an address operand, or NO_REGISTER
+        //
+        int base_of(const CODE::Operand & operand)
+        {
+            return (operand.kind == CODE::Operand::Kind::ADDRESS) ? operand.number : CODE::Operand::NO_REGISTER;
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    PeepholeStats & PeepholeStats::operator+=(const PeepholeStats & other)
+    {
+        for(int i = 0; i < RULE_COUNT; i++)
+        {
+            hits[i] += other.hits[i];
+        }
+        instructions_before += other.instructions_before;
+        instructions_after  += other.instructions_after;
+        return *this;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    const char * PeepholeStats::rule_name(Rule rule)
+    {
+        switch(rule)
+        {
+            case PUSH_POP:       return "Push / pop collapse";
+            case SP_RELOAD:      return "Redundant SP reload";
+            case ADDRESS_OFFSET: return "Address offset fold";
+            case MOV_CHAIN:      return "Mov chain";
+            case JUMP_NEXT:      return "Jump to next";
+            default:             return "Unknown";
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void PeepholeStats::report(std::ostream & out) const
+    {
+        out << ">>> Peephole <<<" << std::endl;
+        for(int i = 0; i < RULE_COUNT; i++)
+        {
+            out << std::left << std::setw(19) << rule_name(static_cast<Rule>(i)) << ": " << hits[i] << std::endl;
+        }
+        out << std::left << std::setw(19) << "Instructions" << ": " << instructions_before << " -> " << instructions_after << std::endl;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    const Peephole::RuleEntry Peephole::RULES[] = {
+        { PeepholeStats::PUSH_POP,       &Peephole::collapse_push_pop   },
+        { PeepholeStats::SP_RELOAD,      &Peephole::drop_sp_reload      },
+        { PeepholeStats::ADDRESS_OFFSET, &Peephole::fold_address_offset },
+        { PeepholeStats::MOV_CHAIN,      &Peephole::shorten_mov_chain   },
+        { PeepholeStats::JUMP_NEXT,      &Peephole::drop_jump_to_next   }
+    };
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    CODE::Buffer Peephole::optimize(CODE::Buffer code)
+    {
+        std::vector<CODE::Line> generated;
+        code.take_lines(generated);
+
+        lines.reserve(generated.size());
+        for(auto & line : generated)
+        {
+            const char * roles = roles_of(line);
+            if(line.kind == CODE::Line::Kind::INSTRUCTION)
+            {
+                stats.instructions_before++;
+            }
+            lines.push_back(Line{ std::move(line), roles, false });
+        }
+
+        // Every rule removes at least one instruction when it applies, so this ends
+        bool changed = true;
+        while(changed)
+        {
+            changed = false;
+            for(auto & entry : RULES)
+            {
+                for(std::size_t i = 0; i < lines.size(); i++)
+                {
+                    if(lines[i].removed || is_opaque(lines[i]))
+                    {
+                        continue;
+                    }
+
+                    if((this->*entry.apply)(i))
+                    {
+                        stats.hits[entry.rule]++;
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        CODE::Buffer result;
+        for(auto & line : lines)
+        {
+            if(line.removed)
+            {
+                continue;
+            }
+
+            if(line.code.kind == CODE::Line::Kind::INSTRUCTION)
+            {
+                stats.instructions_after++;
+            }
+            result.add(std::move(line.code));
+        }
+
+        lines.clear();
+        return result;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    const PeepholeStats & Peephole::get_stats() const
+    {
+        return stats;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    const char * Peephole::roles_of(const CODE::Line & line)
+    {
+        if(line.kind != CODE::Line::Kind::INSTRUCTION)
+        {
+            return "";
+        }
+
+        // Calls, returns and exits leave the function
+        if(line.op == CODE::Op::CALL || line.op == CODE::Op::RET || line.op == CODE::Op::EXIT)
+        {
+            return "";
+        }
+
+        // Anything in an unexpected shape, or that talks to a device, is left alone
+        const char * roles = CODE::form_of(line.op).roles;
+        if(std::strlen(roles) != line.operands.size())
+        {
+            return "";
+        }
+
+        for(auto & o : line.operands)
+        {
+            int reg = o.register_used();
+            if(reg >= REG_DEVICE_FIRST && reg <= REG_DEVICE_LAST)
+            {
+                return "";
+            }
+        }
+        return roles;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool Peephole::collapse_push_pop(std::size_t index)
+    {
+        const CODE::Line & push = lines[index].code;
+        if(push.op != CODE::Op::PUSHW || push.operands[0] != CODE::Operand::stack(CODE::Stack::LS))
+        {
+            return false;
+        }
+
+        std::size_t p = next(index);
+        if(p == lines.size() || is_opaque(lines[p]) ||
+           lines[p].code.op != CODE::Op::POPW || lines[p].code.operands[1] != CODE::Operand::stack(CODE::Stack::LS))
+        {
+            return false;
+        }
+
+        CODE::Operand value = push.operands[1];
+        CODE::Operand dest  = lines[p].code.operands[0];
+
+        remove(p);
+        if(value == dest)
+        {
+            remove(index);
+        }
+        else
+        {
+            rewrite(index, CODE::Op::MOV, { dest, value });
+        }
+        return true;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool Peephole::drop_sp_reload(std::size_t index)
+    {
+        const CODE::Line & load = lines[index].code;
+        if(load.op != CODE::Op::LDW || load.operands[1] != SP_ADDRESS)
+        {
+            return false;
+        }
+
+        int reg = register_of(load.operands[0]);
+
+        // Look back through the block for the same load, with the register untouched since
+        for(std::size_t k = index; k-- > 0; )
+        {
+            const Line & line = lines[k];
+            if(line.removed || line.code.kind == CODE::Line::Kind::COMMENT || line.code.kind == CODE::Line::Kind::BLANK)
+            {
+                continue;
+            }
+
+            if(is_opaque(line) || line.code.op == CODE::Op::JMP)
+            {
+                return false;
+            }
+
+            if(line.code.op == CODE::Op::LDW && line.code.operands[1] == SP_ADDRESS && register_of(line.code.operands[0]) == reg)
+            {
+                remove(index);
+                return true;
+            }
+
+            if(writes(line) == reg)
+            {
+                return false;
+            }
+
+            const CODE::Operand & stored = line.code.operands[0];
+            if((line.code.op == CODE::Op::STW || line.code.op == CODE::Op::STB) && stored.kind == CODE::Operand::Kind::ADDRESS && stored.segment == CODE::Stack::LS)
+            {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool Peephole::fold_address_offset(std::size_t index)
+    {
+        const CODE::Line & mov = lines[index].code;
+        if(mov.op != CODE::Op::MOV || mov.operands[1].kind != CODE::Operand::Kind::CONSTANT || mov.operands[1].value > MAX_FOLDED_CONSTANT)
+        {
+            return false;
+        }
+
+        int reg = register_of(mov.operands[0]);
+
+        // The constant must be consumed by an add before anything else looks at the register
+        for(std::size_t j = next(index); j < lines.size(); j = next(j))
+        {
+            const Line & line = lines[j];
+            if(is_opaque(line) || is_transfer(line))
+            {
+                return false;
+            }
+
+            if(!reads(line, reg) && writes(line) != reg)
+            {
+                continue;
+            }
+
+            if(line.code.op != CODE::Op::ADD || register_of(line.code.operands[0]) != reg)
+            {
+                return false;
+            }
+
+            int lhs = register_of(line.code.operands[1]);
+            int rhs = register_of(line.code.operands[2]);
+            int other = (lhs == reg) ? rhs : ((rhs == reg) ? lhs : CODE::Operand::NO_REGISTER);
+            if(other == CODE::Operand::NO_REGISTER || other == reg)
+            {
+                return false;
+            }
+
+            if(mov.operands[1].value == 0)
+            {
+                rewrite(j, CODE::Op::MOV, { CODE::Operand::reg(reg), CODE::Operand::reg(other) });
+            }
+            else
+            {
+                rewrite(j, CODE::Op::ADD, { CODE::Operand::reg(reg), CODE::Operand::reg(other), mov.operands[1] });
+            }
+            remove(index);
+            return true;
+        }
+        return false;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool Peephole::shorten_mov_chain(std::size_t index)
+    {
+        const CODE::Line & line = lines[index].code;
+        int dest = writes(lines[index]);
+
+        // mov rA rA
+        if(line.op == CODE::Op::MOV && line.operands[0] == line.operands[1])
+        {
+            remove(index);
+            return true;
+        }
+
+        std::size_t j = next(index);
+        if(dest == CODE::Operand::NO_REGISTER || j == lines.size() || is_opaque(lines[j]))
+        {
+            return false;
+        }
+        const CODE::Line & after = lines[j].code;
+
+        // mov rA X, overwritten before it is read
+        if(line.op == CODE::Op::MOV && writes(lines[j]) == dest && !reads(lines[j], dest))
+        {
+            remove(index);
+            return true;
+        }
+
+        // rA = ..., mov rB rA : compute straight into rB
+        int copy_from = after.operands.empty() ? CODE::Operand::NO_REGISTER : register_of(after.operands.back());
+        if(after.op == CODE::Op::MOV && copy_from == dest && writes(lines[j]) != CODE::Operand::NO_REGISTER &&
+           writes(lines[j]) != dest && dead_after(j, dest))
+        {
+            std::vector<CODE::Operand> operands = line.operands;
+            operands[0] = after.operands[0];
+            rewrite(index, line.op, operands);
+            remove(j);
+            return true;
+        }
+
+        // mov rA rB, used once : use rB in its place
+        int source = (line.op == CODE::Op::MOV) ? register_of(line.operands[1]) : CODE::Operand::NO_REGISTER;
+        if(source != CODE::Operand::NO_REGISTER && !is_transfer(lines[j]) && reads(lines[j], dest) &&
+           (writes(lines[j]) == dest || dead_after(j, dest)))
+        {
+            const char * roles = lines[j].roles;
+            std::vector<CODE::Operand> operands = after.operands;
+            for(std::size_t k = 0; k < operands.size(); k++)
+            {
+                if((roles[k] == 'r' && register_of(operands[k]) == dest) ||
+                   (roles[k] == 'a' && base_of(operands[k]) == dest))
+                {
+                    operands[k].number = source;
+                }
+            }
+            rewrite(j, after.op, operands);
+            remove(index);
+            return true;
+        }
+        return false;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool Peephole::drop_jump_to_next(std::size_t index)
+    {
+        const Line & jump = lines[index];
+        if(!is_transfer(jump))
+        {
+            return false;
+        }
+
+        // The target may be any of the labels before the next instruction
+        for(std::size_t k = next(index); k < lines.size(); k = next(k))
+        {
+            if(lines[k].code.kind != CODE::Line::Kind::LABEL)
+            {
+                return false;
+            }
+
+            if(lines[k].code.text == jump.code.operands.back().name)
+            {
+                remove(index);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    std::size_t Peephole::next(std::size_t index) const
+    {
+        for(std::size_t i = index + 1; i < lines.size(); i++)
+        {
+            if(!lines[i].removed && lines[i].code.kind != CODE::Line::Kind::COMMENT && lines[i].code.kind != CODE::Line::Kind::BLANK)
+            {
+                return i;
+            }
+        }
+        return lines.size();
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool Peephole::is_opaque(const Line & line) const
+    {
+        return *line.roles == '\0';
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool Peephole::is_transfer(const Line & line) const
+    {
+        return std::strchr(line.roles, 'l') != nullptr;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool Peephole::reads(const Line & line, int reg) const
+    {
+        for(std::size_t i = 0; line.roles[i]; i++)
+        {
+            if((line.roles[i] == 'r' && register_of(line.code.operands[i]) == reg) ||
+               (line.roles[i] == 'a' && base_of(line.code.operands[i]) == reg))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    int Peephole::writes(const Line & line) const
+    {
+        return (line.roles[0] == 'd') ? register_of(line.code.operands[0]) : CODE::Operand::NO_REGISTER;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool Peephole::dead_after(std::size_t index, int reg) const
+    {
+        // Only known dead if overwritten before being read, without leaving the block
+        for(std::size_t j = next(index); j < lines.size(); j = next(j))
+        {
+            const Line & line = lines[j];
+            if(is_opaque(line) || reads(line, reg))
+            {
+                return false;
+            }
+
+            if(writes(line) == reg)
+            {
+                return true;
+            }
+
+            if(is_transfer(line))
+            {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Peephole::remove(std::size_t index)
+    {
+        lines[index].removed = true;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Peephole::rewrite(std::size_t index, CODE::Op op, std::vector<CODE::Operand> operands)
+    {
+        Line & line = lines[index];
+        line.code.op       = op;
+        line.code.operands = std::move(operands);
+        line.roles         = roles_of(line.code);
+    }
+}
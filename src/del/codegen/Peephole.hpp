@@ -0,0 +1,102 @@
+#ifndef DEL_PEEPHOLE_HPP
+#define DEL_PEEPHOLE_HPP
+
+#include "Buffer.hpp"
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace DEL
+{
+    //! \brief Counts of what the peephole optimizer changed
+    struct PeepholeStats
+    {
+        //! \brief The rules, in the order they are tried
+        enum Rule
+        {
+            PUSH_POP,           // pushw ls rA / popw rB ls
+            SP_RELOAD,          // ldw rA $0(ls) while rA still holds it
+            ADDRESS_OFFSET,     // mov rA $X ... add rA rA rB
+            MOV_CHAIN,          // Moves that only pass a value along
+            JUMP_NEXT,          // Jumps and branches to the next instruction
+            RULE_COUNT
+        };
+
+        uint64_t hits[RULE_COUNT] {};
+        uint64_t instructions_before {0};
+        uint64_t instructions_after  {0};
+
+        //! \brief Add another set of counts to this one
+        PeepholeStats & operator+=(const PeepholeStats & other);
+
+        //! \brief Get the name of a rule for reporting
+        static const char * rule_name(Rule rule);
+
+        //! \brief Write a report of the counts
+        void report(std::ostream & out) const;
+    };
+
+    //! \class Peephole
+    //! \brief Peephole optimization of the ASM of a single function. Code blocks are generated without
+    //!        knowledge of the blocks around them, so the seams between them are full of values pushed only
+    //!        to be popped, addresses recomputed from scratch, and jumps to the next line. The rules are run
+    //!        over the instructions the blocks generated, as they were generated, until none apply.
+    //!        Labels, calls and anything touching the device registers are treated as walls
+    class Peephole
+    {
+    public:
+
+        //! \brief Optimize the ASM of a function
+        //! \param code The function's ASM, consumed
+        //! \returns The optimized ASM
+        CODE::Buffer optimize(CODE::Buffer code);
+
+        //! \brief Get the counts of what was changed
+        const PeepholeStats & get_stats() const;
+
+    private:
+
+        struct Line
+        {
+            CODE::Line code;
+            const char * roles;                 // Role of each operand, empty if the rules leave the line alone
+            bool removed;
+        };
+
+        typedef bool (Peephole::*Apply)(std::size_t index);
+
+        struct RuleEntry
+        {
+            PeepholeStats::Rule rule;
+            Apply apply;
+        };
+
+        static const RuleEntry RULES[];
+
+        std::vector<Line> lines;
+        PeepholeStats stats;
+
+        static const char * roles_of(const CODE::Line & line);
+
+        // Rules. Each is given the index of a live instruction and returns true if it changed anything
+        bool collapse_push_pop(std::size_t index);
+        bool drop_sp_reload(std::size_t index);
+        bool fold_address_offset(std::size_t index);
+        bool shorten_mov_chain(std::size_t index);
+        bool drop_jump_to_next(std::size_t index);
+
+        // Analysis
+        std::size_t next(std::size_t index) const;
+        bool is_opaque(const Line & line) const;
+        bool is_transfer(const Line & line) const;
+        bool reads(const Line & line, int reg) const;
+        int writes(const Line & line) const;
+        bool dead_after(std::size_t index, int reg) const;
+
+        void remove(std::size_t index);
+        void rewrite(std::size_t index, CODE::Op op, std::vector<CODE::Operand> operands);
+    };
+}
+
+#endif
@@ -0,0 +1,265 @@
+#include "RegisterAllocator.hpp"
+
+#include <algorithm>
+
+namespace DEL
+{
+    namespace
+    {
+        constexpr std::size_t REGISTER_COUNT = sizeof(CODE::REG_ALLOCATABLE) / sizeof(CODE::REG_ALLOCATABLE[0]);
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    RegisterAllocator::RegisterAllocator() : position(0),
+                                             clobbers(REGISTER_COUNT)
+    {
+
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void RegisterAllocator::step()
+    {
+        position++;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void RegisterAllocator::use(uint64_t slot)
+    {
+        touch(slot, false);
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void RegisterAllocator::define(uint64_t slot)
+    {
+        touch(slot, true);
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void RegisterAllocator::pin(uint64_t slot)
+    {
+        touch(slot, false).pinned = true;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void RegisterAllocator::clobber(int reg)
+    {
+        for(std::size_t i = 0; i < REGISTER_COUNT; i++)
+        {
+            if(CODE::REG_ALLOCATABLE[i] == reg)
+            {
+                clobbers[i].push_back(position);
+            }
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void RegisterAllocator::clobber_all()
+    {
+        for(auto & points : clobbers)
+        {
+            points.push_back(position);
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void RegisterAllocator::begin_loop()
+    {
+        open_loops.push_back(position);
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void RegisterAllocator::end_loop()
+    {
+        loops.push_back(Range{ open_loops.back(), position });
+        open_loops.pop_back();
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    CODE::Registers RegisterAllocator::allocate()
+    {
+        const Mask ALL = (1u << REGISTER_COUNT) - 1;
+
+        CODE::Registers result;
+
+        // Inner loops first, so a lifetime stretched over an inner loop is then checked against the loops around it
+        std::stable_sort(loops.begin(), loops.end(), [](const Range & a, const Range & b) {
+            return (a.end - a.begin) < (b.end - b.begin);
+        });
+
+        std::vector<Interval*> candidates;
+        for(auto & interval : intervals)
+        {
+            if(interval.pinned)
+            {
+                continue;
+            }
+
+            extend_over_loops(interval);
+            candidates.push_back(&interval);
+        }
+
+        std::stable_sort(candidates.begin(), candidates.end(), [](const Interval * a, const Interval * b) {
+            return a->start < b->start;
+        });
+
+        struct Active
+        {
+            Interval * interval;
+            std::size_t reg;
+        };
+
+        // At most one entry per register, so these stay tiny
+        std::vector<Active> active;
+        Mask free = ALL;
+
+        for(auto * interval : candidates)
+        {
+            // Release the registers of everything that has ended
+            for(auto it = active.begin(); it != active.end(); )
+            {
+                if(it->interval->end < interval->start)
+                {
+                    free |= (1u << it->reg);
+                    it = active.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            Mask allowed = ALL & ~clobbered_within(*interval);
+            if(allowed == 0)
+            {
+                continue;
+            }
+
+            Mask available = free & allowed;
+            if(available != 0)
+            {
+                std::size_t reg = 0;
+                while(!(available & (1u << reg))) { reg++; }
+
+                free &= ~(1u << reg);
+                active.push_back(Active{ interval, reg });
+                result.slots[interval->slot] = CODE::REG_ALLOCATABLE[reg];
+                continue;
+            }
+
+            // Out of registers. Of this and everything holding a register it could use, the one that
+            // lives the longest stays in the frame
+            auto victim = active.end();
+            for(auto it = active.begin(); it != active.end(); ++it)
+            {
+                if((allowed & (1u << it->reg)) && (victim == active.end() || it->interval->end > victim->interval->end))
+                {
+                    victim = it;
+                }
+            }
+
+            if(victim != active.end() && victim->interval->end > interval->end)
+            {
+                result.slots.erase(victim->interval->slot);
+                result.slots[interval->slot] = CODE::REG_ALLOCATABLE[victim->reg];
+                victim->interval = interval;
+            }
+        }
+
+        return result;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    RegisterAllocator::Interval & RegisterAllocator::touch(uint64_t slot, bool is_define)
+    {
+        auto found = interval_of.find(slot);
+        if(found == interval_of.end())
+        {
+            interval_of[slot] = intervals.size();
+            intervals.push_back(Interval{ slot, position, position, is_define, false });
+            return intervals.back();
+        }
+
+        Interval & interval = intervals[found->second];
+        interval.end = position;
+        return interval;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void RegisterAllocator::extend_over_loops(Interval & interval) const
+    {
+        for(auto & loop : loops)
+        {
+            if(interval.start > loop.end || interval.end < loop.begin)
+            {
+                continue;
+            }
+
+            // Something first written inside the loop, and never seen outside it, starts over each iteration
+            bool contained = (interval.start >= loop.begin && interval.end <= loop.end);
+            if(contained && interval.first_is_define)
+            {
+                continue;
+            }
+
+            // Otherwise the value has to survive the jump back to the top of the loop, including whatever
+            // happens at the very end of it
+            interval.start = std::min(interval.start, loop.begin);
+            interval.end   = std::max(interval.end,   loop.end + 1);
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    RegisterAllocator::Mask RegisterAllocator::clobbered_within(const Interval & interval) const
+    {
+        Mask mask = 0;
+        for(std::size_t i = 0; i < REGISTER_COUNT; i++)
+        {
+            // A register destroyed where the lifetime starts or ends is fine, the value isn't held there yet or anymore
+            auto next = std::upper_bound(clobbers[i].begin(), clobbers[i].end(), interval.start);
+            if(next != clobbers[i].end() && *next < interval.end)
+            {
+                mask |= (1u << i);
+            }
+        }
+        return mask;
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef DEL_REGISTER_ALLOCATOR_HPP
+#define DEL_REGISTER_ALLOCATOR_HPP
+
+#include "Codeblock.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace DEL
+{
+    //! \class RegisterAllocator
+    //! \brief Linear scan register allocation of the frame slots of a single function. The caller walks the
+    //!        function in the order its code is laid out, noting where each slot is read and written, and
+    //!        where registers are destroyed. Each slot is then either given a register for its whole lifetime
+    //!        or left in the frame. Slots are only left in the frame when registers run out, when their
+    //!        address is taken, or when something that destroys every register happens while they are live
+    class RegisterAllocator
+    {
+    public:
+
+        //! \brief Create an allocator
+        RegisterAllocator();
+
+        //! \brief Move to the next point in the function
+        void step();
+
+        //! \brief Note that a slot is read at the current point
+        //! \param slot Frame position of the slot
+        void use(uint64_t slot);
+
+        //! \brief Note that a slot is written at the current point
+        //! \param slot Frame position of the slot
+        void define(uint64_t slot);
+
+        //! \brief Keep a slot in the frame for the whole function
+        //! \param slot Frame position of the slot
+        void pin(uint64_t slot);
+
+        //! \brief Note that a register is destroyed at the current point
+        //! \param reg The register
+        void clobber(int reg);
+
+        //! \brief Note that every register is destroyed at the current point, as with a call
+        void clobber_all();
+
+        //! \brief Note the start of a loop at the current point
+        void begin_loop();
+
+        //! \brief Note the end of the innermost loop at the current point
+        void end_loop();
+
+        //! \brief Assign registers
+        //! \returns The registers given to slots
+        CODE::Registers allocate();
+
+    private:
+
+        typedef uint32_t Mask;      // Bit per entry of REG_ALLOCATABLE
+
+        struct Interval
+        {
+            uint64_t slot;
+            uint64_t start;
+            uint64_t end;
+            bool first_is_define;   // The value isn't carried in to the first point it is seen
+            bool pinned;
+        };
+
+        struct Range
+        {
+            uint64_t begin;
+            uint64_t end;
+        };
+
+        uint64_t position;
+        std::vector<Interval> intervals;
+        std::unordered_map<uint64_t, std::size_t> interval_of;     // Slot -> index into intervals
+
+        std::vector<std::vector<uint64_t>> clobbers;               // By allocatable register, points destroyed
+        std::vector<Range> loops;
+        std::vector<uint64_t> open_loops;
+
+        Interval & touch(uint64_t slot, bool is_define);
+        void extend_over_loops(Interval & interval) const;
+        Mask clobbered_within(const Interval & interval) const;
+    };
+}
+
+#endif
@@ -11,13 +11,31 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
+    namespace
+    {
+        //  The math modules, indexed by AsmSupport::Math. These point at the built in strings
+        //  so no copy of any module is made until it is imported
+        struct MathModule
+        {
+            const std::string * function_name;
+            const std::string * function;
+        };
+
+        const MathModule MATH_MODULES[] = {
+            { &BUILT_IN::ASM_MOD_D_FUNCTION_NAME, &BUILT_IN::ASM_MOD_D },
+            { &BUILT_IN::ASM_MOD_FUNCTION_NAME,   &BUILT_IN::ASM_MOD   },
+            { &BUILT_IN::ASM_POW_D_FUNCTION_NAME, &BUILT_IN::ASM_POW_D },
+            { &BUILT_IN::ASM_POW_FUNCTION_NAME,   &BUILT_IN::ASM_POW   }
+        };
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
     AsmSupport::AsmSupport()
     {
-        init_import = AsmSupport::InitImport{ false, false };
-        math_imports[AsmSupport::Math::MOD_D] = AsmSupport::ImportInfo{ false, BUILT_IN::ASM_MOD_D_FUNCTION_NAME, BUILT_IN::ASM_MOD_D  };
-        math_imports[AsmSupport::Math::MOD_I] = AsmSupport::ImportInfo{ false, BUILT_IN::ASM_MOD_FUNCTION_NAME  , BUILT_IN::ASM_MOD    };
-        math_imports[AsmSupport::Math::POW_D] = AsmSupport::ImportInfo{ false, BUILT_IN::ASM_POW_D_FUNCTION_NAME, BUILT_IN::ASM_POW_D  };
-        math_imports[AsmSupport::Math::POW_I] = AsmSupport::ImportInfo{ false, BUILT_IN::ASM_POW_FUNCTION_NAME  , BUILT_IN::ASM_POW    };
+        reset();
     }
 
     // ----------------------------------------------------------
@@ -26,18 +44,32 @@ namespace DEL
 
     AsmSupport::~AsmSupport()
     {
-        math_imports.clear();
+
     }
 
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    void AsmSupport::import_init_start(std::vector<std::string> & destination)
+    void AsmSupport::reset()
+    {
+        init_import = AsmSupport::InitImport{ false, false, false };
+
+        for(auto & imported : math_imported)
+        {
+            imported = false;
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void AsmSupport::import_init_start(std::string & destination)
     {
         if(init_import.start){ return; }
 
-        destination.push_back(BUILT_IN::ASM_FILE_START);
+        destination += BUILT_IN::ASM_FILE_START;
 
         init_import.start = true;
     }
@@ -46,11 +78,11 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    void AsmSupport::import_init_func(std::vector<std::string> & destination)
+    void AsmSupport::import_init_func(std::string & destination)
     {
         if(init_import.func){ return; }
 
-        destination.push_back(BUILT_IN::ASM_INIT_FUNCTION);
+        destination += BUILT_IN::ASM_INIT_FUNCTION;
 
         init_import.func = true;
     }
@@ -59,14 +91,14 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    void AsmSupport::import_sl_funcs(std::vector<std::string> & destination)
+    void AsmSupport::import_sl_funcs(std::string & destination)
     {
         if(init_import.store_load){ return; }
 
-        destination.push_back(BUILT_IN::ASM_ALLOC);
-        destination.push_back(BUILT_IN::ASM_FREE);
-        destination.push_back(BUILT_IN::ASM_LOAD);
-        destination.push_back(BUILT_IN::ASM_STORE);
+        destination += BUILT_IN::ASM_ALLOC;
+        destination += BUILT_IN::ASM_FREE;
+        destination += BUILT_IN::ASM_LOAD;
+        destination += BUILT_IN::ASM_STORE;
 
         init_import.store_load = true;
     }
@@ -75,17 +107,28 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    void AsmSupport::import_math(AsmSupport::Math math_import, std::string & function_name_out, std::vector<std::string> & destination)
+    void AsmSupport::import_math(AsmSupport::Math math_import, std::string & function_name_out, std::string & destination)
     {
+        std::size_t module = static_cast<std::size_t>(math_import);
+
         // Only include the function once
-        if(!math_imports[math_import].imported)
+        if(!math_imported[module])
         {
-            destination.push_back(math_imports[math_import].function);
+            destination += *MATH_MODULES[module].function;
 
-            math_imports[math_import].imported = true;
+            math_imported[module] = true;
         }
 
         // Always set the name
-        function_name_out = math_imports[math_import].function_name;
+        function_name_out = *MATH_MODULES[module].function_name;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    const std::string & AsmSupport::get_math_function_name(AsmSupport::Math math_import)
+    {
+        return *MATH_MODULES[static_cast<std::size_t>(math_import)].function_name;
     }
 }
\ No newline at end of file
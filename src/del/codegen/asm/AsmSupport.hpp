@@ -1,8 +1,7 @@
 #ifndef DEL_ASM_SUPPORT_HPP
 #define DEL_ASM_SUPPORT_HPP
 
-#include <map>
-#include <vector>
+#include <cstddef>
 #include <string>
 
 namespace DEL
@@ -28,33 +27,34 @@ namespace DEL
         //! \brief Destruct the class
         ~AsmSupport();
 
+        //! \brief Forget what has been imported so the class can be used for another program
+        void reset();
+
         //! \brief Import the ASM code to initialize the ASM file
-        //! \param destination [out] The vector to place the code
-        void import_init_start(std::vector<std::string> & destination);
+        //! \param destination [out] The string to append the code to
+        void import_init_start(std::string & destination);
 
         //! \brief Import the ASM code to enter into on initialization
-        //! \param destination [out] The vector to place the code
-        void import_init_func(std::vector<std::string> & destination);
+        //! \param destination [out] The string to append the code to
+        void import_init_func(std::string & destination);
 
         //! \brief Import the ASM code for store/load operations
-        //! \param destination [out] The vector to place the code
-        void import_sl_funcs(std::vector<std::string> & destination);
+        //! \param destination [out] The string to append the code to
+        void import_sl_funcs(std::string & destination);
         
         //! \brief Import a math module
         //! \param math_import The module to import
         //! \param function_name_out [out] The name of the function the caller can use to access the imported function
-        //! \param destination [out] The vector to place the code
+        //! \param destination [out] The string to append the code to
         //! \note This method can be called as much as you want, it will only ever import one copy of the module requested
-        void import_math(AsmSupport::Math math_import, std::string & function_name_out, std::vector<std::string> & destination);
+        void import_math(AsmSupport::Math math_import, std::string & function_name_out, std::string & destination);
 
-    private:
+        //! \brief Get the name of the function a math module provides, without importing it
+        //! \param math_import The module
+        //! \returns The name the caller can use to access the module's function
+        static const std::string & get_math_function_name(AsmSupport::Math math_import);
 
-        struct ImportInfo
-        {
-            bool imported;
-            std::string function_name;
-            std::string function;
-        };
+    private:
 
         struct InitImport
         {
@@ -64,7 +64,8 @@ namespace DEL
         };
         InitImport init_import;
 
-        std::map<Math, ImportInfo> math_imports;
+        // By AsmSupport::Math
+        bool math_imported[4];
     };
 }
 
@@ -15,35 +15,26 @@ namespace CODE
     public:
         DSAllocate(DEL::CODEGEN::TYPES::DSAllocInstruction * ins, uint64_t mem_start) : Block()
         {
-            std::string title_comment = "; <<< DS ALLOC >>>";
-            code.push_back(std::string(NL) + std::string(NLT) + title_comment + std::string(NL));
-
-            std::vector<std::string> store_ins = load_64_into_r0(ins->bytes_to_alloc, "Bytes to allocate");
-            code.insert(code.end(), store_ins.begin(), store_ins.end());
-
-            std::stringstream ss;
-
-            ss << NLT
-               << "call __del__ds__alloc"
-               << NLT
-               << "pushw ls r0"
-               << NL;
-
-            code.push_back(ss.str());
-
-            std::vector<std::string> store_ins1 = load_64_into_r0(mem_start, "Load memory location");
-            code.insert(code.end(), store_ins1.begin(), store_ins1.end());
-
-            std::stringstream ss1;
-            ss1 << NLT 
-               << "ldw"  << WS << "r" << REG_ADDR_SP << WS << "$0(ls)" << TAB << "; Load SP into local stack" << NLT 
-               << "add"  << WS << "r" << REG_ADDR_RO << WS << "r" << REG_ADDR_RO << WS << "r" << REG_ADDR_SP << TAB << "; Item location in function mem" << NL << NLT
-               << "; ---- Get DS Address ---- " << NL << NLT
-               << "popw" << WS << "r" << REG_ARITH_LHS << WS << CALC_STACK << NL << NLT
-               << "; ---- Store DS Address ---- " << NL << NLT
-               << "stw" << WS << "r" << REG_ADDR_RO << "(gs)" << WS << "r" << REG_ARITH_LHS << TAB << "; Store address in memory" << NL;
-
-            code.push_back(ss1.str());
+            code.blank();
+            code.blank();
+            code.comment("<<< DS ALLOC >>>");
+
+            load_64_into_r0(code, ins->bytes_to_alloc, "Bytes to allocate");
+
+            code.instruction(Op::CALL,  { Operand::label("__del__ds__alloc") });
+            code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(0) });
+
+            load_64_into_r0(code, mem_start, "Load memory location");
+
+            locate_in_frame(code);
+            code.blank();
+            code.comment("---- Get DS Address ----");
+            code.blank();
+            code.instruction(Op::POPW, { Operand::reg(REG_ARITH_LHS), Operand::stack(CALC_STACK) });
+            code.blank();
+            code.comment("---- Store DS Address ----");
+            code.blank();
+            code.instruction(Op::STW, { Operand::addr(REG_ADDR_RO, MEM_STACK), Operand::reg(REG_ARITH_LHS) }, "Store address in memory");
         }
     };
 }
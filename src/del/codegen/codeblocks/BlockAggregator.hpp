@@ -1,6 +1,7 @@
 #ifndef DEL_BLOCK_AGGREGATOR_HPP
 #define DEL_BLOCK_AGGREGATOR_HPP
 
+#include "Buffer.hpp"
 #include "Codeblock.hpp"
 #include "Memory.hpp"
 #include <stack>
@@ -15,15 +16,25 @@ namespace CODE
     {
     public:
 
-        //  Copies block data to local vector and deletes the block
+        // Aggregators are deleted through this base by the code generator
+        //
+        virtual ~BlockAggregator() = default;
+
+        //  Moves block code to the local buffer and deletes the block
         //
         void add_block(CODE::Block * block)
         {
-            std::vector<std::string> code = block->get_code();
-            instructions.insert(instructions.end(), code.begin(), code.end());
+            instructions.append(block->take_code());
             delete block;
         }
 
+        //  Links the buffer of a finished context in without copying it
+        //
+        void add_buffer(Buffer && buffer)
+        {
+            instructions.link(std::move(buffer));
+        }
+
         // Add memory allocation so aggregator can clean 
         //
         void add_memory_alloc(Memory::MemAlloc mem_info)
@@ -32,7 +43,7 @@ namespace CODE
         }
 
     protected:
-        std::vector<std::string> instructions; 
+        Buffer instructions; 
         std::stack<Memory::MemAlloc > allocs;
     };
 }
@@ -0,0 +1,210 @@
+#ifndef DEL_BUFFER_HPP
+#define DEL_BUFFER_HPP
+
+#include "Instruction.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DEL
+{
+namespace CODE
+{
+    //
+    //  An append-only buffer of generated code. Lines are appended in place, and a finished buffer
+    //  (a nested context, a function) is linked in as a segment rather than copied. Nothing is turned
+    //  into text until the whole program is written out at the end
+    //
+    class Buffer
+    {
+    public:
+        Buffer() : length(0) {}
+
+        //  A buffer that has been moved from is left empty, and can be used again
+        //
+        Buffer(Buffer && other) : segments(std::move(other.segments)), length(other.length)
+        {
+            other.segments.clear();
+            other.length = 0;
+        }
+
+        Buffer & operator=(Buffer && other)
+        {
+            if(this != &other)
+            {
+                segments = std::move(other.segments);
+                length   = other.length;
+                other.segments.clear();
+                other.length = 0;
+            }
+            return *this;
+        }
+
+        Buffer(const Buffer &) = delete;
+        Buffer & operator=(const Buffer &) = delete;
+
+        //  Append an instruction
+        //
+        void instruction(Op op, std::vector<Operand> operands, std::string comment = "")
+        {
+            add(Line{ Line::Kind::INSTRUCTION, op, std::move(operands), std::move(comment) });
+        }
+
+        //  Append a label
+        //
+        void label(std::string name)
+        {
+            add(Line{ Line::Kind::LABEL, Op::OP_COUNT, {}, std::move(name) });
+        }
+
+        //  Append a comment on a line of its own
+        //
+        void comment(std::string text)
+        {
+            add(Line{ Line::Kind::COMMENT, Op::OP_COUNT, {}, std::move(text) });
+        }
+
+        //  Append an empty line
+        //
+        void blank()
+        {
+            add(Line{ Line::Kind::BLANK, Op::OP_COUNT, {}, "" });
+        }
+
+        //  Append a line that is passed through as given
+        //
+        void directive(std::string text)
+        {
+            add(Line{ Line::Kind::DIRECTIVE, Op::OP_COUNT, {}, std::move(text) });
+        }
+
+        //  Append a line
+        //
+        void add(Line line)
+        {
+            if(segments.empty() || segments.back().child)
+            {
+                segments.emplace_back();
+            }
+            segments.back().lines.push_back(std::move(line));
+            length++;
+        }
+
+        //  Move the lines of another buffer to the end of this one. The other buffer is consumed
+        //
+        void append(Buffer && other)
+        {
+            if(other.length == 0)
+            {
+                return;
+            }
+
+            for(auto & s : other.segments)
+            {
+                // Linked buffers stay linked
+                if(s.child)
+                {
+                    segments.push_back(std::move(s));
+                    continue;
+                }
+
+                if(segments.empty() || segments.back().child)
+                {
+                    segments.emplace_back();
+                }
+                auto & lines = segments.back().lines;
+                lines.insert(lines.end(), std::make_move_iterator(s.lines.begin()), std::make_move_iterator(s.lines.end()));
+            }
+
+            length += other.length;
+            other.segments.clear();
+            other.length = 0;
+        }
+
+        //  Link another buffer in at the current end. The other buffer is consumed
+        //
+        void link(Buffer && other)
+        {
+            if(other.length == 0)
+            {
+                return;
+            }
+            length += other.length;
+
+            segments.emplace_back();
+            segments.back().child.reset(new Buffer(std::move(other)));
+        }
+
+        //  Number of lines held, including linked buffers
+        //
+        uint64_t size() const
+        {
+            return length;
+        }
+
+        //  Move every line out, in order, linked buffers included. The buffer is left empty
+        //
+        void take_lines(std::vector<Line> & out)
+        {
+            for(auto & s : segments)
+            {
+                if(s.child)
+                {
+                    s.child->take_lines(out);
+                }
+                else
+                {
+                    out.insert(out.end(), std::make_move_iterator(s.lines.begin()), std::make_move_iterator(s.lines.end()));
+                }
+            }
+            segments.clear();
+            length = 0;
+        }
+
+        //  Append the text of the code to a string
+        //
+        void write_to(std::string & out) const
+        {
+            for(auto & s : segments)
+            {
+                if(s.child)
+                {
+                    s.child->write_to(out);
+                }
+                else
+                {
+                    for(auto & line : s.lines)
+                    {
+                        line.write_to(out);
+                    }
+                }
+            }
+        }
+
+        //  Get the text of the code as a single string
+        //
+        std::string str() const
+        {
+            std::string out;
+            write_to(out);
+            return out;
+        }
+
+    private:
+        struct Segment
+        {
+            std::vector<Line> lines;
+            std::unique_ptr<Buffer> child;
+        };
+
+        std::vector<Segment> segments;
+        uint64_t length;
+    };
+}
+}
+
+#endif
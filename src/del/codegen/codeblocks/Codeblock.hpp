@@ -3,8 +3,10 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include "SystemSettings.hpp"
 #include "CodegenTypes.hpp"
+#include "Buffer.hpp"
 #include <sstream>
 #include <libnabla/endian.hpp>
 #include <libnabla/util.hpp>
@@ -22,31 +24,35 @@ namespace CODE
                    to ensure this doesn't happen.
         */
         // Reg where we put stack pointer
-        static const int REG_ADDR_SP = 1;
+        static constexpr int REG_ADDR_SP = 1;
 
         // Return 
-        static const int REG_ADDR_RO = 0;
+        static constexpr int REG_ADDR_RO = 0;
 
         // Built in function operands
-        static const int REG_BIF_LHS = 1;
-        static const int REG_BIF_RHS = 2;
+        static constexpr int REG_BIF_LHS = 1;
+        static constexpr int REG_BIF_RHS = 2;
 
         // Generated operands
-        static const int REG_ARITH_LHS = 8;
-        static const int REG_ARITH_RHS = 9;
+        static constexpr int REG_ARITH_LHS = 8;
+        static constexpr int REG_ARITH_RHS = 9;
 
         // Conditional and comparison registers
-        static const int REG_CONDITIONAL = 8;
-        static const int REG_COMPARISON  = 7;
-
-        // Line placement
-        static constexpr char NL[]  = "\n";
-        static constexpr char TAB[] = "\t";
-        static constexpr char NLT[] = "\n\t";
-        static constexpr char WS[]  = " ";
-        static constexpr char WST[] = " \t";
-        static constexpr char CALC_STACK[] = "ls";
-        static constexpr char MEM_STACK[]  = "gs";
+        static constexpr int REG_CONDITIONAL = 8;
+        static constexpr int REG_COMPARISON  = 7;
+
+        // Registers that may be given to frame slots, in order of preference. Nothing generated or built in
+        // touches them, other than __del__ds__free
+        static constexpr int REG_ALLOCATABLE[]     = { 6, 13, 14, 15 };
+        static constexpr int REG_DS_FREE_CLOBBER[] = { 14, 15 };
+
+        // Registers an expression evaluates into. r0 and r1 are kept for addresses and wide values,
+        // r2 is an operand of the built in functions
+        static constexpr int REG_EXPRESSION[] = { 3, 4, 5, 7, 8, 9 };
+
+        // Stacks
+        static constexpr Stack CALC_STACK = Stack::LS;
+        static constexpr Stack MEM_STACK  = Stack::GS;
 
         //  Check if something is a double
         //
@@ -56,12 +62,13 @@ namespace CODE
         }
 
         //  Utilize the mov instruction to place a value of any size upto uint64_t in a register
+        //  The code is appended to result
         //
-        static std::vector<std::string> load_64_into_r0(uint64_t le_64, std::string comment)
+        static void load_64_into_r0(Buffer & result, uint64_t le_64, const std::string & comment)
         {
-            std::vector<std::string> result;
-
-            result.push_back("\n\t; Load_64_into_r0 for : " + comment + "\n\n");
+            result.blank();
+            result.comment("Load_64_into_r0 for : " + comment);
+            result.blank();
 
             // Mov instruction only handles 32-bit signed. So, if it starts to get bigger,
             // we need to dice it into parts
@@ -72,25 +79,33 @@ namespace CODE
                 uint32_t part_2 = (le_64 & 0x00000000FFFF0000) >> 16;
                 uint32_t part_3 = (le_64 & 0x000000000000FFFF) >> 0;
 
-                result.push_back("\tmov r0 $" + std::to_string(part_0) + "\t ; part_0 \n");
-                result.push_back("\tlsh r0 r0 $48\t\n");
+                result.instruction(Op::MOV, { Operand::reg(0), Operand::imm(part_0) }, "part_0");
+                result.instruction(Op::LSH, { Operand::reg(0), Operand::reg(0), Operand::imm(48) });
 
-                result.push_back("\tmov r1 $" + std::to_string(part_1) + "\t ; part_1 \n");
-                result.push_back("\tlsh r1 r1 $32\t\n");
-                result.push_back("\tor  r0 r0 r1\t\n");
+                result.instruction(Op::MOV, { Operand::reg(1), Operand::imm(part_1) }, "part_1");
+                result.instruction(Op::LSH, { Operand::reg(1), Operand::reg(1), Operand::imm(32) });
+                result.instruction(Op::OR,  { Operand::reg(0), Operand::reg(0), Operand::reg(1) });
 
-                result.push_back("\tmov r1 $" + std::to_string(part_2) + "\t ; part_2 \n");
-                result.push_back("\tlsh r1 r1 $16\t\n");
-                result.push_back("\tor  r0 r0 r1\t\n");
+                result.instruction(Op::MOV, { Operand::reg(1), Operand::imm(part_2) }, "part_2");
+                result.instruction(Op::LSH, { Operand::reg(1), Operand::reg(1), Operand::imm(16) });
+                result.instruction(Op::OR,  { Operand::reg(0), Operand::reg(0), Operand::reg(1) });
 
-                result.push_back("\tmov r1 $" + std::to_string(part_3) + "\t ; part_3 \n");
-                result.push_back("\tor  r0 r0 r1\t\n");
+                result.instruction(Op::MOV, { Operand::reg(1), Operand::imm(part_3) }, "part_3");
+                result.instruction(Op::OR,  { Operand::reg(0), Operand::reg(0), Operand::reg(1) });
             }
             else
             {
-                result.push_back("\tmov r0 $" + std::to_string(static_cast<uint32_t>(le_64)) + "\t ; Data\n");
+                result.instruction(Op::MOV, { Operand::reg(0), Operand::imm(static_cast<uint32_t>(le_64)) }, "Data");
             }
-            return result;
+        }
+
+        //  Find the location of a frame slot, whose offset is in r0, by adding the stack pointer of the function
+        //  The code is appended to result
+        //
+        static void locate_in_frame(Buffer & result)
+        {
+            result.instruction(Op::LDW, { Operand::reg(REG_ADDR_SP), Operand::fixed(0, CALC_STACK) }, "Load SP into local stack");
+            result.instruction(Op::ADD, { Operand::reg(REG_ADDR_RO), Operand::reg(REG_ADDR_RO), Operand::reg(REG_ADDR_SP) }, "Item location in function mem");
         }
     }
 
@@ -101,6 +116,39 @@ namespace CODE
         WORD
     };
 
+    //
+    //  Label numbering for a single function. Labels in the ASM are scoped to the function they
+    //  appear in, so each function numbers its labels from zero. Keeping the counters here instead
+    //  of in globals means functions can be generated independently, and in any order
+    //
+    struct Labels
+    {
+        uint64_t expression  {0};   // Comparison, and/or, negate
+        uint64_t conditional {0};   // Conditional contexts, and their branches
+        uint64_t load_store  {0};   // Load / store success checks
+        uint64_t for_loop    {0};   // For loop contexts
+        uint64_t while_loop  {0};   // While loop contexts
+        uint64_t dealloc     {0};   // Function return GS cleanup
+    };
+
+    //
+    //  Registers given to frame slots for a single function. A slot with a register is read and written
+    //  there for the whole function and its frame word is never touched. Slots that aren't listed live in
+    //  the frame
+    //
+    struct Registers
+    {
+        static constexpr int NONE = -1;
+
+        std::unordered_map<uint64_t, int> slots;    // Frame position -> register
+
+        int find(uint64_t position) const
+        {
+            auto it = slots.find(position);
+            return (it == slots.end()) ? NONE : it->second;
+        }
+    };
+
     //
     //  A base 'block' that represents a code block. Contains representations of commonly used actions
     //  as well as a storage unit for generated code that a caller can access to get the data
@@ -109,50 +157,59 @@ namespace CODE
     {
     public:
 
-        Block(bool is_unary=false)
+        Block(bool is_unary=false) : is_unary(is_unary)
+        {
+        }
+
+        virtual ~Block() = default;
+
+        //  Take the generated code, leaving the block empty
+        //
+        Buffer take_code()
+        {
+            return std::move(code);
+        }
+
+    protected:
+        bool is_unary;
+
+        Buffer code;
+
+        //  Pop the operand(s) of a calculation off of the calc stack
+        //
+        void remove_for_calc()
         {
-            std::stringstream ss; 
-            std::stringstream ss1; 
-            std::stringstream ss2; 
             if(is_unary)
             {
-                ss << NLT << "popw" << WS << "r" << REG_ARITH_LHS << WS << CALC_STACK << WST << "; Calculation - Unary";
-                remove_for_calc = ss.str();
-                ss.clear();
+                code.instruction(Op::POPW, { Operand::reg(REG_ARITH_LHS), Operand::stack(CALC_STACK) }, "Calculation - Unary");
+                return;
+            }
+            code.instruction(Op::POPW, { Operand::reg(REG_ARITH_RHS), Operand::stack(CALC_STACK) }, "Calculation RHS");
+            code.instruction(Op::POPW, { Operand::reg(REG_ARITH_LHS), Operand::stack(CALC_STACK) }, "Calculation LHS");
+        }
 
-                ss1 << WS << "r" << REG_ARITH_LHS << WS  << "r" << REG_ARITH_LHS << WST << "; Perform unary operation"
-                   << NLT << "pushw" << WS << CALC_STACK << WS << "r" << REG_ARITH_LHS << WST << "; Put result into calc stack";
-                calculate_and_store = ss1.str();
+        //  Perform a calculation on the operands, and push its result back to the calc stack
+        //
+        void calculate_and_store(Op op)
+        {
+            if(is_unary)
+            {
+                code.instruction(op, { Operand::reg(REG_ARITH_LHS), Operand::reg(REG_ARITH_LHS) }, "Perform unary operation");
             }
             else
             {
-                ss << NLT  << "popw" << WS << "r" << REG_ARITH_RHS << WS << CALC_STACK << WST << "; Calculation RHS"
-                   << NLT  << "popw" << WS << "r" << REG_ARITH_LHS << WS << CALC_STACK << WST << "; Calculation LHS";
-                remove_for_calc = ss.str();
-
-                ss1 << WS << "r" << REG_ARITH_LHS << WS << "r" << REG_ARITH_LHS << WS << "r" << REG_ARITH_RHS << WST << "; Perform operation"
-                   << NLT << "pushw" << WS << CALC_STACK << WS << "r" << REG_ARITH_LHS << WST << "; Put result into calc stack";
-
-                calculate_and_store = ss1.str();
+                code.instruction(op, { Operand::reg(REG_ARITH_LHS), Operand::reg(REG_ARITH_LHS), Operand::reg(REG_ARITH_RHS) }, "Perform operation");
             }
-
-            ss2 << NLT  << "popw" << WS << "r" << REG_BIF_RHS << WS << CALC_STACK << WST << "; Calculation built in function RHS"
-                << NLT  << "popw" << WS << "r" << REG_BIF_LHS << WS << CALC_STACK << WST << "; Calculation built in function LHS";
-            bif_remove_for_calc = ss2.str();
-            ss2.clear();
+            code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(REG_ARITH_LHS) }, "Put result into calc stack");
         }
 
-        std::vector<std::string> get_code() const
+        //  Pop the operands of a built in function off of the calc stack
+        //
+        void bif_remove_for_calc()
         {
-            return code;
+            code.instruction(Op::POPW, { Operand::reg(REG_BIF_RHS), Operand::stack(CALC_STACK) }, "Calculation built in function RHS");
+            code.instruction(Op::POPW, { Operand::reg(REG_BIF_LHS), Operand::stack(CALC_STACK) }, "Calculation built in function LHS");
         }
-
-    protected:
-        std::string remove_for_calc;
-        std::string calculate_and_store;
-        std::string bif_remove_for_calc;
-
-        std::vector<std::string> code;
     };
 }
 }
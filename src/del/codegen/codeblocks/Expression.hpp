@@ -0,0 +1,473 @@
+#ifndef DEL_EXPRESSION_BLOCK_HPP
+#define DEL_EXPRESSION_BLOCK_HPP
+
+#include "Codeblock.hpp"
+#include "LoadStore.hpp"
+#include "AsmSupport.hpp"
+#include "Errors.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace DEL
+{
+namespace CODE
+{
+    //
+    //  Expression
+    //
+    //      Evaluates a calculation straight into registers rather than through the calc stack. The RPN
+    //      instructions are turned back into a tree, and each node is labelled with the number of registers
+    //      it needs (Sethi-Ullman). The side of an operation that needs more is evaluated first, so the fewest
+    //      registers are held at once. Items that have been given a register are used where they are.
+    //
+    //      The calc stack is only used to hold a value while a call runs, as a call destroys every register,
+    //      or when the registers run out. Without calls, the order items are read in doesn't matter. With them
+    //      the order of the RPN is kept so every item given a register is read before any call that follows it
+    //
+    class Expression : public Block
+    {
+    public:
+
+        //! \brief Check if a calculation can be evaluated in registers
+        //! \param rpn The instructions of the calculation, without what is done with the result
+        static bool accepts(const std::vector<CODEGEN::TYPES::BaseInstruction*> & rpn)
+        {
+            int depth = 0;
+            for(auto & ins : rpn)
+            {
+                switch(ins->instruction)
+                {
+                    case CODEGEN::TYPES::InstructionSet::LOAD:
+                        if(!Memory::is_frame_resident(static_cast<CODEGEN::TYPES::AddressValueInstruction*>(ins)->bytes)) { return false; }
+                        depth++;
+                        break;
+                    case CODEGEN::TYPES::InstructionSet::USE_RAW:
+                        if(static_cast<CODEGEN::TYPES::RawValueInstruction*>(ins)->byte_len != SETTINGS::SYSTEM_WORD_SIZE_BYTES) { return false; }
+                        depth++;
+                        break;
+                    case CODEGEN::TYPES::InstructionSet::CALL:
+                        if(!static_cast<CODEGEN::TYPES::CallInstruction*>(ins)->expect_return_value) { return false; }
+                        depth++;
+                        break;
+                    case CODEGEN::TYPES::InstructionSet::MOVE_ADDRESS:
+                        break;
+                    case CODEGEN::TYPES::InstructionSet::BW_NOT:
+                    case CODEGEN::TYPES::InstructionSet::NEGATE:
+                        if(depth < 1) { return false; }
+                        break;
+                    case CODEGEN::TYPES::InstructionSet::STORE:
+                    case CODEGEN::TYPES::InstructionSet::RETURN:
+                    case CODEGEN::TYPES::InstructionSet::DS_ALLOC:
+                        return false;
+                    default:
+                        if(depth < 2) { return false; }
+                        depth--;
+                        break;
+                }
+            }
+            return depth == 1;
+        }
+
+        //! \brief Generate the code for a calculation
+        //! \pre accepts(rpn)
+        Expression(const std::vector<CODEGEN::TYPES::BaseInstruction*> & rpn, CODEGEN::TYPES::DataClassification classification,
+                   Labels & labels, const Registers & registers) : Block(), is_double(is_double_variant(classification)),
+                                                                   labels(labels), registers(registers)
+        {
+            int root = build_tree(rpn);
+
+            code.blank();
+            code.comment("<<< EXPRESSION >>>");
+
+            std::vector<int> temps(std::begin(REG_EXPRESSION), std::end(REG_EXPRESSION));
+            result = evaluate(root, temps).reg;
+        }
+
+        //! \brief Get the register the result was left in. It is only valid until the next block
+        int get_result() const
+        {
+            return result;
+        }
+
+        //! \brief Get the built in modules the calculation calls, in the order they are called
+        const std::vector<AsmSupport::Math> & get_builtins() const
+        {
+            return builtins;
+        }
+
+    private:
+
+        struct Node
+        {
+            CODEGEN::TYPES::BaseInstruction * ins;
+            std::vector<CODEGEN::TYPES::MoveInstruction*> arguments;   // CALL
+            int lhs;
+            int rhs;                // Binary only
+            int need;               // Registers needed to evaluate
+            bool has_call;          // Somewhere in the tree
+            bool reads_registers;   // Somewhere in the tree, an item given a register is read
+        };
+
+        struct Value
+        {
+            int reg;
+            bool owned;             // One of the expression registers, rather than an item's own register
+        };
+
+        bool is_double;
+        Labels & labels;
+        const Registers & registers;
+        std::vector<Node> nodes;
+        std::vector<AsmSupport::Math> builtins;
+        int result;
+
+        //  Rebuild the tree from the RPN, labelling nodes as they are made. Children are always made first
+        //
+        int build_tree(const std::vector<CODEGEN::TYPES::BaseInstruction*> & rpn)
+        {
+            std::vector<int> stack;
+            std::vector<CODEGEN::TYPES::MoveInstruction*> arguments;
+
+            for(auto & ins : rpn)
+            {
+                Node node { ins, {}, -1, -1, 1, false, false };
+
+                switch(ins->instruction)
+                {
+                    case CODEGEN::TYPES::InstructionSet::MOVE_ADDRESS:
+                        arguments.push_back(static_cast<CODEGEN::TYPES::MoveInstruction*>(ins));
+                        continue;
+
+                    case CODEGEN::TYPES::InstructionSet::CALL:
+                        node.arguments.swap(arguments);
+                        node.has_call = true;
+                        break;
+
+                    case CODEGEN::TYPES::InstructionSet::LOAD:
+                        // An item in a register is used where it is
+                        if(registers.find(static_cast<CODEGEN::TYPES::AddressValueInstruction*>(ins)->value) != Registers::NONE)
+                        {
+                            node.need = 0;
+                            node.reads_registers = true;
+                        }
+                        break;
+
+                    case CODEGEN::TYPES::InstructionSet::USE_RAW:
+                        break;
+
+                    case CODEGEN::TYPES::InstructionSet::BW_NOT:
+                    case CODEGEN::TYPES::InstructionSet::NEGATE:
+                    {
+                        node.lhs = stack.back();
+                        stack.pop_back();
+
+                        const Node & child = nodes[node.lhs];
+                        node.need = std::max(1, child.need);
+                        node.has_call = child.has_call;
+                        node.reads_registers = child.reads_registers;
+                        break;
+                    }
+                    default:
+                    {
+                        node.rhs = stack.back();
+                        stack.pop_back();
+                        node.lhs = stack.back();
+                        stack.pop_back();
+
+                        const Node & l = nodes[node.lhs];
+                        const Node & r = nodes[node.rhs];
+                        node.need = std::max(1, (l.need == r.need) ? l.need + 1 : std::max(l.need, r.need));
+                        node.has_call = l.has_call || r.has_call;
+
+                        // Holding one side while a call runs takes a second register to bring it back
+                        if(node.has_call) { node.need = std::max(2, node.need); }
+                        node.reads_registers = l.reads_registers || r.reads_registers;
+                        break;
+                    }
+                }
+
+                nodes.push_back(std::move(node));
+                stack.push_back(static_cast<int>(nodes.size()) - 1);
+            }
+            return stack.back();
+        }
+
+        //  Evaluate a node using the given free registers. The result is in the first of them, unless the
+        //  node is an item that already has a register of its own
+        //
+        Value evaluate(int index, const std::vector<int> & temps)
+        {
+            const Node & node = nodes[index];
+
+            if(node.lhs < 0)
+            {
+                return evaluate_leaf(node, temps);
+            }
+
+            if(node.rhs < 0)
+            {
+                Value operand = evaluate(node.lhs, temps);
+                int destination = (operand.owned) ? operand.reg : temps.front();
+                emit_unary(node, destination, operand.reg);
+                return Value{ destination, true };
+            }
+
+            const Node & l = nodes[node.lhs];
+            const Node & r = nodes[node.rhs];
+
+            // Without calls, the side that needs more goes first. With them, the RPN order is kept unless the
+            // call can be made first without moving a read of a register past it
+            bool rhs_first = false;
+            if(!l.has_call && !r.has_call)
+            {
+                rhs_first = (r.need > l.need);
+            }
+            else if(!l.has_call && !l.reads_registers)
+            {
+                rhs_first = true;
+            }
+
+            int first_index  = (rhs_first) ? node.rhs : node.lhs;
+            int second_index = (rhs_first) ? node.lhs : node.rhs;
+            const Node & second_node = nodes[second_index];
+
+            Value first = evaluate(first_index, temps);
+
+            std::vector<int> remaining;
+            for(auto reg : temps)
+            {
+                if(!(first.owned && reg == first.reg)) { remaining.push_back(reg); }
+            }
+
+            Value second;
+            if(second_node.has_call || second_node.need > static_cast<int>(remaining.size()))
+            {
+                // Hold the first value on the calc stack while the second is worked out
+                code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(first.reg) }, "Hold operand");
+
+                second = evaluate(second_index, temps);
+
+                int restore = (second.owned && second.reg == temps[0]) ? temps[1] : temps[0];
+
+                code.instruction(Op::POPW, { Operand::reg(restore), Operand::stack(CALC_STACK) }, "Restore operand");
+
+                first = Value{ restore, true };
+            }
+            else
+            {
+                second = evaluate(second_index, remaining);
+            }
+
+            Value lhs = (rhs_first) ? second : first;
+            Value rhs = (rhs_first) ? first  : second;
+
+            int destination = temps.front();
+            if(lhs.owned)      { destination = lhs.reg; }
+            else if(rhs.owned) { destination = rhs.reg; }
+
+            emit_binary(node, destination, lhs.reg, rhs.reg);
+            return Value{ destination, true };
+        }
+
+        Value evaluate_leaf(const Node & node, const std::vector<int> & temps)
+        {
+            // Items with a register of their own need nothing done, and may be given no registers to use
+            if(node.need == 0)
+            {
+                return Value{ registers.find(static_cast<CODEGEN::TYPES::AddressValueInstruction*>(node.ins)->value), false };
+            }
+
+            int destination = temps.front();
+
+            switch(node.ins->instruction)
+            {
+                case CODEGEN::TYPES::InstructionSet::LOAD:
+                {
+                    auto * ins = static_cast<CODEGEN::TYPES::AddressValueInstruction*>(node.ins);
+
+                    load_64_into_r0(code, ins->value, "Address of item in expression");
+
+                    locate_in_frame(code);
+                    code.instruction(Op::LDW, { Operand::reg(destination), Operand::addr(REG_ADDR_RO, MEM_STACK) }, "Load the value from the frame");
+                    break;
+                }
+                case CODEGEN::TYPES::InstructionSet::USE_RAW:
+                {
+                    uint64_t value = static_cast<CODEGEN::TYPES::RawValueInstruction*>(node.ins)->value;
+
+                    // Mov only takes a signed 32-bit value, anything larger is built in r0
+                    if(value > 2147483647)
+                    {
+                        load_64_into_r0(code, value, "Wide value");
+                        code.instruction(Op::MOV, { Operand::reg(destination), Operand::reg(REG_ADDR_RO) });
+                    }
+                    else
+                    {
+                        code.instruction(Op::MOV, { Operand::reg(destination), Operand::imm(value) }, "Value");
+                    }
+                    break;
+                }
+                case CODEGEN::TYPES::InstructionSet::CALL:
+                {
+                    for(auto & argument : node.arguments)
+                    {
+                        MoveAddress move(argument);
+                        code.append(move.take_code());
+                    }
+
+                    code.instruction(Op::CALL, { Operand::label(static_cast<CODEGEN::TYPES::CallInstruction*>(node.ins)->function_name) }, "Call function");
+                    code.instruction(Op::LDW,  { Operand::reg(destination), Operand::fixed(SETTINGS::GS_INDEX_RETURN_SPACE, MEM_STACK) }, "Get result from call");
+                    break;
+                }
+                default:
+                    throw InternalError("CODE::Expression", "Developer Error : Expression given an unknown item");
+            }
+
+            return Value{ destination, true };
+        }
+
+        void emit_unary(const Node & node, int destination, int operand)
+        {
+            if(node.ins->instruction == CODEGEN::TYPES::InstructionSet::BW_NOT)
+            {
+                code.instruction(Op::NOT, { Operand::reg(destination), Operand::reg(operand) }, "Bitwise not");
+                return;
+            }
+
+            // Negate : 1 if the operand isn't above 0, otherwise 0
+            uint64_t id = labels.expression++;
+            std::string set_zero = "NEGATE_set_zero_" + std::to_string(id);
+            std::string complete = "NEGATE_complete_" + std::to_string(id);
+
+            code.instruction(Op::MOV, { Operand::reg(REG_ADDR_RO), Operand::imm(0) }, "Comparison");
+            code.instruction(variant(Op::BGT), { Operand::reg(operand), Operand::reg(REG_ADDR_RO), Operand::label(set_zero) });
+            code.instruction(Op::MOV, { Operand::reg(destination), Operand::imm(1) });
+            code.instruction(Op::JMP, { Operand::label(complete) });
+            code.blank();
+            code.label(set_zero);
+            code.instruction(Op::MOV, { Operand::reg(destination), Operand::imm(0) });
+            code.blank();
+            code.label(complete);
+        }
+
+        void emit_binary(const Node & node, int destination, int lhs, int rhs)
+        {
+            switch(node.ins->instruction)
+            {
+                case CODEGEN::TYPES::InstructionSet::ADD:    arithmetic(variant(Op::ADD), destination, lhs, rhs); break;
+                case CODEGEN::TYPES::InstructionSet::SUB:    arithmetic(variant(Op::SUB), destination, lhs, rhs); break;
+                case CODEGEN::TYPES::InstructionSet::DIV:    arithmetic(variant(Op::DIV), destination, lhs, rhs); break;
+                case CODEGEN::TYPES::InstructionSet::MUL:    arithmetic(variant(Op::MUL), destination, lhs, rhs); break;
+                case CODEGEN::TYPES::InstructionSet::RSH:    arithmetic(Op::RSH, destination, lhs, rhs); break;
+                case CODEGEN::TYPES::InstructionSet::LSH:    arithmetic(Op::LSH, destination, lhs, rhs); break;
+                case CODEGEN::TYPES::InstructionSet::BW_OR:  arithmetic(Op::OR,  destination, lhs, rhs); break;
+                case CODEGEN::TYPES::InstructionSet::BW_XOR: arithmetic(Op::XOR, destination, lhs, rhs); break;
+                case CODEGEN::TYPES::InstructionSet::BW_AND: arithmetic(Op::AND, destination, lhs, rhs); break;
+
+                case CODEGEN::TYPES::InstructionSet::LTE: compare(variant(Op::BLTE), destination, lhs, rhs); break;
+                case CODEGEN::TYPES::InstructionSet::LT:  compare(variant(Op::BLT),  destination, lhs, rhs); break;
+                case CODEGEN::TYPES::InstructionSet::GTE: compare(variant(Op::BGTE), destination, lhs, rhs); break;
+                case CODEGEN::TYPES::InstructionSet::GT:  compare(variant(Op::BGT),  destination, lhs, rhs); break;
+                case CODEGEN::TYPES::InstructionSet::EQ:  compare(variant(Op::BEQ),  destination, lhs, rhs); break;
+                case CODEGEN::TYPES::InstructionSet::NE:  compare(variant(Op::BNE),  destination, lhs, rhs); break;
+
+                case CODEGEN::TYPES::InstructionSet::OR:
+                {
+                    uint64_t id = labels.expression++;
+                    std::string is_true  = "OR_is_true_"     + std::to_string(id);
+                    std::string complete = "OR_is_complete_" + std::to_string(id);
+
+                    code.instruction(Op::MOV, { Operand::reg(REG_ADDR_RO), Operand::imm(0) }, "Comparison value");
+                    code.instruction(variant(Op::BGT), { Operand::reg(lhs), Operand::reg(REG_ADDR_RO), Operand::label(is_true) });
+                    code.instruction(variant(Op::BGT), { Operand::reg(rhs), Operand::reg(REG_ADDR_RO), Operand::label(is_true) });
+                    code.instruction(Op::MOV, { Operand::reg(destination), Operand::imm(0) }, "False");
+                    code.instruction(Op::JMP, { Operand::label(complete) });
+                    code.blank();
+                    code.label(is_true);
+                    code.instruction(Op::MOV, { Operand::reg(destination), Operand::imm(1) }, "True");
+                    code.blank();
+                    code.label(complete);
+                    break;
+                }
+                case CODEGEN::TYPES::InstructionSet::AND:
+                {
+                    uint64_t id = labels.expression++;
+                    std::string first_true  = "AND_first_true_"  + std::to_string(id);
+                    std::string second_true = "AND_second_true_" + std::to_string(id);
+                    std::string complete    = "AND_complete_"    + std::to_string(id);
+
+                    code.instruction(Op::MOV, { Operand::reg(REG_ADDR_RO), Operand::imm(0) }, "Comparison value");
+                    code.instruction(variant(Op::BGT), { Operand::reg(lhs), Operand::reg(REG_ADDR_RO), Operand::label(first_true) });
+                    code.instruction(Op::MOV, { Operand::reg(destination), Operand::imm(0) }, "False");
+                    code.instruction(Op::JMP, { Operand::label(complete) });
+                    code.blank();
+                    code.label(first_true);
+                    code.instruction(variant(Op::BGT), { Operand::reg(rhs), Operand::reg(REG_ADDR_RO), Operand::label(second_true) });
+                    code.instruction(Op::MOV, { Operand::reg(destination), Operand::imm(0) }, "False");
+                    code.instruction(Op::JMP, { Operand::label(complete) });
+                    code.blank();
+                    code.label(second_true);
+                    code.instruction(Op::MOV, { Operand::reg(destination), Operand::imm(1) }, "True");
+                    code.blank();
+                    code.label(complete);
+                    break;
+                }
+                case CODEGEN::TYPES::InstructionSet::POW:
+                case CODEGEN::TYPES::InstructionSet::MOD:
+                {
+                    AsmSupport::Math module;
+                    if(node.ins->instruction == CODEGEN::TYPES::InstructionSet::POW)
+                    {
+                        module = (is_double) ? AsmSupport::Math::POW_D : AsmSupport::Math::POW_I;
+                    }
+                    else
+                    {
+                        module = (is_double) ? AsmSupport::Math::MOD_D : AsmSupport::Math::MOD_I;
+                    }
+                    builtins.push_back(module);
+
+                    // The built in functions leave every expression register as it was
+                    code.instruction(Op::MOV,  { Operand::reg(REG_BIF_LHS), Operand::reg(lhs) }, "Built in function LHS");
+                    code.instruction(Op::MOV,  { Operand::reg(REG_BIF_RHS), Operand::reg(rhs) }, "Built in function RHS");
+                    code.instruction(Op::CALL, { Operand::label(AsmSupport::get_math_function_name(module)) });
+                    code.instruction(Op::MOV,  { Operand::reg(destination), Operand::reg(REG_ADDR_RO) });
+                    break;
+                }
+                default:
+                    throw InternalError("CODE::Expression", "Developer Error : Expression given an unknown operation");
+            }
+        }
+
+        //  The double variant of an instruction, where the expression is a double
+        //
+        Op variant(Op op) const
+        {
+            return (is_double) ? double_variant(op) : op;
+        }
+
+        void arithmetic(Op op, int destination, int lhs, int rhs)
+        {
+            code.instruction(op, { Operand::reg(destination), Operand::reg(lhs), Operand::reg(rhs) });
+        }
+
+        void compare(Op op, int destination, int lhs, int rhs)
+        {
+            uint64_t id = labels.expression++;
+            std::string check    = "conditional_check_"    + std::to_string(id);
+            std::string complete = "conditional_complete_" + std::to_string(id);
+
+            code.instruction(op, { Operand::reg(lhs), Operand::reg(rhs), Operand::label(check) });
+            code.instruction(Op::MOV, { Operand::reg(destination), Operand::imm(0) }, "False");
+            code.instruction(Op::JMP, { Operand::label(complete) });
+            code.blank();
+            code.label(check);
+            code.instruction(Op::MOV, { Operand::reg(destination), Operand::imm(1) }, "True");
+            code.blank();
+            code.label(complete);
+        }
+    };
+}
+}
+
+#endif
@@ -9,33 +9,22 @@ namespace DEL
 {
 namespace CODE
 {
-namespace 
-{
-    // This increases over the lifespan of the program. Hopefully people 
-    // dont end up making 2^64-1 loops. 
-    static uint64_t FOR_LOOP_CONTEXT = 0;
-}
-
     //! \brief A loop context aggregator that builds instructions
     class ForLoopContext : public BlockAggregator
     {
     public:
-        ForLoopContext(CODEGEN::TYPES::ForLoopInitiation * loop_init) : loop_info(loop_init)
+        ForLoopContext(CODEGEN::TYPES::ForLoopInitiation * loop_init, Labels & labels, const Registers & registers) : loop_info(loop_init), labels(labels), registers(registers)
         {
-            loop_label = "loop_context_" + std::to_string(FOR_LOOP_CONTEXT++);
-
-            std::stringstream ss;
-            ss << NLT 
-               << "; <<< FOR LOOP >>>" << NL << NL
-               << loop_label << ":";
-
-            instructions.push_back(ss.str());
+            loop_label = "loop_context_" + std::to_string(labels.for_loop++);
 
+            instructions.comment("<<< FOR LOOP >>>");
+            instructions.blank();
+            instructions.label(loop_label);
         }
 
-        //! \brief Export the aggregated instructions as a block
-        //!        so it can be stored into another aggregator
-        Block * export_as_block()
+        //! \brief Export the aggregated instructions as a buffer
+        //!        so it can be linked into another aggregator
+        Buffer export_as_buffer()
         {
             // Load end var
             {
@@ -45,15 +34,12 @@ namespace
                     loop_info->end_var.bytes_requested
                     );
 
-                CODE::Load * load_ins = new CODE::Load(loader);
+                CODE::Load * load_ins = new CODE::Load(loader, labels, registers);
 
-                // Get the generated code
-                std::vector<std::string> li = load_ins->get_code();
+                // Add load code
+                instructions.append(load_ins->take_code());
                 delete load_ins;
                 delete loader;
-
-                // Add load code
-                instructions.insert(instructions.end(), li.begin(), li.end());
             }
 
             // Load loop var
@@ -64,15 +50,12 @@ namespace
                     loop_info->loop_var.bytes_requested
                     );
 
-                CODE::Load * load_ins = new CODE::Load(loader);
+                CODE::Load * load_ins = new CODE::Load(loader, labels, registers);
 
-                // Get the generated code
-                std::vector<std::string> li = load_ins->get_code();
+                // Add load code
+                instructions.append(load_ins->take_code());
                 delete load_ins;
                 delete loader;
-
-                // Add load code
-                instructions.insert(instructions.end(), li.begin(), li.end());
             }
 
             // Load step var
@@ -83,111 +66,68 @@ namespace
                     loop_info->step.bytes_requested
                     );
 
-                CODE::Load * load_ins = new CODE::Load(loader);
+                CODE::Load * load_ins = new CODE::Load(loader, labels, registers);
 
-                // Get the generated code
-                std::vector<std::string> li = load_ins->get_code();
+                // Add load code
+                instructions.append(load_ins->take_code());
                 delete load_ins;
                 delete loader;
-
-                // Add load code
-                instructions.insert(instructions.end(), li.begin(), li.end());
             }
 
             // Calculate and store new loop variable
             {
-                std::stringstream ss; 
-
-                if(loop_info->classification == CODEGEN::TYPES::DataClassification::INTEGER)
-                {
-                    ss << NLT 
-                    << "popw  r0 ls"    << TAB << "; Load step variable into r0"           << NLT 
-                    << "popw  r1 ls"    << TAB << "; Load loop variable into r1"           << NLT 
-                    << "add   r0 r0 r1" << TAB << "; Add step to loop variable into r0"    << NLT
-                    << "pushw ls r0"    << TAB << "; Put the new loop var in ls"           << NLT
-                    << "pushw ls r0"    << TAB << "; Store again so store_ins can take one"<< NLT;
-                }
-                else
-                {
-                    ss << NLT 
-                    << "popw  r0 ls"    << TAB << "; Load step variable into r0"           << NLT 
-                    << "popw  r1 ls"    << TAB << "; Load loop variable into r1"           << NLT 
-                    << "add.d r0 r0 r1" << TAB << "; Add step to loop variable into r0"    << NLT
-                    << "pushw ls r0"    << TAB << "; Put the new loop var in ls"           << NLT
-                    << "pushw ls r0"    << TAB << "; Store again so store_ins can take one"<< NLT;
-                }
-                instructions.push_back(ss.str());
+                Op add = (loop_info->classification == CODEGEN::TYPES::DataClassification::INTEGER) ? Op::ADD : Op::ADD_D;
+
+                instructions.instruction(Op::POPW,  { Operand::reg(0), Operand::stack(CALC_STACK) }, "Load step variable into r0");
+                instructions.instruction(Op::POPW,  { Operand::reg(1), Operand::stack(CALC_STACK) }, "Load loop variable into r1");
+                instructions.instruction(add,       { Operand::reg(0), Operand::reg(0), Operand::reg(1) }, "Add step to loop variable into r0");
+                instructions.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(0) }, "Put the new loop var in ls");
+                instructions.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(0) }, "Store again so store_ins can take one");
 
                 CODE::Store * store_ins = new CODE::Store(loop_info->loop_var.start_pos, 
                                                           loop_info->loop_var.bytes_requested,
-                                                          "Loop Variable");
+                                                          "Loop Variable",
+                                                          labels,
+                                                          registers);
 
-                std::vector<std::string> si = store_ins->get_code();
+                // Add store code
+                instructions.append(store_ins->take_code());
                 delete store_ins;
-
-                // Add load code
-                instructions.insert(instructions.end(), si.begin(), si.end());
             }
 
-            instructions.push_back(std::string(NLT) + "; Dealloc items alloced in loop" + std::string(NL));
+            instructions.comment("Dealloc items alloced in loop");
 
             // Dealloc any new items in the loop
             while(!allocs.empty())
             {
-                std::vector<std::string> addr_ins = load_64_into_r0(allocs.top().start_pos, 
-                                                                    "Item start");
-                instructions.insert(instructions.end(), addr_ins.begin(), addr_ins.end());
-
-                std::stringstream ss;
-                ss << NLT 
-                << "ldw"  << WS << "r" << REG_ADDR_SP << WS << "$0(ls)" << TAB << "; Load SP into local stack" << NLT 
-                << "add"  << WS << "r" << REG_ADDR_RO << WS << "r" << REG_ADDR_RO << WS << "r" << REG_ADDR_SP << TAB << "; Item location in function mem" << NL << NLT
-                << "ldw r0 r" << REG_ADDR_RO << "(gs)" << TAB << "; Load the DS Address from memory for dealloc" << NLT
-                << "call __del__ds__free" << NL;
-
-                instructions.push_back(ss.str());
+                load_64_into_r0(instructions, allocs.top().start_pos, "Item start");
+
+                locate_in_frame(instructions);
+                instructions.blank();
+                instructions.instruction(Op::LDW,  { Operand::reg(0), Operand::addr(REG_ADDR_RO, MEM_STACK) }, "Load the DS Address from memory for dealloc");
+                instructions.instruction(Op::CALL, { Operand::label("__del__ds__free") });
+
                 allocs.pop();
             }
 
             // Compare and conditionally jump
             {
-                std::stringstream ss;
-
-                if(loop_info->classification == CODEGEN::TYPES::DataClassification::INTEGER)
-                {
-                    ss << NLT
-                    << "popw r0 ls" << TAB << "; Get the step variable " << NLT 
-                    << "popw r1 ls" << TAB << "; Get the end variable"   << NLT 
-                    << "blt r0 r1 " << loop_label << NLT;
-                }
-                else
-                {
-                    ss << NLT
-                    << "popw r0 ls" << TAB << "; Get the step variable " << NLT 
-                    << "popw r1 ls" << TAB << "; Get the end variable"   << NLT 
-                    << "blt.d r0 r1 " << loop_label << NLT;
-                }
-                instructions.push_back(ss.str());
+                Op branch = (loop_info->classification == CODEGEN::TYPES::DataClassification::INTEGER) ? Op::BLT : Op::BLT_D;
+
+                instructions.instruction(Op::POPW, { Operand::reg(0), Operand::stack(CALC_STACK) }, "Get the step variable");
+                instructions.instruction(Op::POPW, { Operand::reg(1), Operand::stack(CALC_STACK) }, "Get the end variable");
+                instructions.instruction(branch,   { Operand::reg(0), Operand::reg(1), Operand::label(loop_label) });
             }
 
-            delete loop_info;
-            return new Export(instructions);
+            return std::move(instructions);
         }
 
     private:
 
         std::string loop_label;
         CODEGEN::TYPES::ForLoopInitiation * loop_info;
-
-        // Class to export the context as a block
-        class Export : public Block
-        {
-        public:
-            Export(std::vector<std::string> ins) : Block()
-            {
-                code.insert(code.end(), ins.begin(), ins.end());
-            } 
-        };
+        Labels & labels;
+        const Registers & registers;
     };
 
 }
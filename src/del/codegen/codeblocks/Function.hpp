@@ -2,15 +2,12 @@
 #define DEL_FUNCTION_BLOCK_HPP
 
 #include "BlockAggregator.hpp"
+#include "Errors.hpp"
 
 namespace DEL
 {
 namespace CODE
 {
-namespace
-{
-    static int LABEL_COUNTER = 0;
-}
     //
     //  A function
     //
@@ -22,7 +19,8 @@ namespace
     class Function : public BlockAggregator
     {
     public:
-        Function(std::string name, std::vector<CODEGEN::TYPES::ParamInfo> params) : name(name), params(params), bytes_required(0)
+        Function(std::string name, std::vector<CODEGEN::TYPES::ParamInfo> params, std::vector<uint64_t> ds_slots, Labels & labels, const Registers & registers) : 
+            name(name), params(params), ds_slots(ds_slots), bytes_required(0), labels(labels), registers(registers)
         {
             // Allocate a space for each parameter
             //
@@ -47,69 +45,74 @@ namespace
         //
         // ----------------------------------------
 
-        std::vector<std::string> building_complete()
+        Buffer building_complete()
         {
             // Putting this limit in place while we get things working
             if(bytes_required >= 2147483647)
             {
-                std::cerr << "CodeBlock::Function >>> Function size is currently limited to bytes represented by an int32_t (2147483647 bytes)" << std::endl;
-                exit(EXIT_FAILURE);
+                throw InternalError("CodeBlock::Function", "Function size is currently limited to bytes represented by an int32_t (2147483647 bytes)");
             }
 
-            std::vector<std::string> lines;
-
-            std::stringstream ss;
-            ss << NL << NL << "<" << name << ":" << NL << NLT
-               << "ldw r8 $0(gs)" << TAB << "; Load the current stack pointer" << NLT 
-               << "pushw ls r8"   << TAB << "; Store the local stack pointer in function memory" << NLT 
-               << "mov r9 $"      << ENDIAN::conditional_to_le_64(bytes_required/8) << TAB << "; Words required for function (" << name << ")" << NLT
-               << "pushw ls r9"   << TAB << "; Store size in local funtion memory" << NL << NLT
-               << "; Expand GS to store current function" << NL << NLT
-               << "mov r1 $0" << NLT
-               << "mov r2 $0" << NL << NL
-               << "function_alloc_gs:" << NLT
-               << "add r1 r1 $1" << NLT
-               << "pushw gs r2" << NLT
-               << "blt r1 r9 function_alloc_gs" << NL << NLT
-               << "mov r9 $" << ENDIAN::conditional_to_le_64(bytes_required) << TAB << "; Bytes reqired for function (" << name << ")" << NLT
-               << "add r8 r8 r9"  << TAB << "; Add function size to the stack pointer" << NLT 
-               << "stw $0(gs) r8" << TAB << "; Increase the stack pointer" << NL;
-
-            lines.push_back(ss.str());
+            Buffer lines;
+
+            lines.blank();
+            lines.blank();
+            lines.directive("<" + name + ":");
+            lines.blank();
+            lines.instruction(Op::LDW,   { Operand::reg(8), Operand::fixed(0, MEM_STACK) }, "Load the current stack pointer");
+            lines.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(8) }, "Store the local stack pointer in function memory");
+            lines.instruction(Op::MOV,   { Operand::reg(9), Operand::imm(ENDIAN::conditional_to_le_64(bytes_required/8)) }, "Words required for function (" + name + ")");
+            lines.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(9) }, "Store size in local funtion memory");
+            lines.blank();
+            lines.comment("Expand GS to store current function");
+            lines.blank();
+            lines.instruction(Op::MOV, { Operand::reg(1), Operand::imm(0) });
+            lines.instruction(Op::MOV, { Operand::reg(2), Operand::imm(0) });
+            lines.blank();
+            lines.label("function_alloc_gs");
+            lines.instruction(Op::ADD,   { Operand::reg(1), Operand::reg(1), Operand::imm(1) });
+            lines.instruction(Op::PUSHW, { Operand::stack(MEM_STACK), Operand::reg(2) });
+            lines.instruction(Op::BLT,   { Operand::reg(1), Operand::reg(9), Operand::label("function_alloc_gs") });
+            lines.blank();
+            lines.instruction(Op::MOV, { Operand::reg(9), Operand::imm(ENDIAN::conditional_to_le_64(bytes_required)) }, "Bytes reqired for function (" + name + ")");
+            lines.instruction(Op::ADD, { Operand::reg(8), Operand::reg(8), Operand::reg(9) }, "Add function size to the stack pointer");
+            lines.instruction(Op::STW, { Operand::fixed(0, MEM_STACK), Operand::reg(8) }, "Increase the stack pointer");
 
             for(auto & p : params)
             {
-                std::stringstream ssp;
+                // Parameters given a register are read straight into it
+                int reg = registers.find(p.start_pos);
+                if(reg != Registers::NONE)
+                {
+                    lines.instruction(Op::LDW, { Operand::reg(1), Operand::fixed(p.param_gs_index, MEM_STACK) }, "Load parameters address");
+                    lines.instruction(Op::LDW, { Operand::reg(reg), Operand::addr(1, MEM_STACK) }, "Load parameter value into its register");
+                    continue;
+                }
 
-                std::vector<std::string> store_ins = load_64_into_r0(ENDIAN::conditional_to_le_64(p.start_pos), "Load relative parameter destination");
-                lines.insert(lines.end(), store_ins.begin(), store_ins.end());
+                load_64_into_r0(lines, ENDIAN::conditional_to_le_64(p.start_pos), "Load relative parameter destination");
 
-                ssp << NLT 
-                    << "ldw r1 $0(ls)" << TAB << "; Load stack pointer for this function" << NLT 
-                    << "add r0 r0 r1"  << TAB << "; Get absolute address for parameter copying" << NLT 
-                    << "ldw r1 $" << p.param_gs_index << "(gs)" << TAB << "; Load parameters address" << NLT;
+                lines.instruction(Op::LDW, { Operand::reg(1), Operand::fixed(0, CALC_STACK) }, "Load stack pointer for this function");
+                lines.instruction(Op::ADD, { Operand::reg(0), Operand::reg(0), Operand::reg(1) }, "Get absolute address for parameter copying");
+                lines.instruction(Op::LDW, { Operand::reg(1), Operand::fixed(p.param_gs_index, MEM_STACK) }, "Load parameters address");
 
-                
                 if(p.start_pos == p.end_pos - 1)
                 {
-                    ssp << "ldb r1 r1(gs)" << TAB << "; Load parameter value into r1" << NLT
-                        << "stb r0(gs) r1" << TAB << "; Store in local frame" << NL;
+                    lines.instruction(Op::LDB, { Operand::reg(1), Operand::addr(1, MEM_STACK) }, "Load parameter value into r1");
+                    lines.instruction(Op::STB, { Operand::addr(0, MEM_STACK), Operand::reg(1) }, "Store in local frame");
                 }
                 else
                 {
-                    ssp << "ldw r1 r1(gs)" << TAB << "; Load parameter value into r1" << NLT
-                        << "stw r0(gs) r1" << TAB << "; Store in local frame" << NL;
+                    lines.instruction(Op::LDW, { Operand::reg(1), Operand::addr(1, MEM_STACK) }, "Load parameter value into r1");
+                    lines.instruction(Op::STW, { Operand::addr(0, MEM_STACK), Operand::reg(1) }, "Store in local frame");
                 }
-                lines.push_back(ssp.str());
             }
 
-            // Add user given instruction block data
-            lines.insert(lines.end(), instructions.begin(), instructions.end());
+            // Link user given instruction block data
+            lines.link(std::move(instructions));
 
             // Add function term
-            lines.push_back(std::string(NL) + ">" + std::string(NL));
+            lines.directive(">");
 
-            instructions.clear();
             return lines;
         }
 
@@ -119,43 +122,71 @@ namespace
 
         void build_return(bool return_item = true)
         {
-            std::string dealloc_label = "function_dealloc_gs_" + std::to_string(LABEL_COUNTER++);
+            std::string dealloc_label = "function_dealloc_gs_" + std::to_string(labels.dealloc++);
+
+            instructions.blank();
+            instructions.comment("<<< RETURN >>>");
+
+            // Only slots holding a DS Address have anything to free, the rest of the frame holds values
+            for(auto & slot : ds_slots)
+            {
+                load_64_into_r0(instructions, slot, "Item start");
+
+                locate_in_frame(instructions);
+                instructions.blank();
+                instructions.instruction(Op::LDW,  { Operand::reg(0), Operand::addr(REG_ADDR_RO, MEM_STACK) }, "Load the DS Address from memory for dealloc");
+                instructions.instruction(Op::CALL, { Operand::label("__del__ds__free") });
+            }
+
             /*
                 The loop code for shrinking GS is not set to be configurable on purpose
             */
-            std::stringstream ss;
-            ss << NLT << "; <<< RETURN >>>" << NL
-               << NLT << "ldw" << WS << "r" << REG_ARITH_LHS << WS << "$0(" << CALC_STACK << ")" << TAB << "; Initial stack pointer"
-               << NLT << "ldw" << WS << "r" << REG_ARITH_RHS << WS << "$8(" << CALC_STACK << ")" << TAB << "; Function size (words)"
-               << NLT << "stw" << WS << "$0(gs)" << WS << "r" << REG_ARITH_LHS << TAB << "; Reset stack pointer" << NL
-               << NLT << "; Shrink GS to clean up current function" << NL 
-               << NLT << "mov r1 $0" << NL
-               << NL  << dealloc_label << ":"
-               << NLT << "add r1 r1 $1"
-               << NLT << "popw r0 gs"
-               << NL
-               << NLT << "; Free memory from DS Device - Developer note : This might cause some return issues later on"
-               << NLT << "call __del__ds__free"
-               << NLT << "blt r1 r9" << WS << dealloc_label << NL
-               << NL;
+            instructions.instruction(Op::LDW, { Operand::reg(REG_ARITH_LHS), Operand::fixed(0, CALC_STACK) }, "Initial stack pointer");
+            instructions.instruction(Op::LDW, { Operand::reg(REG_ARITH_RHS), Operand::fixed(8, CALC_STACK) }, "Function size (words)");
+            instructions.instruction(Op::STW, { Operand::fixed(0, MEM_STACK), Operand::reg(REG_ARITH_LHS) }, "Reset stack pointer");
+            instructions.blank();
+            instructions.comment("Shrink GS to clean up current function");
+            instructions.blank();
+            instructions.instruction(Op::MOV, { Operand::reg(1), Operand::imm(0) });
+            instructions.blank();
+            instructions.label(dealloc_label);
+            instructions.instruction(Op::ADD,  { Operand::reg(1), Operand::reg(1), Operand::imm(1) });
+            instructions.instruction(Op::POPW, { Operand::reg(0), Operand::stack(MEM_STACK) });
+            instructions.instruction(Op::BLT,  { Operand::reg(1), Operand::reg(9), Operand::label(dealloc_label) });
+            instructions.blank();
 
             if(return_item)
             {
-                ss << NLT
-                   << "; Get result for return"
-                   << NLT << "popw" << WS << "r" << REG_ADDR_RO << WS << CALC_STACK
-                   << NLT << "stw $" << SETTINGS::GS_INDEX_RETURN_SPACE << "(gs)" << WS << "r" << REG_ADDR_RO << NL << NL;
+                instructions.comment("Get result for return");
+                instructions.instruction(Op::POPW, { Operand::reg(REG_ADDR_RO), Operand::stack(CALC_STACK) });
+                instructions.instruction(Op::STW,  { Operand::fixed(SETTINGS::GS_INDEX_RETURN_SPACE, MEM_STACK), Operand::reg(REG_ADDR_RO) });
+                instructions.blank();
             }
 
-            ss << TAB << "ret" << NL;
+            instructions.instruction(Op::RET, {});
+        }
+
+        // ----------------------------------------
+        //
+        // ----------------------------------------
+
+        void build_return_register(int result)
+        {
+            // The return space isn't touched by the clean up, so the result can go there before it happens
+            instructions.blank();
+            instructions.comment("Result for return");
+            instructions.instruction(Op::STW, { Operand::fixed(SETTINGS::GS_INDEX_RETURN_SPACE, MEM_STACK), Operand::reg(result) });
 
-            instructions.push_back(ss.str());
+            build_return(false);
         }
 
     private:
         std::string name;                                   //! The name of the function
         std::vector<CODEGEN::TYPES::ParamInfo> params;      //! The parameter information given to the function
+        std::vector<uint64_t> ds_slots;                     //! Frame positions that hold a DS Address
         uint64_t bytes_required;                            //! How many bytes of stack space the function will take up
+        Labels & labels;                                    //! Label numbering for the function
+        const Registers & registers;                        //! Registers given to frame slots
     };
 }
 }
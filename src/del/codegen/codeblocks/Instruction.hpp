@@ -0,0 +1,201 @@
+#ifndef DEL_INSTRUCTION_HPP
+#define DEL_INSTRUCTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace DEL
+{
+namespace CODE
+{
+    //
+    //  Instructions of the ASM that code blocks generate
+    //
+    enum class Op
+    {
+        MOV, NOT,
+        ADD, SUB, MUL, DIV, LSH, RSH, AND, OR, XOR,
+        ADD_D, SUB_D, MUL_D, DIV_D,
+        PUSHW, POPW, SIZE,
+        LDW, LDB, STW, STB,
+        BEQ, BNE, BLT, BGT, BLTE, BGTE,
+        BEQ_D, BNE_D, BLT_D, BGT_D, BLTE_D, BGTE_D,
+        JMP, CALL, RET, EXIT,
+        OP_COUNT
+    };
+
+    //
+    //  The name of each instruction, and the role of each of its operands
+    //      d - Register written
+    //      r - Register or constant read
+    //      a - Address, its base register is read
+    //      s - Stack
+    //      l - Label
+    //
+    struct Form
+    {
+        const char * name;
+        const char * roles;
+    };
+
+    static constexpr Form FORMS[] = {
+        { "mov",  "dr"  }, { "not",  "dr"  },
+        { "add",  "drr" }, { "sub",  "drr" }, { "mul",  "drr" }, { "div",  "drr" },
+        { "lsh",  "drr" }, { "rsh",  "drr" }, { "and",  "drr" }, { "or",   "drr" }, { "xor",  "drr" },
+        { "add.d","drr" }, { "sub.d","drr" }, { "mul.d","drr" }, { "div.d","drr" },
+        { "pushw","sr"  }, { "popw", "ds"  }, { "size", "ds"  },
+        { "ldw",  "da"  }, { "ldb",  "da"  }, { "stw",  "ar"  }, { "stb",  "ar"  },
+        { "beq",  "rrl" }, { "bne",  "rrl" }, { "blt",  "rrl" }, { "bgt",  "rrl" }, { "blte",  "rrl" }, { "bgte",  "rrl" },
+        { "beq.d","rrl" }, { "bne.d","rrl" }, { "blt.d","rrl" }, { "bgt.d","rrl" }, { "blte.d","rrl" }, { "bgte.d","rrl" },
+        { "jmp",  "l"   }, { "call", "l"   }, { "ret",  ""    }, { "exit", ""    }
+    };
+
+    static_assert(sizeof(FORMS) / sizeof(FORMS[0]) == static_cast<std::size_t>(Op::OP_COUNT), "Every instruction needs a form");
+
+    inline const Form & form_of(Op op)
+    {
+        return FORMS[static_cast<std::size_t>(op)];
+    }
+
+    //  The double variant of an arithmetic or branch instruction
+    //
+    inline Op double_variant(Op op)
+    {
+        switch(op)
+        {
+            case Op::ADD:  return Op::ADD_D;
+            case Op::SUB:  return Op::SUB_D;
+            case Op::MUL:  return Op::MUL_D;
+            case Op::DIV:  return Op::DIV_D;
+            case Op::BEQ:  return Op::BEQ_D;
+            case Op::BNE:  return Op::BNE_D;
+            case Op::BLT:  return Op::BLT_D;
+            case Op::BGT:  return Op::BGT_D;
+            case Op::BLTE: return Op::BLTE_D;
+            case Op::BGTE: return Op::BGTE_D;
+            default:       return op;
+        }
+    }
+
+    enum class Stack
+    {
+        LS,
+        GS
+    };
+
+    //
+    //  An operand of an instruction
+    //
+    struct Operand
+    {
+        enum class Kind
+        {
+            REGISTER,   // rN
+            CONSTANT,   // $N
+            ADDRESS,    // rN(gs), or $N(gs) where the address is fixed
+            STACK,      // ls, gs
+            LABEL
+        };
+
+        static constexpr int NO_REGISTER = -1;
+
+        Kind        kind;
+        int         number;     // REGISTER, and the base of an ADDRESS. NO_REGISTER if the address is fixed
+        uint64_t    value;      // CONSTANT, and a fixed ADDRESS
+        Stack       segment;    // STACK, and the stack an ADDRESS is in
+        std::string name;       // LABEL
+
+        static Operand reg(int number)                      { return Operand{ Kind::REGISTER, number, 0, Stack::LS, "" }; }
+        static Operand imm(uint64_t value)                  { return Operand{ Kind::CONSTANT, NO_REGISTER, value, Stack::LS, "" }; }
+        static Operand addr(int base, Stack segment)        { return Operand{ Kind::ADDRESS, base, 0, segment, "" }; }
+        static Operand fixed(uint64_t value, Stack segment) { return Operand{ Kind::ADDRESS, NO_REGISTER, value, segment, "" }; }
+        static Operand stack(Stack segment)                 { return Operand{ Kind::STACK, NO_REGISTER, 0, segment, "" }; }
+        static Operand label(std::string name)              { return Operand{ Kind::LABEL, NO_REGISTER, 0, Stack::LS, std::move(name) }; }
+
+        bool operator==(const Operand & other) const
+        {
+            return kind == other.kind && number == other.number && value == other.value && segment == other.segment && name == other.name;
+        }
+
+        bool operator!=(const Operand & other) const
+        {
+            return !(*this == other);
+        }
+
+        //  Register read through the operand, either itself or the base of an address. NO_REGISTER if there isn't one
+        //
+        int register_used() const
+        {
+            return (kind == Kind::REGISTER || kind == Kind::ADDRESS) ? number : NO_REGISTER;
+        }
+
+        void write_to(std::string & out) const
+        {
+            const char * stack_name = (segment == Stack::LS) ? "ls" : "gs";
+            switch(kind)
+            {
+                case Kind::REGISTER: out += "r" + std::to_string(number); break;
+                case Kind::CONSTANT: out += "$" + std::to_string(value);  break;
+                case Kind::STACK:    out += stack_name;                   break;
+                case Kind::LABEL:    out += name;                         break;
+                case Kind::ADDRESS:
+                    out += (number == NO_REGISTER) ? "$" + std::to_string(value) : "r" + std::to_string(number);
+                    out += "(";
+                    out += stack_name;
+                    out += ")";
+                    break;
+            }
+        }
+    };
+
+    //
+    //  A line of generated ASM. Instructions are kept as their parts so the passes run over generated
+    //  code never have to read text back, the text is only made when the program is written out
+    //
+    struct Line
+    {
+        enum class Kind
+        {
+            INSTRUCTION,
+            LABEL,
+            COMMENT,
+            BLANK,
+            DIRECTIVE       // Function brackets, passed through as given
+        };
+
+        Kind kind;
+        Op op;                              // INSTRUCTION
+        std::vector<Operand> operands;      // INSTRUCTION
+        std::string text;                   // Comment of an INSTRUCTION, LABEL name, COMMENT, or DIRECTIVE
+
+        void write_to(std::string & out) const
+        {
+            switch(kind)
+            {
+                case Kind::INSTRUCTION:
+                    out += "\t";
+                    out += form_of(op).name;
+                    for(auto & o : operands)
+                    {
+                        out += " ";
+                        o.write_to(out);
+                    }
+                    if(!text.empty())
+                    {
+                        out += "\t; " + text;
+                    }
+                    break;
+                case Kind::LABEL:     out += text + ":";    break;
+                case Kind::COMMENT:   out += "\t; " + text; break;
+                case Kind::BLANK:                           break;
+                case Kind::DIRECTIVE: out += text;          break;
+            }
+            out += "\n";
+        }
+    };
+}
+}
+
+#endif
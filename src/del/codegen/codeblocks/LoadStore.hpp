@@ -2,70 +2,73 @@
 #define DEL_LOAD_STORE_BLOCKS_HPP
 
 #include "Codeblock.hpp"
+#include "Errors.hpp"
 
 namespace DEL
 {
 namespace CODE
 {
-namespace
-{
-    static uint64_t SUCCESS_LABEL_COUNTER = 0;
-}
-
     //
     //  Load
     //
     class Load : public Block
     {
     public:
-        Load(CODEGEN::TYPES::AddressValueInstruction * ins) : Block()
+        Load(CODEGEN::TYPES::AddressValueInstruction * ins, Labels & labels, const Registers & registers) : Block()
         {
-            std::string title_comment = "; <<< LOAD >>>";
+            code.blank();
+            code.comment("<<< LOAD >>>");
 
-            code.push_back(std::string(NLT) + title_comment + std::string(NL));
+            // Items given a register never touch the frame
+            int reg = registers.find(ins->value);
+            if(reg != Registers::NONE)
+            {
+                code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(reg) }, "Load the value from its register");
+                return;
+            }
 
             // Create move instruction
-            std::vector<std::string> store_ins = load_64_into_r0(ins->value, "Address of item in expression");
-            code.insert(code.end(), store_ins.begin(), store_ins.end());
+            load_64_into_r0(code, ins->value, "Address of item in expression");
 
-            std::stringstream ss;
+            code.blank();
+            locate_in_frame(code);
+            code.blank();
 
-            ss << NL << NLT
-               << "ldw" << WS << "r" << REG_ADDR_SP << WS << "$0(ls)" << TAB << "; Load SP into local stack" << NLT 
-               << "add" << WS << "r" << REG_ADDR_RO << WS << "r" << REG_ADDR_RO << WS << "r" << REG_ADDR_SP << TAB << "; Item location in function mem" << NL << NLT
-               << "ldw r3 r" << REG_ADDR_RO << "(gs)" << TAB << "; Load the DS Address" << NLT
-               << "pushw ls r3" << NL;
-
-            code.push_back(ss.str()); 
+            // Word sized items are held in the frame, so they are read directly
+            if(Memory::is_frame_resident(ins->bytes))
+            {
+                code.instruction(Op::LDW,   { Operand::reg(REG_ADDR_RO), Operand::addr(REG_ADDR_RO, MEM_STACK) }, "Load the value from the frame");
+                code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(REG_ADDR_RO) });
+                return;
+            }
 
-            store_ins.clear();
-            store_ins = load_64_into_r0(ins->bytes / SETTINGS::SYSTEM_WORD_SIZE_BYTES, "Bytes to load");
-            code.insert(code.end(), store_ins.begin(), store_ins.end());
+            code.instruction(Op::LDW,   { Operand::reg(3), Operand::addr(REG_ADDR_RO, MEM_STACK) }, "Load the DS Address");
+            code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(3) });
 
-            std::stringstream ss1;
+            load_64_into_r0(code, ins->bytes / SETTINGS::SYSTEM_WORD_SIZE_BYTES, "Bytes to load");
 
-            ss1 << NL << NLT
-                << "mov r1 r0" << TAB << "; Move the words to load to r1 for call" << NLT 
-                << "popw r0 ls"<< TAB << "; Pop the DS Address into r0 for call" << NL << NLT 
-                << "call __del__ds__load" << NL << NLT;
+            code.blank();
+            code.instruction(Op::MOV,  { Operand::reg(1), Operand::reg(0) }, "Move the words to load to r1 for call");
+            code.instruction(Op::POPW, { Operand::reg(0), Operand::stack(CALC_STACK) }, "Pop the DS Address into r0 for call");
+            code.blank();
+            code.instruction(Op::CALL, { Operand::label("__del__ds__load") });
+            code.blank();
 
-            std::string load_label = "load_success_label_" + std::to_string(SUCCESS_LABEL_COUNTER++);
+            std::string load_label = "load_success_label_" + std::to_string(labels.load_store++);
 
-            ss1 << "mov r1 $0" << TAB << "; Move 0 into r1 to check for success" << NLT
-                << "beq r0 r1" << WS  << load_label << NLT 
-                << "; Failure to load causes an EXIT" << NLT 
-                << "exit" << NL << NL
-                << load_label << ":" << NL << NLT
-                << "; Move loaded words off of the GS and into LS" << NL;
+            code.instruction(Op::MOV, { Operand::reg(1), Operand::imm(0) }, "Move 0 into r1 to check for success");
+            code.instruction(Op::BEQ, { Operand::reg(0), Operand::reg(1), Operand::label(load_label) });
+            code.comment("Failure to load causes an EXIT");
+            code.instruction(Op::EXIT, {});
+            code.blank();
+            code.label(load_label);
+            code.comment("Move loaded words off of the GS and into LS");
 
             for(int i = 0; i < ins->bytes / SETTINGS::SYSTEM_WORD_SIZE_BYTES; i++)
             {
-                ss1 << NLT
-                    << "popw r0 gs" << NLT
-                    << "pushw ls r0" << NL;
+                code.instruction(Op::POPW,  { Operand::reg(0), Operand::stack(MEM_STACK) });
+                code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(0) });
             }
-
-            code.push_back(ss1.str()); 
         }
     };
 
@@ -75,45 +78,72 @@ namespace
     class Store : public Block
     {
     public:
-        Store(uint64_t mem_start, uint64_t byte_len, std::string id) : Block()
+        //  The value is taken from the calc stack, or from value if it has already been worked out into a register
+        //
+        Store(uint64_t mem_start, uint64_t byte_len, std::string id, Labels & labels, const Registers & registers, int value = Registers::NONE) : Block()
         {
-            std::string title_comment = "; <<< STORE >>>";
             std::string address_comment = "Address for [ " + id + " ]";
 
-            code.push_back(std::string(NLT) + title_comment + std::string(NL));
+            code.blank();
+            code.comment("<<< STORE >>>");
+
+            int reg = registers.find(mem_start);
+            if(reg != Registers::NONE)
+            {
+                if(value != Registers::NONE)
+                {
+                    code.instruction(Op::MOV, { Operand::reg(reg), Operand::reg(value) }, "Store the value for [" + id + "] in its register");
+                }
+                else
+                {
+                    code.instruction(Op::POPW, { Operand::reg(reg), Operand::stack(CALC_STACK) }, "Store the value for [" + id + "] in its register");
+                }
+                return;
+            }
 
             // Create move instruction
-            std::vector<std::string> store_ins = load_64_into_r0(mem_start, address_comment);
-            code.insert(code.end(), store_ins.begin(), store_ins.end());
+            load_64_into_r0(code, mem_start, address_comment);
 
-            std::stringstream ss;
-            ss << NLT 
-               << "ldw"  << WS << "r" << REG_ADDR_SP << WS << "$0(ls)" << TAB << "; Load SP into local stack" << NLT 
-               << "add"  << WS << "r" << REG_ADDR_RO << WS << "r" << REG_ADDR_RO << WS << "r" << REG_ADDR_SP << TAB << "; Item location in function mem" << NL << NLT
-               << "ldw r0 r" << REG_ADDR_RO << "(gs)" << TAB << "; Load the DS Address from memory for [" << id << "] into r0 for call" << NLT
-               << "size r1 gs" << TAB << "; Get current size of GS into r1 for call" << NL << NLT
-               << "; Get words from local stack an put on gs for transit" << NL;
+            code.blank();
+            locate_in_frame(code);
+            code.blank();
 
-            for(int i = 0; i < byte_len / SETTINGS::SYSTEM_WORD_SIZE_BYTES; i++)
+            // Word sized items are held in the frame, so they are written directly
+            if(Memory::is_frame_resident(byte_len))
             {
-                ss << NLT
-                   << "popw r5" << WS << CALC_STACK << TAB << "; Get word from LS" << NLT 
-                   << "pushw gs r5" << TAB << "; Push to GS";
+                if(value == Registers::NONE)
+                {
+                    code.instruction(Op::POPW, { Operand::reg(5), Operand::stack(CALC_STACK) }, "Get word from LS");
+                    value = 5;
+                }
+                code.instruction(Op::STW, { Operand::addr(REG_ADDR_RO, MEM_STACK), Operand::reg(value) }, "Store the value for [" + id + "] in the frame");
+                return;
             }
 
-            std::string store_label = "store_success_label_" + std::to_string(SUCCESS_LABEL_COUNTER++);
-
-            ss << NL << NLT 
-               << "size r2 gs" << TAB << "; Get new size of GS into r2 for call" << NL << NLT
-               << "call __del__ds__store" << NL << NLT
-               << "mov r1 $0" << TAB << "; Move 0 into r1 to check for success" << NLT
-               << "beq r0 r1" << WS  << store_label << NLT 
-               << "; Failure to store causes an EXIT" << NLT 
-               << "exit" << NL << NL
-               << store_label << ":" << NL;
+            code.instruction(Op::LDW,  { Operand::reg(0), Operand::addr(REG_ADDR_RO, MEM_STACK) }, "Load the DS Address from memory for [" + id + "] into r0 for call");
+            code.instruction(Op::SIZE, { Operand::reg(1), Operand::stack(MEM_STACK) }, "Get current size of GS into r1 for call");
+            code.blank();
+            code.comment("Get words from local stack an put on gs for transit");
 
-            code.push_back(ss.str()); 
+            for(int i = 0; i < byte_len / SETTINGS::SYSTEM_WORD_SIZE_BYTES; i++)
+            {
+                code.instruction(Op::POPW,  { Operand::reg(5), Operand::stack(CALC_STACK) }, "Get word from LS");
+                code.instruction(Op::PUSHW, { Operand::stack(MEM_STACK), Operand::reg(5) }, "Push to GS");
+            }
 
+            std::string store_label = "store_success_label_" + std::to_string(labels.load_store++);
+
+            code.blank();
+            code.instruction(Op::SIZE, { Operand::reg(2), Operand::stack(MEM_STACK) }, "Get new size of GS into r2 for call");
+            code.blank();
+            code.instruction(Op::CALL, { Operand::label("__del__ds__store") });
+            code.blank();
+            code.instruction(Op::MOV, { Operand::reg(1), Operand::imm(0) }, "Move 0 into r1 to check for success");
+            code.instruction(Op::BEQ, { Operand::reg(0), Operand::reg(1), Operand::label(store_label) });
+            code.comment("Failure to store causes an EXIT");
+            code.instruction(Op::EXIT, {});
+            code.blank();
+            code.label(store_label);
         }
     };
 
@@ -125,29 +155,23 @@ namespace
     public:
         MoveAddress(CODEGEN::TYPES::MoveInstruction * ins) : Block()
         {
-            code.push_back(std::string(NLT) + "; <<< MOVE ADDRESS >>> " + std::string(NLT));
+            code.comment("<<< MOVE ADDRESS >>>");
 
-            std::vector<std::string> store_ins = load_64_into_r0(ins->source, "Address of item in expression");
-            code.insert(code.end(), store_ins.begin(), store_ins.end());
+            load_64_into_r0(code, ins->source, "Address of item in expression");
 
             // This should be filtered by now, but just in case.
             if(ins->destination > 4294967290)
             {
-                std::cerr << "CodeBlock::MoveAddress() : Given address greater than approx 2^32 - Not currently supported" << std::endl;
-                exit(EXIT_FAILURE);
+                throw InternalError("CodeBlock::MoveAddress()", "Given address greater than approx 2^32 - Not currently supported");
             }
 
-            std::stringstream ss;
-            ss << NLT 
-               << "ldw"  << WS << "r" << REG_ADDR_SP << WS << "$0(ls)" << TAB << "; Load SP into local stack" << NLT 
-               << "add"  << WS << "r" << REG_ADDR_RO << WS << "r" << REG_ADDR_RO << WS << "r" << REG_ADDR_SP << TAB << "; Item location in function mem" << NL << NLT
-               << "stw $"<< ins->destination << "(gs)" << WS << "r" << REG_ADDR_RO << TAB << "; Store address in gs location" << NL;
-
-            code.push_back(ss.str()); 
+            locate_in_frame(code);
+            code.blank();
+            code.instruction(Op::STW, { Operand::fixed(ins->destination, MEM_STACK), Operand::reg(REG_ADDR_RO) }, "Store address in gs location");
         }
     };
 
 }
 }
 
-#endif
\ No newline at end of file
+#endif
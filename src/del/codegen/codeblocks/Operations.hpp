@@ -13,25 +13,22 @@ namespace CODE
     class Conditional : public Block
     {
     public:
-        Conditional(uint64_t label_id, std::string comparison) : Block()
+        Conditional(uint64_t label_id, Op comparison) : Block()
         {
             std::string label = "conditional_check_" + std::to_string(label_id);
             std::string complete = "conditional_complete_" + std::to_string(label_id);
-            comparison = comparison + label;
 
-            std::stringstream ss;
-
-            ss << NLT 
-               << remove_for_calc << NL 
-               << comparison      << NL << NLT
-               << "mov" << WS << "r" << REG_CONDITIONAL << WS << "$0" << TAB << "; False" << NL << NLT
-               << "jmp" << WS << complete << NL << NL
-               << label << ":" << NL << NLT
-               << "mov" << WS << "r" << REG_CONDITIONAL << WS << "$1" << TAB << "; True" << NL << NL
-               << complete << ":" << NL << NLT
-               << "pushw" << WS << CALC_STACK << WS << "r" << REG_CONDITIONAL << TAB << "; Put result into calc stack" << NL;
-
-            code.push_back(ss.str());
+            remove_for_calc();
+            code.instruction(comparison, { Operand::reg(REG_ARITH_LHS), Operand::reg(REG_ARITH_RHS), Operand::label(label) });
+            code.blank();
+            code.instruction(Op::MOV, { Operand::reg(REG_CONDITIONAL), Operand::imm(0) }, "False");
+            code.instruction(Op::JMP, { Operand::label(complete) });
+            code.blank();
+            code.label(label);
+            code.instruction(Op::MOV, { Operand::reg(REG_CONDITIONAL), Operand::imm(1) }, "True");
+            code.blank();
+            code.label(complete);
+            code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(REG_CONDITIONAL) }, "Put result into calc stack");
         }
     };
 
@@ -43,15 +40,11 @@ namespace CODE
     public:
         Addition(CODEGEN::TYPES::DataClassification classification) : Block()
         {
-            std::string cmd = (is_double_variant(classification)) ? "add.d" : "add";
+            Op op = (is_double_variant(classification)) ? double_variant(Op::ADD) : Op::ADD;
 
-            std::stringstream ss; 
-            ss << NLT << "; <<< ADDITION >>> " << NL
-               << remove_for_calc
-               << NLT
-               << cmd << WS << calculate_and_store;
-
-            code.push_back(ss.str());
+            code.comment("<<< ADDITION >>>");
+            remove_for_calc();
+            calculate_and_store(op);
         }
     };
 
@@ -63,15 +56,11 @@ namespace CODE
     public:
         Subtraction(CODEGEN::TYPES::DataClassification classification) : Block()
         {
-            std::string cmd = (is_double_variant(classification)) ? "sub.d" : "sub";
-
-            std::stringstream ss; 
-            ss << NLT << "; <<< SUBTRACTION >>> " << NL
-               << remove_for_calc
-               << NLT
-               << cmd << WS << calculate_and_store;
+            Op op = (is_double_variant(classification)) ? double_variant(Op::SUB) : Op::SUB;
 
-            code.push_back(ss.str());
+            code.comment("<<< SUBTRACTION >>>");
+            remove_for_calc();
+            calculate_and_store(op);
         }
     };
 
@@ -83,15 +72,11 @@ namespace CODE
     public:
         Division(CODEGEN::TYPES::DataClassification classification) : Block()
         {
-            std::string cmd = (is_double_variant(classification)) ? "div.d" : "div";
+            Op op = (is_double_variant(classification)) ? double_variant(Op::DIV) : Op::DIV;
 
-            std::stringstream ss; 
-            ss << NLT << "; <<< DIVISION >>> " << NL
-               << remove_for_calc
-               << NLT
-               << cmd << WS << calculate_and_store;
-
-            code.push_back(ss.str());
+            code.comment("<<< DIVISION >>>");
+            remove_for_calc();
+            calculate_and_store(op);
         }
     };
 
@@ -103,15 +88,11 @@ namespace CODE
     public:
         Multiplication(CODEGEN::TYPES::DataClassification classification) : Block()
         {
-            std::string cmd = (is_double_variant(classification)) ? "mul.d" : "mul";
-
-            std::stringstream ss; 
-            ss << NLT << "; <<< MULTIPLICATION >>> " << NL
-               << remove_for_calc
-               << NLT
-               << cmd << WS << calculate_and_store;
+            Op op = (is_double_variant(classification)) ? double_variant(Op::MUL) : Op::MUL;
 
-            code.push_back(ss.str());
+            code.comment("<<< MULTIPLICATION >>>");
+            remove_for_calc();
+            calculate_and_store(op);
         }
     };
 
@@ -123,15 +104,9 @@ namespace CODE
     public:
         RightShift() : Block()
         {
-            std::string cmd = "rsh";
-
-            std::stringstream ss; 
-            ss << NLT << "; <<< RIGHT SHIFT >>> " << NL
-               << remove_for_calc
-               << NLT
-               << cmd << WS << calculate_and_store;
-
-            code.push_back(ss.str());
+            code.comment("<<< RIGHT SHIFT >>>");
+            remove_for_calc();
+            calculate_and_store(Op::RSH);
         }
     };
 
@@ -143,18 +118,12 @@ namespace CODE
     public:
         LeftShift() : Block()
         {
-            std::string cmd = "lsh";
-
-            std::stringstream ss; 
-            ss << NLT << "; <<< LEFT SHIFT >>> " << NL
-               << remove_for_calc
-               << NLT
-               << cmd << WS << calculate_and_store;
-
-            code.push_back(ss.str());
+            code.comment("<<< LEFT SHIFT >>>");
+            remove_for_calc();
+            calculate_and_store(Op::LSH);
         }
     };
-    
+
     //
     //      BW Or
     //
@@ -163,15 +132,9 @@ namespace CODE
     public:
         BwOr() : Block()
         {
-            std::string cmd = "or";
-
-            std::stringstream ss; 
-            ss << NLT << "; <<< BITWISE OR >>> " << NL
-               << remove_for_calc
-               << NLT
-               << cmd << WS << calculate_and_store;
-
-            code.push_back(ss.str());
+            code.comment("<<< BITWISE OR >>>");
+            remove_for_calc();
+            calculate_and_store(Op::OR);
         }
     };
 
@@ -183,15 +146,9 @@ namespace CODE
     public:
         BwNot() : Block(true)
         {
-            std::string cmd = "not";
-
-            std::stringstream ss; 
-            ss << NLT << "; <<< BITWISE NOT >>> " << NL
-               << remove_for_calc
-               << NLT
-               << cmd << WS << calculate_and_store;
-
-            code.push_back(ss.str());
+            code.comment("<<< BITWISE NOT >>>");
+            remove_for_calc();
+            calculate_and_store(Op::NOT);
         }
     };
 
@@ -203,18 +160,12 @@ namespace CODE
     public:
         BwXor() : Block()
         {
-            std::string cmd = "xor";
-
-            std::stringstream ss; 
-            ss << NLT << "; <<< BITWISE XOR >>> " << NL
-               << remove_for_calc
-               << NLT
-               << cmd << WS << calculate_and_store;
-
-            code.push_back(ss.str());
+            code.comment("<<< BITWISE XOR >>>");
+            remove_for_calc();
+            calculate_and_store(Op::XOR);
         }
     };
-    
+
     //
     //      BW And
     //
@@ -223,15 +174,9 @@ namespace CODE
     public:
         BwAnd() : Block()
         {
-            std::string cmd = "and";
-
-            std::stringstream ss; 
-            ss << NLT << "; <<< BITWISE AND >>> " << NL
-               << remove_for_calc
-               << NLT
-               << cmd << WS << calculate_and_store;
-
-            code.push_back(ss.str());
+            code.comment("<<< BITWISE AND >>>");
+            remove_for_calc();
+            calculate_and_store(Op::AND);
         }
     };
 
@@ -243,23 +188,13 @@ namespace CODE
     public: 
         Lte(uint64_t label_id, CODEGEN::TYPES::DataClassification classification) : Block()
         {
-            std::string cmd = (is_double_variant(classification)) ? "blte.d" : "blte";
+            Op comparison = (is_double_variant(classification)) ? double_variant(Op::BLTE) : Op::BLTE;
 
-            std::stringstream sscmd;
-            sscmd << TAB << cmd << WS << "r" << REG_ARITH_LHS << WS << "r" << REG_ARITH_RHS << WS;
+            code.comment("<<< LTE >>>");
 
-            std::stringstream ss;
-            ss << NLT << "; <<< LTE >>>" << NL;
+            Conditional c(label_id, comparison);
 
-            code.push_back(ss.str());
-
-            Conditional * c = new Conditional(label_id, sscmd.str());
-
-            std::vector<std::string> ccode = c->get_code();
-
-            code.insert(code.end(), ccode.begin(), ccode.end());
-
-            delete c;
+            code.append(c.take_code());
         }
     };
 
@@ -271,26 +206,16 @@ namespace CODE
     public: 
         Lt(uint64_t label_id, CODEGEN::TYPES::DataClassification classification) : Block()
         {
-            std::string cmd = (is_double_variant(classification)) ? "blt.d" : "blt";
-
-            std::stringstream sscmd;
-            sscmd << TAB << cmd << WS << "r" << REG_ARITH_LHS << WS << "r" << REG_ARITH_RHS << WS;
-
-            std::stringstream ss;
-            ss << NLT << "; <<< LT >>>" << NL;
+            Op comparison = (is_double_variant(classification)) ? double_variant(Op::BLT) : Op::BLT;
 
-            code.push_back(ss.str());
+            code.comment("<<< LT >>>");
 
-            Conditional * c = new Conditional(label_id, sscmd.str());
+            Conditional c(label_id, comparison);
 
-            std::vector<std::string> ccode = c->get_code();
-
-            code.insert(code.end(), ccode.begin(), ccode.end());
-
-            delete c;
+            code.append(c.take_code());
         }
     };
-    
+
     //
     //  GTE
     //
@@ -299,26 +224,16 @@ namespace CODE
     public: 
         Gte(uint64_t label_id, CODEGEN::TYPES::DataClassification classification) : Block()
         {
-            std::string cmd = (is_double_variant(classification)) ? "bgte.d" : "bgte";
-
-            std::stringstream sscmd;
-            sscmd << TAB << cmd << WS << "r" << REG_ARITH_LHS << WS << "r" << REG_ARITH_RHS << WS;
-
-            std::stringstream ss;
-            ss << NLT << "; <<< GTE >>>" << NL;
-
-            code.push_back(ss.str());
-
-            Conditional * c = new Conditional(label_id, sscmd.str());
+            Op comparison = (is_double_variant(classification)) ? double_variant(Op::BGTE) : Op::BGTE;
 
-            std::vector<std::string> ccode = c->get_code();
+            code.comment("<<< GTE >>>");
 
-            code.insert(code.end(), ccode.begin(), ccode.end());
+            Conditional c(label_id, comparison);
 
-            delete c;
+            code.append(c.take_code());
         }
     };
-    
+
     //
     //  GT
     //
@@ -327,26 +242,16 @@ namespace CODE
     public: 
         Gt(uint64_t label_id, CODEGEN::TYPES::DataClassification classification) : Block()
         {
-            std::string cmd = (is_double_variant(classification)) ? "bgt.d" : "bgt";
-
-            std::stringstream sscmd;
-            sscmd << TAB << cmd << WS << "r" << REG_ARITH_LHS << WS << "r" << REG_ARITH_RHS << WS;
-
-            std::stringstream ss;
-            ss << NLT << "; <<< GT >>>" << NL;
+            Op comparison = (is_double_variant(classification)) ? double_variant(Op::BGT) : Op::BGT;
 
-            code.push_back(ss.str());
+            code.comment("<<< GT >>>");
 
-            Conditional * c = new Conditional(label_id, sscmd.str());
+            Conditional c(label_id, comparison);
 
-            std::vector<std::string> ccode = c->get_code();
-
-            code.insert(code.end(), ccode.begin(), ccode.end());
-
-            delete c;
+            code.append(c.take_code());
         }
     };
-    
+
     //
     //  EQ
     //
@@ -355,26 +260,16 @@ namespace CODE
     public: 
         Eq(uint64_t label_id, CODEGEN::TYPES::DataClassification classification) : Block()
         {
-            std::string cmd = (is_double_variant(classification)) ? "beq.d" : "beq";
+            Op comparison = (is_double_variant(classification)) ? double_variant(Op::BEQ) : Op::BEQ;
 
-            std::stringstream sscmd;
-            sscmd << TAB << cmd << WS << "r" << REG_ARITH_LHS << WS << "r" << REG_ARITH_RHS << WS;
+            code.comment("<<< EQ >>>");
 
-            std::stringstream ss;
-            ss << NLT << "; <<< EQ >>>" << NL;
+            Conditional c(label_id, comparison);
 
-            code.push_back(ss.str());
-
-            Conditional * c = new Conditional(label_id, sscmd.str());
-
-            std::vector<std::string> ccode = c->get_code();
-
-            code.insert(code.end(), ccode.begin(), ccode.end());
-
-            delete c;
+            code.append(c.take_code());
         }
     };
-    
+
     //
     //  NEQ
     //
@@ -383,23 +278,13 @@ namespace CODE
     public: 
         Neq(uint64_t label_id, CODEGEN::TYPES::DataClassification classification) : Block()
         {
-            std::string cmd = (is_double_variant(classification)) ? "bne.d" : "bne";
-
-            std::stringstream sscmd;
-            sscmd << TAB << cmd << WS << "r" << REG_ARITH_LHS << WS << "r" << REG_ARITH_RHS << WS;
+            Op comparison = (is_double_variant(classification)) ? double_variant(Op::BNE) : Op::BNE;
 
-            std::stringstream ss;
-            ss << NLT << "; <<< NEQ >>>" << NL;
+            code.comment("<<< NEQ >>>");
 
-            code.push_back(ss.str());
+            Conditional c(label_id, comparison);
 
-            Conditional * c = new Conditional(label_id, sscmd.str());
-
-            std::vector<std::string> ccode = c->get_code();
-
-            code.insert(code.end(), ccode.begin(), ccode.end());
-
-            delete c;
+            code.append(c.take_code());
         }
     };
 
@@ -413,22 +298,22 @@ namespace CODE
         {
             std::string true_label = "OR_is_true_"    + std::to_string(label_id);
             std::string complete   = "OR_is_complete_" + std::to_string(label_id);
-            std::string comparison = (is_double_variant(classification)) ? "bgt.d" : "bgt";
-
-            std::stringstream ss;
-            ss << NLT << "; <<< OR >>>" << NL
-               << remove_for_calc << NL << NLT
-               << "mov" << WS << "r" << REG_COMPARISON << WS << "$0" << TAB << "; Comparison Value" << NL << NLT
-               << comparison << WS << "r" << REG_ARITH_LHS << WS << "r" << REG_COMPARISON << WS << true_label << NL << NLT
-               << comparison << WS << "r" << REG_ARITH_RHS << WS << "r" << REG_COMPARISON << WS << true_label << NL << NLT
-               << "mov" << WS << "r" << REG_ARITH_LHS << WS << "$0" << TAB << "; False" << NL << NLT
-               << "jmp" << WS << complete << NL << NL
-               << true_label << ":" << NL << NLT
-               << "mov" << WS << "r" << REG_ARITH_LHS << WS << "$1" << TAB << "; True" << NL << NL
-               << complete << ":" << NL << NLT
-               << "pushw" << WS << CALC_STACK << WS << "r" << REG_ARITH_LHS << TAB << "; Put result in calc stack" << NL;
-
-            code.push_back(ss.str());
+            Op comparison = (is_double_variant(classification)) ? Op::BGT_D : Op::BGT;
+
+            code.comment("<<< OR >>>");
+            remove_for_calc();
+            code.blank();
+            code.instruction(Op::MOV, { Operand::reg(REG_COMPARISON), Operand::imm(0) }, "Comparison Value");
+            code.instruction(comparison, { Operand::reg(REG_ARITH_LHS), Operand::reg(REG_COMPARISON), Operand::label(true_label) });
+            code.instruction(comparison, { Operand::reg(REG_ARITH_RHS), Operand::reg(REG_COMPARISON), Operand::label(true_label) });
+            code.instruction(Op::MOV, { Operand::reg(REG_ARITH_LHS), Operand::imm(0) }, "False");
+            code.instruction(Op::JMP, { Operand::label(complete) });
+            code.blank();
+            code.label(true_label);
+            code.instruction(Op::MOV, { Operand::reg(REG_ARITH_LHS), Operand::imm(1) }, "True");
+            code.blank();
+            code.label(complete);
+            code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(REG_ARITH_LHS) }, "Put result in calc stack");
         }
     };
 
@@ -444,35 +329,36 @@ namespace CODE
             std::string first_true  = "AND_first_true_" + std::to_string(label_id);
             std::string second_true = "AND_second_true_" + std::to_string(label_id);
             std::string complete    = "AND_complete_" + std::to_string(label_id);
-            std::string comparison = (is_double_variant(classification)) ? "bgt.d" : "bgt";
-
-            std::stringstream ss;
-            ss << NLT << "; <<< AND >>> " << NL 
-               << remove_for_calc << NL << NLT 
-
-               // Load comparison value
-               << "mov" << WS << "r" << REG_COMPARISON << WS << "$0" << TAB << "; Comparison value" << NL << NLT
-               
-               // Check the lhs
-               << comparison << WS << "r" << REG_ARITH_LHS << WS << "r" << REG_COMPARISON << WS << first_true << NL << NLT
-               << "mov" << WS << "r" << REG_ARITH_LHS << WS << "$0" << TAB << "; False" << NL << NLT
-               << "jmp" << WS << complete << NL << NL
-
-               // Check the rhs
-               << first_true << ":" << NL << NLT
-               << comparison << WS << "r" << REG_ARITH_RHS << WS << "r" << REG_COMPARISON << WS << second_true << NL << NLT
-               << "mov" << WS << "r" << REG_ARITH_LHS << WS << "$0" << TAB << "; False" << NL << NLT
-               << "jmp" << WS << complete << NL << NL
-
-               // Both were true, mark true
-               << second_true << ":" << NL << NLT
-               << "mov" << WS << "r" << REG_ARITH_LHS << WS << "$1" << TAB << "; True" << NL << NL 
-               
-               // Complete the check
-               << complete << ":" << NL << NLT
-               << "pushw"  << WS  << CALC_STACK << WS << "r" << REG_ARITH_LHS << TAB << "; Put result into calc stack" << NL;
-            
-            code.push_back(ss.str());
+            Op comparison = (is_double_variant(classification)) ? Op::BGT_D : Op::BGT;
+
+            code.comment("<<< AND >>>");
+            remove_for_calc();
+            code.blank();
+
+            // Load comparison value
+            code.instruction(Op::MOV, { Operand::reg(REG_COMPARISON), Operand::imm(0) }, "Comparison value");
+
+            // Check the lhs
+            code.instruction(comparison, { Operand::reg(REG_ARITH_LHS), Operand::reg(REG_COMPARISON), Operand::label(first_true) });
+            code.instruction(Op::MOV, { Operand::reg(REG_ARITH_LHS), Operand::imm(0) }, "False");
+            code.instruction(Op::JMP, { Operand::label(complete) });
+            code.blank();
+
+            // Check the rhs
+            code.label(first_true);
+            code.instruction(comparison, { Operand::reg(REG_ARITH_RHS), Operand::reg(REG_COMPARISON), Operand::label(second_true) });
+            code.instruction(Op::MOV, { Operand::reg(REG_ARITH_LHS), Operand::imm(0) }, "False");
+            code.instruction(Op::JMP, { Operand::label(complete) });
+            code.blank();
+
+            // Both were true, mark true
+            code.label(second_true);
+            code.instruction(Op::MOV, { Operand::reg(REG_ARITH_LHS), Operand::imm(1) }, "True");
+            code.blank();
+
+            // Complete the check
+            code.label(complete);
+            code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(REG_ARITH_LHS) }, "Put result into calc stack");
         }
     };
 
@@ -486,21 +372,21 @@ namespace CODE
         {
             std::string set_zero = "NEGATE_set_zero_" + std::to_string(label_id);
             std::string set_comp = "NEGATE_complete_" + std::to_string(label_id);
-            std::string comparison = (is_double_variant(classification)) ? "bgt.d" : "bgt";
-
-            std::stringstream ss;
-            ss << NLT << "; <<< NEGATE >>>" << NL
-               << remove_for_calc << NL << NLT
-               << "mov" << WS << "r" << REG_COMPARISON << WS << "$0" << TAB << "; Comparison" << NL << NLT
-               << comparison << WS << "r" << REG_ARITH_LHS << WS << "r" << REG_COMPARISON << WS << set_zero << NL << NLT
-               << "mov" << WS << "r" << REG_ARITH_LHS << WS << "$1" << NLT
-               << "jmp" << WS << set_comp << NL << NL
-               << set_zero << ":" << NLT
-               << "mov" << WS << "r" << REG_ARITH_LHS << WS << "$0" << NL << NL 
-               << set_comp << ":" << NLT
-               << "pushw" << WS << CALC_STACK << WS << "r" << REG_ARITH_LHS << TAB << "; Push result into calcl stack" << NL;
-
-            code.push_back(ss.str());
+            Op comparison = (is_double_variant(classification)) ? Op::BGT_D : Op::BGT;
+
+            code.comment("<<< NEGATE >>>");
+            remove_for_calc();
+            code.blank();
+            code.instruction(Op::MOV, { Operand::reg(REG_COMPARISON), Operand::imm(0) }, "Comparison");
+            code.instruction(comparison, { Operand::reg(REG_ARITH_LHS), Operand::reg(REG_COMPARISON), Operand::label(set_zero) });
+            code.instruction(Op::MOV, { Operand::reg(REG_ARITH_LHS), Operand::imm(1) });
+            code.instruction(Op::JMP, { Operand::label(set_comp) });
+            code.blank();
+            code.label(set_zero);
+            code.instruction(Op::MOV, { Operand::reg(REG_ARITH_LHS), Operand::imm(0) });
+            code.blank();
+            code.label(set_comp);
+            code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(REG_ARITH_LHS) }, "Push result into calcl stack");
         }
     };
 
@@ -512,15 +398,11 @@ namespace CODE
     public: 
         BuiltIn(std::string title_comment, std::string function_name) : Block()
         {
-            std::stringstream ss;
-
-            ss << NLT
-               << "; <<< " << title_comment << " >>> "    << NL << NLT
-               << bif_remove_for_calc << NL << NLT 
-               << "call"  << WS << function_name << TAB << "; Call built-in function " + title_comment << NL << NLT
-               << "pushw" << WS << CALC_STACK << WS << "r" << REG_ADDR_RO << TAB << "; Push value on calc stack" << NL;
-
-            code.push_back(ss.str()); 
+            code.comment("<<< " + title_comment + " >>>");
+            bif_remove_for_calc();
+            code.blank();
+            code.instruction(Op::CALL,  { Operand::label(function_name) }, "Call built-in function " + title_comment);
+            code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(REG_ADDR_RO) }, "Push value on calc stack");
         }
     };
 
@@ -532,24 +414,20 @@ namespace CODE
     public:
         Call(CODEGEN::TYPES::CallInstruction * ins) : Block()
         {
-            std::stringstream ss;
-            ss << NLT 
-               << "; <<< CALL >>> " << NL << NLT
-               << "call" << WS << ins->function_name << TAB << "; Call function" << NL;
+            code.comment("<<< CALL >>>");
+            code.instruction(Op::CALL, { Operand::label(ins->function_name) }, "Call function");
 
             if(ins->expect_return_value)
             {
-                ss << NLT
-                   << "; Get result from call " << NL << NLT
-                   << "ldw" << WS << "r" << REG_ADDR_RO << WS << "$" << SETTINGS::GS_INDEX_RETURN_SPACE << "(gs)" << NLT
-                   << "pushw" << WS << CALC_STACK << WS << "r" << REG_ADDR_RO << TAB << "; Push result to calculation stack" << NL;
+                code.blank();
+                code.comment("Get result from call");
+                code.instruction(Op::LDW,   { Operand::reg(REG_ADDR_RO), Operand::fixed(SETTINGS::GS_INDEX_RETURN_SPACE, MEM_STACK) });
+                code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(REG_ADDR_RO) }, "Push result to calculation stack");
             }
-
-            code.push_back(ss.str()); 
         }
     };
 }
 }
 
 
-#endif 
\ No newline at end of file
+#endif
\ No newline at end of file
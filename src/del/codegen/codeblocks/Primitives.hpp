@@ -3,6 +3,7 @@
 
 #include "Codeblock.hpp"
 #include "SystemSettings.hpp"
+#include "Errors.hpp"
 
 #include <iostream>
 
@@ -22,22 +23,18 @@ namespace CODE
             //
             if(SETTINGS::SYSTEM_WORD_SIZE_BYTES != ins->byte_len)
             {
-                std::cerr << "Developer Error : SetupPrimitive::SetupPrimitive() received a primitive that was not WORD sized" << std::endl;
-                exit(EXIT_FAILURE);
+                throw InternalError("CODE::SetupPrimitive", "Developer Error : SetupPrimitive::SetupPrimitive() received a primitive that was not WORD sized");
             }
 
-            std::stringstream ss;
-
-            code.push_back(std::string(NL) + std::string(NLT) + "; <<< SETUP PRIMITIVE VARIABLE >>> " + std::string(NL));
+            code.blank();
+            code.blank();
+            code.comment("<<< SETUP PRIMITIVE VARIABLE >>>");
 
             // Build the value into r0
-            std::vector<std::string> store_ins = load_64_into_r0(ins->value, id);
-            code.insert(code.end(), store_ins.begin(), store_ins.end());     
-
-            ss << NLT << "; ---- Move the value ----" << NLT
-                << "pushw" << WS << CALC_STACK << WS << "r" << REG_ADDR_RO << TAB << "; Place on calc stack" << NL;
+            load_64_into_r0(code, ins->value, id);
 
-            code.push_back(ss.str()); 
+            code.comment("---- Move the value ----");
+            code.instruction(Op::PUSHW, { Operand::stack(CALC_STACK), Operand::reg(REG_ADDR_RO) }, "Place on calc stack");
         }
     };
 }
@@ -9,30 +9,19 @@ namespace DEL
 {
 namespace CODE
 {
-namespace 
-{
-    // This increases over the lifespan of the program. Hopefully people 
-    // dont end up making 2^64-1 loops. 
-    static uint64_t WHILE_LOOP_CONTEXT = 0;
-}
-
     //! \brief A loop context aggregator that builds instructions
     class WhileLoopContext : public BlockAggregator
     {
     public:
-        WhileLoopContext(CODEGEN::TYPES::WhileInitiation * loop_init) : loop_info(loop_init)
+        WhileLoopContext(CODEGEN::TYPES::WhileInitiation * loop_init, Labels & labels, const Registers & registers) : loop_info(loop_init), labels(labels), registers(registers)
         {
-            loop_label = "while_loop_context_" + std::to_string(WHILE_LOOP_CONTEXT);
-            end_of_loop_label = "while_loop_end_" + std::to_string(WHILE_LOOP_CONTEXT++);
+            loop_label = "while_loop_context_" + std::to_string(labels.while_loop);
+            end_of_loop_label = "while_loop_end_" + std::to_string(labels.while_loop++);
 
             // Add top loop label
-            {
-                std::stringstream ss;
-                ss << NLT 
-                << "; <<< WHILE LOOP >>>" << NL << NL
-                << loop_label << ":";
-                instructions.push_back(ss.str());
-            }
+            instructions.comment("<<< WHILE LOOP >>>");
+            instructions.blank();
+            instructions.label(loop_label);
 
             // Load conditional variable 
             {
@@ -41,72 +30,50 @@ namespace
                     loop_info->condition.bytes_requested
                     );
 
-                CODE::Load * load_ins = new CODE::Load(loader);
+                CODE::Load * load_ins = new CODE::Load(loader, labels, registers);
 
-                // Get the generated code
-                std::vector<std::string> li = load_ins->get_code();
+                // Add load code
+                instructions.append(load_ins->take_code());
                 delete load_ins;
                 delete loader;
-
-                instructions.insert(instructions.end(), li.begin(), li.end());
             }
 
             // Check if we need to jump to bottom
             {
-                std::stringstream ss;
-
-                if(loop_info->classification == CODEGEN::TYPES::DataClassification::INTEGER)
-                {
-                    ss << NLT 
-                        << "popw r0 ls"  << TAB   << "; Load value of check into r0" << NLT
-                        << "mov  r1 $1"  << TAB   << "; Comparison value" << NLT
-                        << "bne  r0 r1 " << end_of_loop_label << TAB << "; Branch if true" <<  NL;
-                }
-                else
-                {
-                    ss << NLT 
-                        << "popw  r0 ls"  << TAB   << "; Load value of check into r0" << NLT
-                        << "mov   r1 $1"  << TAB   << "; Comparison value" << NLT
-                        << "bne.d r0 r1 " << end_of_loop_label << TAB << "; Branch if true" <<  NL;
-                }
-                instructions.push_back(ss.str());
+                Op branch = (loop_info->classification == CODEGEN::TYPES::DataClassification::INTEGER) ? Op::BNE : Op::BNE_D;
+
+                instructions.instruction(Op::POPW, { Operand::reg(0), Operand::stack(CALC_STACK) }, "Load value of check into r0");
+                instructions.instruction(Op::MOV,  { Operand::reg(1), Operand::imm(1) }, "Comparison value");
+                instructions.instruction(branch,   { Operand::reg(0), Operand::reg(1), Operand::label(end_of_loop_label) }, "Branch if true");
             }
         }
 
-        //! \brief Export the aggregated instructions as a block
-        //!        so it can be stored into another aggregator
-        Block * export_as_block()
+        //! \brief Export the aggregated instructions as a buffer
+        //!        so it can be linked into another aggregator
+        Buffer export_as_buffer()
         {
             // Add memory cleanup
-            instructions.push_back(std::string(NLT) + "; Dealloc items alloced in loop" + std::string(NL));
+            instructions.comment("Dealloc items alloced in loop");
 
             // Dealloc any new items in the loop
             while(!allocs.empty())
             {
-                std::vector<std::string> addr_ins = load_64_into_r0(allocs.top().start_pos, 
-                                                                    "Item start");
-                instructions.insert(instructions.end(), addr_ins.begin(), addr_ins.end());
-
-                std::stringstream ss;
-                ss << NLT 
-                << "ldw"  << WS << "r" << REG_ADDR_SP << WS << "$0(ls)" << TAB << "; Load SP into local stack" << NLT 
-                << "add"  << WS << "r" << REG_ADDR_RO << WS << "r" << REG_ADDR_RO << WS << "r" << REG_ADDR_SP << TAB << "; Item location in function mem" << NL << NLT
-                << "ldw r0 r" << REG_ADDR_RO << "(gs)" << TAB << "; Load the DS Address from memory for dealloc" << NLT
-                << "call __del__ds__free" << NL;
-
-                instructions.push_back(ss.str());
+                load_64_into_r0(instructions, allocs.top().start_pos, "Item start");
+
+                locate_in_frame(instructions);
+                instructions.blank();
+                instructions.instruction(Op::LDW,  { Operand::reg(0), Operand::addr(REG_ADDR_RO, MEM_STACK) }, "Load the DS Address from memory for dealloc");
+                instructions.instruction(Op::CALL, { Operand::label("__del__ds__free") });
+
                 allocs.pop();
             }
 
             // Add jump to top of loop and bottom label to escape loop
-            {
-                std::stringstream ss;
-                ss << NLT
-                   << "jmp" << WS << loop_label << TAB << "; Jump to top of loop" << NL << NL
-                   << end_of_loop_label << ":" << NL;
-                instructions.push_back(ss.str());
-            }
-            return new Export(instructions);
+            instructions.instruction(Op::JMP, { Operand::label(loop_label) }, "Jump to top of loop");
+            instructions.blank();
+            instructions.label(end_of_loop_label);
+
+            return std::move(instructions);
         }
 
     private:
@@ -114,16 +81,8 @@ namespace
         std::string loop_label;
         std::string end_of_loop_label;
         CODEGEN::TYPES::WhileInitiation * loop_info;
-
-        // Class to export the context as a block
-        class Export : public Block
-        {
-        public:
-            Export(std::vector<std::string> ins) : Block()
-            {
-                code.insert(code.end(), ins.begin(), ins.end());
-            } 
-        };
+        Labels & labels;
+        const Registers & registers;
     };
 
 }
@@ -19,22 +19,29 @@ set(DEL_INCLUDE_DIRS
     ${DEL_COMPILER_DIR}/managers
     ${DEL_COMPILER_DIR}/preprocessor
     ${DEL_COMPILER_DIR}/semantics
+    ${DEL_COMPILER_DIR}/system
     ${FLEX_INCLUDE_DIRS}
 )
 
 set(DEL_COMPILER_HEADERS
     ${DEL_COMPILER_DIR}
+    ${DEL_COMPILER_DIR}/ast/Arena.hpp
     ${DEL_COMPILER_DIR}/ast/Ast.hpp
     ${DEL_COMPILER_DIR}/ast/Types.hpp
 
     ${DEL_COMPILER_DIR}/codegen/Codegen.hpp
     ${DEL_COMPILER_DIR}/codegen/Generator.hpp
+    ${DEL_COMPILER_DIR}/codegen/Lowering.hpp
+    ${DEL_COMPILER_DIR}/codegen/Peephole.hpp
+    ${DEL_COMPILER_DIR}/codegen/RegisterAllocator.hpp
     ${DEL_COMPILER_DIR}/codegen/asm/AsmMath.hpp
     ${DEL_COMPILER_DIR}/codegen/asm/AsmStoreLoad.hpp
     ${DEL_COMPILER_DIR}/codegen/asm/AsmSupport.hpp
     ${DEL_COMPILER_DIR}/codegen/codeblocks/Alloc.hpp
     ${DEL_COMPILER_DIR}/codegen/codeblocks/BlockAggregator.hpp
+    ${DEL_COMPILER_DIR}/codegen/codeblocks/Buffer.hpp
     ${DEL_COMPILER_DIR}/codegen/codeblocks/Codeblock.hpp
+    ${DEL_COMPILER_DIR}/codegen/codeblocks/Expression.hpp
     ${DEL_COMPILER_DIR}/codegen/codeblocks/ConditionalContext.hpp
     ${DEL_COMPILER_DIR}/codegen/codeblocks/ForLoopContext.hpp
     ${DEL_COMPILER_DIR}/codegen/codeblocks/Function.hpp
@@ -46,39 +53,57 @@ set(DEL_COMPILER_HEADERS
     ${DEL_COMPILER_DIR}/intermediate/IntermediateTypes.hpp
 
     ${DEL_COMPILER_DIR}/managers/Errors.hpp
+    ${DEL_COMPILER_DIR}/managers/Interner.hpp
     ${DEL_COMPILER_DIR}/managers/Memory.hpp
     ${DEL_COMPILER_DIR}/managers/SymbolTable.hpp
 
+    ${DEL_COMPILER_DIR}/preprocessor/IncludeResolver.hpp
+    ${DEL_COMPILER_DIR}/preprocessor/MappedFile.hpp
     ${DEL_COMPILER_DIR}/preprocessor/Preprocessor.hpp
 
     ${DEL_COMPILER_DIR}/semantics/Analyzer.hpp
-    ${DEL_COMPILER_DIR}/semantics/EnDecode.hpp
+
+    ${DEL_COMPILER_DIR}/system/JobPool.hpp
+    ${DEL_COMPILER_DIR}/system/OutputFile.hpp
+    ${DEL_COMPILER_DIR}/system/WorkPool.hpp
 
     ${DEL_COMPILER_DIR}/del_driver.hpp
+    ${DEL_COMPILER_DIR}/del_server.hpp
     ${DEL_COMPILER_DIR}/del_scanner.hpp
 
     ${DEL_COMPILER_DIR}/SystemSettings.hpp
 )
 
 set(DEL_COMPILER_SOURCES
+    ${DEL_COMPILER_DIR}/ast/Arena.cpp
     ${DEL_COMPILER_DIR}/ast/Ast.cpp
 
     ${DEL_COMPILER_DIR}/codegen/Codegen.cpp
     ${DEL_COMPILER_DIR}/codegen/Generator.cpp
+    ${DEL_COMPILER_DIR}/codegen/Lowering.cpp
+    ${DEL_COMPILER_DIR}/codegen/Peephole.cpp
+    ${DEL_COMPILER_DIR}/codegen/RegisterAllocator.cpp
     ${DEL_COMPILER_DIR}/codegen/asm/AsmSupport.cpp
 
     ${DEL_COMPILER_DIR}/intermediate/Intermediate.cpp
 
     ${DEL_COMPILER_DIR}/managers/Errors.cpp
+    ${DEL_COMPILER_DIR}/managers/Interner.cpp
     ${DEL_COMPILER_DIR}/managers/SymbolTable.cpp
     ${DEL_COMPILER_DIR}/managers/Memory.cpp
 
+    ${DEL_COMPILER_DIR}/preprocessor/IncludeResolver.cpp
+    ${DEL_COMPILER_DIR}/preprocessor/MappedFile.cpp
     ${DEL_COMPILER_DIR}/preprocessor/Preprocessor.cpp
 
     ${DEL_COMPILER_DIR}/semantics/Analyzer.cpp
-    ${DEL_COMPILER_DIR}/semantics/EnDecode.cpp
+
+    ${DEL_COMPILER_DIR}/system/JobPool.cpp
+    ${DEL_COMPILER_DIR}/system/OutputFile.cpp
+    ${DEL_COMPILER_DIR}/system/WorkPool.cpp
 
     ${DEL_COMPILER_DIR}/del_driver.cpp
+    ${DEL_COMPILER_DIR}/del_server.cpp
     
     ${FLEX_del_lexer_OUTPUTS}
     ${BISON_del_parser_OUTPUTS}
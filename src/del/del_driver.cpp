@@ -1,20 +1,40 @@
+#include <atomic>
 #include <cctype>
-#include <fstream>
 #include <cassert>
 #include <iostream>
 #include <string>
+#include <filesystem>
+#include <mutex>
+#include <unistd.h>
 #include <libnabla/assembler.hpp>
 #include "del_driver.hpp"
+#include "OutputFile.hpp"
 
 namespace DEL
 {
-   DEL_Driver::DEL_Driver() : error_man(*this), 
+namespace
+{
+   // Scratch files of compilations running at the same time in the process must not collide
+   std::atomic<uint64_t> SCRATCH_COUNTER(0);
+
+   // The libnabla assembler keeps its state in globals, so only one compilation may assemble at a time
+   std::mutex ASSEMBLER_LOCK;
+}
+
+   DEL_Driver::DEL_Driver() : asm_output_enabled(true),
+                              peephole_report_enabled(false),
+                              syntax_only(false),
+                              batch_mode(false),
+                              completed(false),
+                              bin_output_file(DEFAULT_BIN_OUT),
+                              asm_output_file(DEFAULT_ASM_OUT),
+                              error_man(*this), 
                               preproc(error_man),
-                              symbol_table(error_man, memory_man),
+                              symbol_table(error_man, memory_man, interner),
                               code_gen(error_man, symbol_table, memory_man),
-                              analyzer(error_man, symbol_table, code_gen, memory_man)
+                              analyzer(error_man, symbol_table, code_gen, memory_man, ast_arena, interner)
    {
-      symbol_table.new_context("global");
+      symbol_table.new_context(interner.intern("global"));
    }
 
    // ----------------------------------------------------------
@@ -33,23 +53,138 @@ namespace DEL
    //
    // ----------------------------------------------------------
    
-   void DEL_Driver::parse( const char * const filename )
+   bool DEL_Driver::parse( const char * const filename )
    {
       assert( filename != nullptr );
 
-      // If this fails, things die
-      preproc.process(filename);
-
-      std::string preproc_file = preproc.get_preprocessed_filename();
+      try
+      {
+         try
+         {
+            // If this fails, things die - unless in batch mode, where only this compilation does
+            preproc.process(filename);
 
-      std::ifstream in_file(preproc_file);
-      if( ! in_file.good() )
+            // The scanner reads straight from the preprocessor's lines
+            parse_helper( preproc.get_preprocessed_stream() );
+         }
+         catch( InternalError & e )
+         {
+            // Raised where there was no error manager to hand
+            error_man.report_custom(e.from, e.what(), true);
+         }
+      }
+      catch( CompilationFailure & )
       {
-         std::cerr << "Developer Error: Preprocessed file : " << preproc_file << " unable to be opened" << std::endl;
-         exit( EXIT_FAILURE );
+         return false;
       }
-      parse_helper( in_file );
-      return;
+      return completed;
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   void DEL_Driver::reset()
+   {
+      preproc.reset();
+      code_gen.reset();
+      analyzer.reset();
+      symbol_table.reset();
+      memory_man.reset();
+      ast_arena.reset();
+
+      r_params.clear();
+      c_params.clear();
+
+      current_file_from_directive.clear();
+      completed = false;
+
+      asm_output_enabled = true;
+      peephole_report_enabled = false;
+      syntax_only = false;
+      bin_output_file = DEFAULT_BIN_OUT;
+      asm_output_file = DEFAULT_ASM_OUT;
+
+      symbol_table.new_context(interner.intern("global"));
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   void DEL_Driver::add_include_path(const std::string & path)
+   {
+      preproc.add_include_path(path);
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   void DEL_Driver::set_output_name(const std::string & base)
+   {
+      bin_output_file = base + ".out";
+      asm_output_file = base + ".asm";
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   void DEL_Driver::set_batch_mode(std::ostream & diagnostics)
+   {
+      batch_mode = true;
+
+      error_man.set_batch_mode(diagnostics);
+
+      // Errors are thrown to the caller, so they have to be raised on the caller's thread
+      set_worker_count(1);
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   void DEL_Driver::set_asm_output(bool enabled)
+   {
+      asm_output_enabled = enabled;
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   void DEL_Driver::set_peephole_report(bool enabled)
+   {
+      peephole_report_enabled = enabled;
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   void DEL_Driver::set_syntax_only(bool enabled)
+   {
+      syntax_only = enabled;
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   const PeepholeStats & DEL_Driver::get_peephole_stats() const
+   {
+      return code_gen.get_peephole_stats();
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   void DEL_Driver::set_worker_count(std::size_t count)
+   {
+      preproc.set_worker_count(count);
+      code_gen.set_worker_count(count);
    }
 
    // ----------------------------------------------------------
@@ -80,8 +215,7 @@ namespace DEL
       }
       catch( std::bad_alloc &ba )
       {
-         std::cerr << "Failed to allocate scanner: (" << ba.what() << ")\n";
-         exit( EXIT_FAILURE );
+         error_man.report_custom("DEL::Driver", "Failed to allocate scanner: (" + std::string(ba.what()) + ")", true);
       }
 
       delete(parser); 
@@ -92,11 +226,10 @@ namespace DEL
       }
       catch( std::bad_alloc &ba )
       {
-         std::cerr << "Failed to allocate parser: (" <<  ba.what() << ")\n";
-         exit( EXIT_FAILURE );
+         error_man.report_custom("DEL::Driver", "Failed to allocate parser: (" + std::string(ba.what()) + ")", true);
       }
       const int accept( 0 );
-      if( parser->parse() != accept )
+      if( parser->parse() != accept && !batch_mode )
       {
          std::cerr << "Parse failed!!\n";
       }
@@ -119,11 +252,17 @@ namespace DEL
 
    void DEL_Driver::indicate_complete()
    {
+      if(syntax_only)
+      {
+         completed = true;
+         return;
+      }
+
       // Check that the analyzer is okay with us being done
       analyzer.check_for_finalization();
 
-      // Directly tell the code gen we want some ASM
-      std::vector<std::string> ASM = code_gen.indicate_complete();
+      // Directly tell the code gen we want some ASM. It comes back as a single buffer so it is only ever written once
+      std::string asm_buffer = code_gen.indicate_complete();
 
       /*
          TODO : 
@@ -135,52 +274,63 @@ namespace DEL
 
       bool assemble_verbose = false;
 
-      std::string asm_output_file = DEFAULT_ASM_OUT;
-      std::string bin_output_file = DEFAULT_BIN_OUT;
+      // The libnabla assembler only reads ASM from a file. Unless the ASM was asked for we hand it a scratch
+      // file outside of the working directory and remove it as soon as the byte code has been generated
+      std::string asm_file = (asm_output_enabled) ? asm_output_file :
+            (std::filesystem::temp_directory_path() / ("del_" + std::to_string(getpid()) + "_" + std::to_string(SCRATCH_COUNTER++) + ".asm")).string();
 
       // output ASM
+      if(!OutputFile::write(asm_file, asm_buffer.data(), asm_buffer.size()))
       {
-         std::ofstream asm_out;
-         asm_out.open(asm_output_file);
-         if(!asm_out.is_open())
-         {
-            error_man.report_unable_to_open_result_out(asm_output_file, true);
-         }
-         for(auto & l : ASM)
-         {
-            asm_out << l;
-         }
-         asm_out.close();
-         ASM.clear();
+         error_man.report_unable_to_open_result_out(asm_file, true);
       }
+      asm_buffer.clear();
 
       std::vector<uint8_t> binary_data;
 
-      if(!ASSEMBLER::ParseAsm(asm_output_file, binary_data, assemble_verbose))
+      bool assembled = false;
+      {
+         std::lock_guard<std::mutex> guard(ASSEMBLER_LOCK);
+         assembled = ASSEMBLER::ParseAsm(asm_file, binary_data, assemble_verbose);
+      }
+
+      if(!asm_output_enabled)
+      {
+         std::filesystem::remove(std::filesystem::path(asm_file));
+      }
+
+      if(!assembled)
       {
          error_man.report_custom("DEL::Driver", "Developer Error : Generated ASM code would not assemble", true);
       }
 
       // output BYTE CODE
+      if(!OutputFile::write(bin_output_file, binary_data.data(), binary_data.size()))
       {
-         std::ofstream bin_out;
-         bin_out.open(bin_output_file);
-         if(!bin_out.is_open())
-         {
-            error_man.report_unable_to_open_result_out(bin_output_file, true);
-         }
-         for(auto & l : binary_data)
-         {
-            bin_out << l;
-         }
-         bin_out.close();
-         binary_data.clear();
+         error_man.report_unable_to_open_result_out(bin_output_file, true);
+      }
+      binary_data.clear();
+
+      completed = true;
+
+      // Many compilations report together once they are all done
+      if(batch_mode)
+      {
+         return;
       }
 
-      // Keep this until we allow configuration of output names / etc
       std::cout << ">>> Complete <<<" << std::endl 
-                << "Binary output file : " << DEFAULT_BIN_OUT << std::endl 
-                << "Nabla ASM file     : " << DEFAULT_ASM_OUT << std::endl;
+                << "Binary output file : " << bin_output_file << std::endl;
+
+      if(asm_output_enabled)
+      {
+         std::cout << "Nabla ASM file     : " << asm_output_file << std::endl;
+      }
+
+      if(peephole_report_enabled)
+      {
+         code_gen.get_peephole_stats().report(std::cout);
+      }
    }
 
    // ----------------------------------------------------------
@@ -189,6 +339,12 @@ namespace DEL
 
    void DEL_Driver::build_function(Function *function)
    {
+      if(syntax_only)
+      {
+         ast_arena.reset();
+         return;
+      }
+
       // Trigger the analyzer with a function
       analyzer.build_function(function);
    }
@@ -206,6 +362,15 @@ namespace DEL
    //
    // ----------------------------------------------------------
 
+   SymbolId DEL_Driver::intern(std::string_view identifier)
+   {
+      return interner.intern(identifier);
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
    DEL::Errors & DEL_Driver::get_error_man_ref()
    {
       return error_man;
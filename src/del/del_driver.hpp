@@ -2,13 +2,16 @@
 #define __DELDRIVER_HPP__ 1
 
 #include <string>
+#include <string_view>
 #include <cstddef>
 #include <istream>
 #include <vector>
 
 #include "Ast.hpp"
+#include "Arena.hpp"
 #include "Analyzer.hpp"
 #include "Errors.hpp"
+#include "Interner.hpp"
 #include "Codegen.hpp"
 #include "SymbolTable.hpp"
 #include "Memory.hpp"
@@ -34,7 +37,48 @@ namespace DEL
       virtual ~DEL_Driver();
       
       //! \brief Parse from a file
-      void parse( const char * const filename );
+      //! \returns true if the file was compiled and its output written
+      bool parse( const char * const filename );
+
+      //! \brief Forget the last compilation so the driver can be used for another
+      //! \post Outputs and include paths go back to their defaults. Interned names, allocated
+      //!       storage and preprocessed files that haven't changed on disk are kept for reuse
+      void reset();
+
+      //! \brief Add a path to search for files named by use statements
+      //! \param path The directory to search
+      void add_include_path(const std::string & path);
+
+      //! \brief Set the name outputs are written to
+      //! \param base Path and name without extension. The binary is written to base.out, and ASM to base.asm
+      void set_output_name(const std::string & base);
+
+      //! \brief Compile as one of many compilations in the process
+      //! \param diagnostics Stream errors are written to
+      //! \post Fatal errors abandon only this compilation, and parse() returns false. All work
+      //!       is done on the calling thread, and nothing is written to std::cout
+      void set_batch_mode(std::ostream & diagnostics);
+
+      //! \brief Enable or disable writing the generated ASM to DEFAULT_ASM_OUT. Enabled by default
+      //! \param enabled If true, the ASM handed to the assembler is kept. If false it is only staged
+      //!        in a scratch file for the assembler
+      void set_asm_output(bool enabled);
+
+      //! \brief Enable or disable reporting what the peephole optimizer changed once compiled
+      //! \param enabled If true, the counts are written to std::cout with the other results
+      void set_peephole_report(bool enabled);
+
+      //! \brief Only check the syntax of the input
+      //! \param enabled If true, each function is dropped once parsed, and nothing is analysed,
+      //!        generated or written. Used to time the front end on its own
+      void set_syntax_only(bool enabled);
+
+      //! \brief Get what the peephole optimizer changed in the last compilation
+      const PeepholeStats & get_peephole_stats() const;
+
+      //! \brief Set how many threads may be used to preprocess and generate code
+      //! \param count Number of workers. 1 does all of the work on the calling thread
+      void set_worker_count(std::size_t count);
 
       //! \brief Inc line count
       void inc_line();
@@ -49,6 +93,11 @@ namespace DEL
       //! \brief Indicate a directive from the preprocessor was parsed
       void preproc_file_directive(std::string directive);
 
+      //! \brief Intern an identifier found by the scanner
+      //! \param identifier The identifier text
+      //! \returns Id of the identifier
+      SymbolId intern(std::string_view identifier);
+
       friend DEL_Parser;
       friend Errors;
 
@@ -65,6 +114,17 @@ namespace DEL
 
       std::string current_file_from_directive;
 
+      bool asm_output_enabled;
+      bool peephole_report_enabled;
+      bool syntax_only;
+      bool batch_mode;
+      bool completed;
+
+      std::string bin_output_file;
+      std::string asm_output_file;
+
+      DEL::Interner interner;          // Identifier and function names
+      DEL::Arena   ast_arena;          // Storage for the AST of the function being parsed
       DEL::Memory  memory_man;         // Memory manager
       DEL::Errors error_man;           // Error manager
       DEL::Preprocessor preproc;       // Preprocessor
@@ -79,6 +139,10 @@ namespace DEL
       DEL::DEL_Parser  *parser  = nullptr;
       DEL::DEL_Scanner *scanner = nullptr;
 
+      // Parameters of the function definition / call being parsed
+      std::vector<DEL::FunctionParam> r_params;
+      std::vector<DEL::FunctionParam> c_params;
+
 
       std::string evaluate(AST * ast);
 
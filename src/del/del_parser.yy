@@ -11,6 +11,8 @@
 
 %code requires{
    
+   #include "Types.hpp"
+
    namespace DEL 
    {
       class DEL_Driver;
@@ -45,6 +47,7 @@
    #include <cstdlib>
    #include <fstream>
    #include <stdint.h>
+   #include <utility>
    #include <vector>
 
    #include "Ast.hpp"
@@ -52,9 +55,6 @@
    
    #include "del_driver.hpp"
 
-   std::vector<DEL::FunctionParam> r_params;
-   std::vector<DEL::FunctionParam> c_params;
-
 #undef yylex
 #define yylex scanner.yylex
 }
@@ -82,7 +82,7 @@
 %type<DEL::Step*>  step_inc;
 %type<DEL::WhileLoop*> while_stmt;
 %type<DEL::NamedLoop*> named_loop_stmt;
-%type<std::string> identifiers;
+%type<DEL::SymbolId> identifiers;
 %type<DEL::FunctionParam*> call_item;
 
 %type<DEL::AST*> expr_function_call;
@@ -96,11 +96,11 @@
 %type<std::vector<DEL::Element*>> multiple_statements;
 %type<std::vector<DEL::Element*>> block;
 
-%token <std::string> INT_LITERAL
-%token <std::string> HEX_LITERAL
-%token <std::string> REAL_LITERAL
-%token <std::string> CHAR_LITERAL
-%token <std::string> IDENTIFIER
+%token <uint64_t>    INT_LITERAL
+%token <uint64_t>    HEX_LITERAL
+%token <double>      REAL_LITERAL
+%token <char>        CHAR_LITERAL
+%token <DEL::SymbolId> IDENTIFIER
 %token <int>         RIGHT_BRACKET  // These tokens encode line numbers
 %token <int>         RIGHT_PAREN    // These tokens encode line numbers
 %token <int>         KEY            // These tokens encode line numbers
@@ -125,92 +125,92 @@ input
 
 expression
    : term                        { $$ = $1;  }
-   | expression ADD term         { $$ = new DEL::AST(DEL::NodeType::ADD, $1, $3);  }
-   | expression SUB term         { $$ = new DEL::AST(DEL::NodeType::SUB, $1, $3);  }
-   | expression LTE term         { $$ = new DEL::AST(DEL::NodeType::LTE, $1, $3);  }
-   | expression GTE term         { $$ = new DEL::AST(DEL::NodeType::GTE, $1, $3);  }
-   | expression GT  term         { $$ = new DEL::AST(DEL::NodeType::GT , $1, $3);  }
-   | expression LT  term         { $$ = new DEL::AST(DEL::NodeType::LT , $1, $3);  }
-   | expression EQ  term         { $$ = new DEL::AST(DEL::NodeType::EQ , $1, $3);  }
-   | expression NE  term         { $$ = new DEL::AST(DEL::NodeType::NE , $1, $3);  }
+   | expression ADD term         { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::ADD, $1, $3);  }
+   | expression SUB term         { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::SUB, $1, $3);  }
+   | expression LTE term         { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::LTE, $1, $3);  }
+   | expression GTE term         { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::GTE, $1, $3);  }
+   | expression GT  term         { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::GT , $1, $3);  }
+   | expression LT  term         { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::LT , $1, $3);  }
+   | expression EQ  term         { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::EQ , $1, $3);  }
+   | expression NE  term         { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::NE , $1, $3);  }
    ;
 
 term
    : factor                      { $$ = $1;  }
-   | term MUL factor             { $$ = new DEL::AST(DEL::NodeType::MUL,    $1, $3);  }
-   | term DIV factor             { $$ = new DEL::AST(DEL::NodeType::DIV,    $1, $3);  }
-   | term POW factor             { $$ = new DEL::AST(DEL::NodeType::POW,    $1, $3);  }
-   | term MOD factor             { $$ = new DEL::AST(DEL::NodeType::MOD,    $1, $3);  }
-   | term LSH factor             { $$ = new DEL::AST(DEL::NodeType::LSH,    $1, $3);  }
-   | term RSH factor             { $$ = new DEL::AST(DEL::NodeType::RSH,    $1, $3);  }
-   | term BW_XOR factor          { $$ = new DEL::AST(DEL::NodeType::BW_XOR, $1, $3);  }
-   | term BW_OR factor           { $$ = new DEL::AST(DEL::NodeType::BW_OR,  $1, $3);  }
-   | term BW_AND factor          { $$ = new DEL::AST(DEL::NodeType::BW_AND, $1, $3);  }
-   | term OR factor              { $$ = new DEL::AST(DEL::NodeType::OR,     $1, $3);  }
-   | term AND factor             { $$ = new DEL::AST(DEL::NodeType::AND,    $1, $3);  }
+   | term MUL factor             { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::MUL,    $1, $3);  }
+   | term DIV factor             { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::DIV,    $1, $3);  }
+   | term POW factor             { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::POW,    $1, $3);  }
+   | term MOD factor             { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::MOD,    $1, $3);  }
+   | term LSH factor             { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::LSH,    $1, $3);  }
+   | term RSH factor             { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::RSH,    $1, $3);  }
+   | term BW_XOR factor          { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::BW_XOR, $1, $3);  }
+   | term BW_OR factor           { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::BW_OR,  $1, $3);  }
+   | term BW_AND factor          { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::BW_AND, $1, $3);  }
+   | term OR factor              { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::OR,     $1, $3);  }
+   | term AND factor             { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::AND,    $1, $3);  }
    ;
 
 factor
    : primary                     { $$ = $1; }
    | expr_function_call          { $$ = $1; }
    | LEFT_PAREN expression RIGHT_PAREN    { $$ = $2; }
-   | BW_NOT factor               { $$ = new DEL::AST(DEL::NodeType::BW_NOT, $2, nullptr);}
-   | NEGATE factor               { $$ = new DEL::AST(DEL::NodeType::NEGATE, $2, nullptr);}
+   | BW_NOT factor               { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::BW_NOT, $2, nullptr);}
+   | NEGATE factor               { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::NEGATE, $2, nullptr);}
    ;
 
 expr_function_call
-   : identifiers LEFT_PAREN RIGHT_PAREN             { $$ = new DEL::Call($1, c_params, nullptr, nullptr, $3); }
-   | identifiers LEFT_PAREN call_params RIGHT_PAREN { $$ = new DEL::Call($1, c_params, nullptr, nullptr, $4); c_params.clear(); }
+   : identifiers LEFT_PAREN RIGHT_PAREN             { $$ = driver.ast_arena.make<DEL::AST>(driver.ast_arena.make<DEL::Call>($1, std::move(driver.c_params), $3)); driver.c_params.clear(); }
+   | identifiers LEFT_PAREN call_params RIGHT_PAREN { $$ = driver.ast_arena.make<DEL::AST>(driver.ast_arena.make<DEL::Call>($1, std::move(driver.c_params), $4)); driver.c_params.clear(); }
    ;
 
 primary
-    : INT_LITERAL                { $$ = new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, DEL::ValType::INTEGER, $1); }
-    | REAL_LITERAL               { $$ = new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, DEL::ValType::REAL,    $1); }
-    | HEX_LITERAL                { $$ = new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, DEL::ValType::INTEGER, std::to_string(std::strtoul($1.c_str(), 0, 16))); }
-    | identifiers                { $$ = new DEL::AST(DEL::NodeType::ID,  nullptr, nullptr, DEL::ValType::STRING,  $1); }
+    : INT_LITERAL                { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, DEL::ValType::INTEGER, DEL::Literal($1)); }
+    | REAL_LITERAL               { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, DEL::ValType::REAL,    DEL::Literal($1)); }
+    | HEX_LITERAL                { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, DEL::ValType::INTEGER, DEL::Literal($1)); }
+    | identifiers                { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::ID,  nullptr, nullptr, DEL::ValType::STRING,  $1); }
     ;
 
 primary_char
-   : CHAR_LITERAL                { $$ = new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, DEL::ValType::CHAR,    $1); }
-   | identifiers                 { $$ = new DEL::AST(DEL::NodeType::ID,  nullptr, nullptr, DEL::ValType::STRING,  $1); }
+   : CHAR_LITERAL                { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, DEL::ValType::CHAR,    DEL::Literal(static_cast<uint64_t>($1))); }
+   | identifiers                 { $$ = driver.ast_arena.make<DEL::AST>(DEL::NodeType::ID,  nullptr, nullptr, DEL::ValType::STRING,  $1); }
    ;
 
 identifiers
-   :  IDENTIFIER                 { $$ = $1;      } 
-   |  IDENTIFIER DOT identifiers { $$ = $1 + "." + $3; }
+   :  IDENTIFIER                 { $$ = $1; } 
+   |  IDENTIFIER DOT identifiers { $$ = driver.interner.intern(driver.interner.name($1) + "." + driver.interner.name($3)); }
    ;
 
 assignment
-   : INT  identifiers ASSIGN expression   SEMI { $$ = new DEL::Assignment(DEL::ValType::INTEGER, $2, $4); $$->set_line_no($5); }
-   | REAL identifiers ASSIGN expression   SEMI { $$ = new DEL::Assignment(DEL::ValType::REAL,    $2, $4); $$->set_line_no($5); }
-   | CHAR identifiers ASSIGN primary_char SEMI { $$ = new DEL::Assignment(DEL::ValType::CHAR,    $2, $4); $$->set_line_no($5); }
+   : INT  identifiers ASSIGN expression   SEMI { $$ = driver.ast_arena.make<DEL::Assignment>(DEL::ValType::INTEGER, $2, $4); $$->set_line_no($5); }
+   | REAL identifiers ASSIGN expression   SEMI { $$ = driver.ast_arena.make<DEL::Assignment>(DEL::ValType::REAL,    $2, $4); $$->set_line_no($5); }
+   | CHAR identifiers ASSIGN primary_char SEMI { $$ = driver.ast_arena.make<DEL::Assignment>(DEL::ValType::CHAR,    $2, $4); $$->set_line_no($5); }
    ;
 
 reassignment
-   : identifiers ASSIGN expression   SEMI     { $$ = new DEL::Assignment(DEL::ValType::REQ_CHECK, $1, $3); $$->set_line_no($4); }
+   : identifiers ASSIGN expression   SEMI     { $$ = driver.ast_arena.make<DEL::Assignment>(DEL::ValType::REQ_CHECK, $1, $3); $$->set_line_no($4); }
    ;
 
 return_stmt
-   : RETURN expression SEMI { $$ = new DEL::ReturnStmt($2); $$->set_line_no($3); }
-   | RETURN SEMI            { $$ = new DEL::ReturnStmt();   $$->set_line_no($2); }
+   : RETURN expression SEMI { $$ = driver.ast_arena.make<DEL::ReturnStmt>($2); $$->set_line_no($3); }
+   | RETURN SEMI            { $$ = driver.ast_arena.make<DEL::ReturnStmt>();   $$->set_line_no($2); }
    ;
 
 if_stmt
-   : IF LEFT_PAREN expression RIGHT_PAREN block elif_stmt { $$ = new DEL::If(DEL::IfType::IF, $3, $5, $6, $4);      }
-   | IF LEFT_PAREN expression RIGHT_PAREN block else_stmt { $$ = new DEL::If(DEL::IfType::IF, $3, $5, $6, $4);      }
-   | IF LEFT_PAREN expression RIGHT_PAREN block           { $$ = new DEL::If(DEL::IfType::IF, $3, $5, nullptr, $4); }
+   : IF LEFT_PAREN expression RIGHT_PAREN block elif_stmt { $$ = driver.ast_arena.make<DEL::If>(DEL::IfType::IF, $3, std::move($5), $6, $4);      }
+   | IF LEFT_PAREN expression RIGHT_PAREN block else_stmt { $$ = driver.ast_arena.make<DEL::If>(DEL::IfType::IF, $3, std::move($5), $6, $4);      }
+   | IF LEFT_PAREN expression RIGHT_PAREN block           { $$ = driver.ast_arena.make<DEL::If>(DEL::IfType::IF, $3, std::move($5), nullptr, $4); }
    ;
 
 elif_stmt
-   : ELIF LEFT_PAREN expression RIGHT_PAREN block elif_stmt  { $$ = new DEL::If(DEL::IfType::ELIF, $3, $5, $6, $4);      }
-   | ELIF LEFT_PAREN expression RIGHT_PAREN block else_stmt  { $$ = new DEL::If(DEL::IfType::ELIF, $3, $5, $6, $4);      }
-   | ELIF LEFT_PAREN expression RIGHT_PAREN block            { $$ = new DEL::If(DEL::IfType::ELIF, $3, $5, nullptr, $4); }
+   : ELIF LEFT_PAREN expression RIGHT_PAREN block elif_stmt  { $$ = driver.ast_arena.make<DEL::If>(DEL::IfType::ELIF, $3, std::move($5), $6, $4);      }
+   | ELIF LEFT_PAREN expression RIGHT_PAREN block else_stmt  { $$ = driver.ast_arena.make<DEL::If>(DEL::IfType::ELIF, $3, std::move($5), $6, $4);      }
+   | ELIF LEFT_PAREN expression RIGHT_PAREN block            { $$ = driver.ast_arena.make<DEL::If>(DEL::IfType::ELIF, $3, std::move($5), nullptr, $4); }
    ;
 
 else_stmt
-   : ELSE block   { $$ = new DEL::If(DEL::IfType::ELSE, 
-                                     new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, DEL::ValType::INTEGER, "1"), 
-                                     $2, 
+   : ELSE block   { $$ = driver.ast_arena.make<DEL::If>(DEL::IfType::ELSE, 
+                                     driver.ast_arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, DEL::ValType::INTEGER, DEL::Literal(uint64_t(1))), 
+                                     std::move($2), 
                                      nullptr, 
                                      $1); 
                      // We create an "always true" statement so we can leverage elseif code, while still
@@ -225,62 +225,62 @@ else_stmt
 //
 for_stmt 
    : FOR IDENTIFIER IN range_decl_int block 
-      { $$ = new DEL::ForLoop(ValType::INTEGER, $2, $4, new DEL::Step(DEL::ValType::INTEGER, "1"), $5); }
+      { $$ = driver.ast_arena.make<DEL::ForLoop>(ValType::INTEGER, $2, $4, driver.ast_arena.make<DEL::Step>(DEL::ValType::INTEGER, DEL::Bound(DEL::Literal(uint64_t(1)))), std::move($5)); }
 
    | FOR IDENTIFIER IN range_decl_int step_inc block 
-      { $$ = new DEL::ForLoop(ValType::INTEGER, $2, $4, $5, $6); }
+      { $$ = driver.ast_arena.make<DEL::ForLoop>(ValType::INTEGER, $2, $4, $5, std::move($6)); }
 
    | FOR IDENTIFIER IN range_decl_real block 
-      { $$ = new DEL::ForLoop(ValType::REAL, $2, $4, new DEL::Step(DEL::ValType::REAL, "1.0"), $5); }
+      { $$ = driver.ast_arena.make<DEL::ForLoop>(ValType::REAL, $2, $4, driver.ast_arena.make<DEL::Step>(DEL::ValType::REAL, DEL::Bound(DEL::Literal(1.0))), std::move($5)); }
 
    | FOR IDENTIFIER IN range_decl_real step_inc block 
-      { $$ = new DEL::ForLoop(ValType::REAL, $2, $4, $5, $6); }
+      { $$ = driver.ast_arena.make<DEL::ForLoop>(ValType::REAL, $2, $4, $5, std::move($6)); }
    ;
 
 range_decl_int
    : RANGE COL INT LEFT_PAREN INT_LITERAL COMMA INT_LITERAL RIGHT_PAREN 
-      { $$ = new DEL::Range(ValType::INTEGER, $5, $7, $8); }
+      { $$ = driver.ast_arena.make<DEL::Range>(ValType::INTEGER, DEL::Bound(DEL::Literal($5)), DEL::Bound(DEL::Literal($7)), $8); }
 
    | RANGE COL INT LEFT_PAREN identifiers COMMA INT_LITERAL RIGHT_PAREN 
-      { $$ = new DEL::Range(ValType::REQ_CHECK, $5, $7, $8); }
+      { $$ = driver.ast_arena.make<DEL::Range>(ValType::REQ_CHECK, DEL::Bound($5), DEL::Bound(DEL::Literal($7)), $8); }
 
    | RANGE COL INT LEFT_PAREN identifiers COMMA identifiers RIGHT_PAREN 
-      { $$ = new DEL::Range(ValType::REQ_CHECK, $5, $7, $8); }
+      { $$ = driver.ast_arena.make<DEL::Range>(ValType::REQ_CHECK, DEL::Bound($5), DEL::Bound($7), $8); }
 
    | RANGE COL INT LEFT_PAREN INT_LITERAL COMMA identifiers RIGHT_PAREN 
-      { $$ = new DEL::Range(ValType::REQ_CHECK, $5, $7, $8); }
+      { $$ = driver.ast_arena.make<DEL::Range>(ValType::REQ_CHECK, DEL::Bound(DEL::Literal($5)), DEL::Bound($7), $8); }
    ;
 
 range_decl_real
    : RANGE COL REAL LEFT_PAREN REAL_LITERAL COMMA REAL_LITERAL RIGHT_PAREN 
-      { $$ = new DEL::Range(ValType::REAL, $5, $7, $8); }
+      { $$ = driver.ast_arena.make<DEL::Range>(ValType::REAL, DEL::Bound(DEL::Literal($5)), DEL::Bound(DEL::Literal($7)), $8); }
 
    | RANGE COL REAL LEFT_PAREN identifiers COMMA REAL_LITERAL RIGHT_PAREN 
-      { $$ = new DEL::Range(ValType::REQ_CHECK, $5, $7, $8); }
+      { $$ = driver.ast_arena.make<DEL::Range>(ValType::REQ_CHECK, DEL::Bound($5), DEL::Bound(DEL::Literal($7)), $8); }
 
    | RANGE COL REAL LEFT_PAREN identifiers COMMA identifiers RIGHT_PAREN 
-      { $$ = new DEL::Range(ValType::REQ_CHECK, $5, $7, $8); }
+      { $$ = driver.ast_arena.make<DEL::Range>(ValType::REQ_CHECK, DEL::Bound($5), DEL::Bound($7), $8); }
 
    | RANGE COL REAL LEFT_PAREN REAL_LITERAL COMMA identifiers RIGHT_PAREN 
-      { $$ = new DEL::Range(ValType::REQ_CHECK, $5, $7, $8); }
+      { $$ = driver.ast_arena.make<DEL::Range>(ValType::REQ_CHECK, DEL::Bound(DEL::Literal($5)), DEL::Bound($7), $8); }
    ;
 
 step_inc
-   : STEP INT_LITERAL  { $$ = new DEL::Step(DEL::ValType::INTEGER,   $2); }
-   | STEP REAL_LITERAL { $$ = new DEL::Step(DEL::ValType::REAL,      $2); }
-   | STEP identifiers  { $$ = new DEL::Step(DEL::ValType::REQ_CHECK, $2); }
+   : STEP INT_LITERAL  { $$ = driver.ast_arena.make<DEL::Step>(DEL::ValType::INTEGER,   DEL::Bound(DEL::Literal($2))); }
+   | STEP REAL_LITERAL { $$ = driver.ast_arena.make<DEL::Step>(DEL::ValType::REAL,      DEL::Bound(DEL::Literal($2))); }
+   | STEP identifiers  { $$ = driver.ast_arena.make<DEL::Step>(DEL::ValType::REQ_CHECK, DEL::Bound($2)); }
    ;
 
 while_stmt
-   : WHILE LEFT_PAREN expression RIGHT_PAREN block { $$ = new DEL::WhileLoop($3, $5); $$->set_line_no($4); }
+   : WHILE LEFT_PAREN expression RIGHT_PAREN block { $$ = driver.ast_arena.make<DEL::WhileLoop>($3, std::move($5)); $$->set_line_no($4); }
    ;
 
 named_loop_stmt
-   : LOOP KEY identifiers block { $$ = new DEL::NamedLoop($3, $4); $$->set_line_no($2); }
+   : LOOP KEY identifiers block { $$ = driver.ast_arena.make<DEL::NamedLoop>($3, std::move($4)); $$->set_line_no($2); }
    ;
 
 annul_stmt
-   : ANNUL identifiers SEMI { $$ = new DEL::AnnulStmt($2); $$->set_line_no($3); }
+   : ANNUL identifiers SEMI { $$ = driver.ast_arena.make<DEL::AnnulStmt>($2); $$->set_line_no($3); }
    ;
 
 stmt
@@ -297,29 +297,29 @@ stmt
 
 multiple_statements
    : stmt                     { $$ = std::vector<DEL::Element*>(); $$.push_back($1); }
-   | multiple_statements stmt { $1.push_back($2); $$ = $1; }
+   | multiple_statements stmt { $$ = std::move($1); $$.push_back($2); }
    ;
 
 block 
-   : LEFT_BRACKET multiple_statements RIGHT_BRACKET { $$ = $2; }
+   : LEFT_BRACKET multiple_statements RIGHT_BRACKET { $$ = std::move($2); }
    | LEFT_BRACKET RIGHT_BRACKET                     { $$ = std::vector<DEL::Element*>(); }
    ;
 
 recv_params
-   : value_types IDENTIFIER   { r_params.clear(); r_params.push_back({static_cast<DEL::ValType>($1), $2}); }
-   | recv_params COMMA value_types IDENTIFIER {r_params.push_back({static_cast<DEL::ValType>($3), $4});}
+   : value_types IDENTIFIER   { driver.r_params.clear(); driver.r_params.push_back({static_cast<DEL::ValType>($1), $2}); }
+   | recv_params COMMA value_types IDENTIFIER {driver.r_params.push_back({static_cast<DEL::ValType>($3), $4});}
    ;
 
 call_item
-   : IDENTIFIER   { $$ = new DEL::FunctionParam(DEL::ValType::REQ_CHECK, $1);  }
-   | INT_LITERAL  { $$ = new DEL::FunctionParam(DEL::ValType::INTEGER,   $1);  }
-   | REAL_LITERAL { $$ = new DEL::FunctionParam(DEL::ValType::REAL,      $1);  }
-   | CHAR_LITERAL { $$ = new DEL::FunctionParam(DEL::ValType::CHAR,      $1);  }
+   : IDENTIFIER   { $$ = driver.ast_arena.make<DEL::FunctionParam>(DEL::ValType::REQ_CHECK, $1);  }
+   | INT_LITERAL  { $$ = driver.ast_arena.make<DEL::FunctionParam>(DEL::ValType::INTEGER,   DEL::Literal($1));  }
+   | REAL_LITERAL { $$ = driver.ast_arena.make<DEL::FunctionParam>(DEL::ValType::REAL,      DEL::Literal($1));  }
+   | CHAR_LITERAL { $$ = driver.ast_arena.make<DEL::FunctionParam>(DEL::ValType::CHAR,      DEL::Literal(static_cast<uint64_t>($1)));  }
    ;
 
 call_params
-   : call_item { c_params.clear(); c_params.push_back(*($1)); delete $1; }
-   | call_params COMMA call_item   { c_params.push_back(*($3)); delete $3; }
+   : call_item { driver.c_params.clear(); driver.c_params.push_back(std::move(*($1))); }
+   | call_params COMMA call_item   { driver.c_params.push_back(std::move(*($3))); }
    ;
 
 value_types
@@ -330,13 +330,13 @@ value_types
    ;
 
 function_stmt
-   : DEF identifiers LEFT_PAREN RIGHT_PAREN ARROW value_types block             { $$ = new DEL::Function($2, r_params, static_cast<DEL::ValType>($6), $7, $1); }
-   | DEF identifiers LEFT_PAREN recv_params RIGHT_PAREN ARROW value_types block { $$ = new DEL::Function($2, r_params, static_cast<DEL::ValType>($7), $8, $1); r_params.clear(); }
+   : DEF identifiers LEFT_PAREN RIGHT_PAREN ARROW value_types block             { $$ = driver.ast_arena.make<DEL::Function>($2, std::move(driver.r_params), static_cast<DEL::ValType>($6), std::move($7), $1); driver.r_params.clear(); }
+   | DEF identifiers LEFT_PAREN recv_params RIGHT_PAREN ARROW value_types block { $$ = driver.ast_arena.make<DEL::Function>($2, std::move(driver.r_params), static_cast<DEL::ValType>($7), std::move($8), $1); driver.r_params.clear(); }
    ;
 
 direct_function_call
-   : identifiers LEFT_PAREN RIGHT_PAREN SEMI             { $$ = new DEL::Call($1, c_params); $$->set_line_no($4); }
-   | identifiers LEFT_PAREN call_params RIGHT_PAREN SEMI { $$ = new DEL::Call($1, c_params); $$->set_line_no($5); c_params.clear(); }
+   : identifiers LEFT_PAREN RIGHT_PAREN SEMI             { $$ = driver.ast_arena.make<DEL::Call>($1, std::move(driver.c_params)); $$->set_line_no($4); driver.c_params.clear(); }
+   | identifiers LEFT_PAREN call_params RIGHT_PAREN SEMI { $$ = driver.ast_arena.make<DEL::Call>($1, std::move(driver.c_params)); $$->set_line_no($5); driver.c_params.clear(); }
    ;
 
 
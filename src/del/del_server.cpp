@@ -0,0 +1,348 @@
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <filesystem>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "del_server.hpp"
+
+namespace DEL
+{
+namespace
+{
+   // Requests are a handful of short lines, anything past this isn't a request
+   constexpr std::size_t MAX_REQUEST_SIZE = 64 * 1024;
+
+   // A client that stops mid request is dropped rather than holding up every other client
+   constexpr time_t RECEIVE_TIMEOUT_SECONDS = 5;
+
+   volatile std::sig_atomic_t STOP_REQUESTED = 0;
+
+   void request_stop(int)
+   {
+      STOP_REQUESTED = 1;
+   }
+
+   bool send_all(int fd, const char * data, std::size_t size)
+   {
+      while(size > 0)
+      {
+         ssize_t sent = ::send(fd, data, size, 0);
+         if(sent < 0)
+         {
+            if(errno == EINTR) { continue; }
+            return false;
+         }
+         data += sent;
+         size -= static_cast<std::size_t>(sent);
+      }
+      return true;
+   }
+}
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   DEL_Server::DEL_Server(std::string socket_path) : socket_path(socket_path),
+                                                     listener(-1)
+   {
+      // A failed compilation reports into the request's diagnostics and leaves the server running
+      driver.set_batch_mode(diagnostics);
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   DEL_Server::~DEL_Server()
+   {
+      if(listener >= 0)
+      {
+         ::close(listener);
+         ::unlink(socket_path.c_str());
+      }
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   int DEL_Server::serve()
+   {
+      if(!listen_on_socket())
+      {
+         return 1;
+      }
+
+      // Clients that hang up early must not take the server with them. The stop signals are
+      // installed without SA_RESTART so a blocked accept() wakes up to see them
+      std::signal(SIGPIPE, SIG_IGN);
+
+      struct sigaction stop_action;
+      std::memset(&stop_action, 0, sizeof(stop_action));
+      stop_action.sa_handler = request_stop;
+      sigemptyset(&stop_action.sa_mask);
+      sigaction(SIGINT,  &stop_action, nullptr);
+      sigaction(SIGTERM, &stop_action, nullptr);
+
+      std::cout << ">>> Serving on " << socket_path << std::endl;
+
+      uint64_t served = 0;
+      bool shutdown = false;
+
+      while(!shutdown && !STOP_REQUESTED)
+      {
+         int connection = ::accept(listener, nullptr, nullptr);
+         if(connection < 0)
+         {
+            if(errno == EINTR || errno == ECONNABORTED) { continue; }
+
+            std::cerr << "Unable to accept on " << socket_path << " : " << std::strerror(errno) << std::endl;
+            break;
+         }
+
+         struct timeval timeout;
+         timeout.tv_sec  = RECEIVE_TIMEOUT_SECONDS;
+         timeout.tv_usec = 0;
+         setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+         Request request;
+         std::string error;
+         if(!read_request(connection, request, error))
+         {
+            respond(connection, false, error + "\n");
+            ::close(connection);
+            continue;
+         }
+
+         shutdown = request.shutdown;
+
+         // A request may only ask for the server to stop
+         if(request.source.empty())
+         {
+            respond(connection, true, "");
+            ::close(connection);
+            continue;
+         }
+
+         bool compiled = compile(request);
+         respond(connection, compiled, diagnostics.str());
+         ::close(connection);
+
+         served++;
+      }
+
+      std::cout << ">>> Served " << served << " requests, stopping" << std::endl;
+      return 0;
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   bool DEL_Server::listen_on_socket()
+   {
+      struct sockaddr_un address;
+      std::memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+
+      if(socket_path.empty() || socket_path.size() >= sizeof(address.sun_path))
+      {
+         std::cerr << "Unable to use \"" << socket_path << "\" as a socket path" << std::endl;
+         return false;
+      }
+      std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size());
+
+      int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      if(fd < 0)
+      {
+         std::cerr << "Unable to create socket : " << std::strerror(errno) << std::endl;
+         return false;
+      }
+
+      bool bound = (::bind(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == 0);
+
+      if(!bound && errno == EADDRINUSE)
+      {
+         // Left behind by a server that didn't get to clean up. If nothing answers on it, it can be replaced
+         int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+         bool in_use = (probe >= 0 && ::connect(probe, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == 0);
+         if(probe >= 0) { ::close(probe); }
+
+         if(in_use)
+         {
+            std::cerr << "Another server is already listening on " << socket_path << std::endl;
+            ::close(fd);
+            return false;
+         }
+
+         ::unlink(socket_path.c_str());
+         bound = (::bind(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == 0);
+      }
+
+      if(!bound)
+      {
+         std::cerr << "Unable to bind " << socket_path << " : " << std::strerror(errno) << std::endl;
+         ::close(fd);
+         return false;
+      }
+
+      if(::listen(fd, SOMAXCONN) != 0)
+      {
+         std::cerr << "Unable to listen on " << socket_path << " : " << std::strerror(errno) << std::endl;
+         ::close(fd);
+         ::unlink(socket_path.c_str());
+         return false;
+      }
+
+      listener = fd;
+      return true;
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   bool DEL_Server::read_request(int connection, Request & request, std::string & error)
+   {
+      std::string text;
+      char chunk[4096];
+
+      // Read until the blank line that ends the request, or until the client is done writing
+      while(text.find("\n\n") == std::string::npos)
+      {
+         ssize_t received = ::recv(connection, chunk, sizeof(chunk), 0);
+         if(received < 0)
+         {
+            if(errno == EINTR && !STOP_REQUESTED) { continue; }
+
+            error = "Request was not received";
+            return false;
+         }
+
+         if(received == 0)
+         {
+            break;
+         }
+
+         text.append(chunk, static_cast<std::size_t>(received));
+
+         if(text.size() > MAX_REQUEST_SIZE)
+         {
+            error = "Request is too large";
+            return false;
+         }
+      }
+
+      std::istringstream lines(text.substr(0, text.find("\n\n")));
+      std::string line;
+      while(std::getline(lines, line))
+      {
+         if(!line.empty() && line.back() == '\r')
+         {
+            line.pop_back();
+         }
+
+         if(line.empty())
+         {
+            continue;
+         }
+
+         std::string::size_type split = line.find(' ');
+         std::string key   = line.substr(0, split);
+         std::string value = (split == std::string::npos) ? "" : line.substr(split + 1);
+
+         if(key == "source" && !value.empty())
+         {
+            request.source = value;
+         }
+         else if(key == "include" && !value.empty())
+         {
+            request.include_paths.push_back(value);
+         }
+         else if(key == "output" && !value.empty())
+         {
+            request.output = value;
+         }
+         else if(key == "asm" && value.empty())
+         {
+            request.emit_asm = true;
+         }
+         else if(key == "shutdown" && value.empty())
+         {
+            request.shutdown = true;
+         }
+         else
+         {
+            error = "Unknown request line : " + line;
+            return false;
+         }
+      }
+
+      if(request.source.empty() && !request.shutdown)
+      {
+         error = "Request did not name a source file";
+         return false;
+      }
+
+      if(!request.source.empty() && request.output.empty())
+      {
+         request.output = std::filesystem::path(request.source).replace_extension().string();
+      }
+      return true;
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   bool DEL_Server::compile(const Request & request)
+   {
+      // Everything the last request left behind is dropped, but the storage behind it is kept
+      driver.reset();
+
+      diagnostics.str("");
+      diagnostics.clear();
+
+      driver.set_asm_output(request.emit_asm);
+      driver.set_output_name(request.output);
+
+      // A request that fails in a way the driver doesn't report, like a failed allocation or an
+      // unusable output path, fails only that request
+      try
+      {
+         for(auto & path : request.include_paths)
+         {
+            driver.add_include_path(path);
+         }
+
+         return driver.parse(request.source.c_str());
+      }
+      catch( CompilationFailure & )
+      {
+         return false;
+      }
+      catch( std::exception & e )
+      {
+         diagnostics << "Unexpected failure : " << e.what() << std::endl;
+         return false;
+      }
+   }
+
+   // ----------------------------------------------------------
+   //
+   // ----------------------------------------------------------
+
+   void DEL_Server::respond(int connection, bool succeeded, const std::string & text)
+   {
+      std::string response = (succeeded) ? "ok\n" : "failed\n";
+      response += text;
+
+      // If the client has already gone there is nobody to tell
+      send_all(connection, response.data(), response.size());
+   }
+}
@@ -0,0 +1,75 @@
+#ifndef __DELSERVER_HPP__
+#define __DELSERVER_HPP__ 1
+
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include "del_driver.hpp"
+
+namespace DEL
+{
+   //!\brief Keeps a compiler resident and compiles files on request over a local unix socket.
+   //!       One driver serves every request, so interned names, allocated storage, builtin ASM
+   //!       and preprocessed files that haven't changed on disk carry over from one to the next
+   //!
+   //!       A request is a set of lines ended by a blank line (or the client closing its side) :
+   //!
+   //!          source <path>     File to compile. Required
+   //!          include <path>    Directory to search for use statements. May be repeated
+   //!          output <path>     Path and name of the outputs without extension. Defaults to the source
+   //!                            without its extension
+   //!          asm               Keep the generated ASM next to the binary
+   //!          shutdown          Stop the server once this request has been answered
+   //!
+   //!       Relative paths are taken from the server's working directory. The server answers with
+   //!       "ok" or "failed" on the first line, followed by any diagnostics, and closes the connection
+   class DEL_Server
+   {
+   public:
+
+      //! \brief Create a server
+      //! \param socket_path Path of the socket to listen on
+      DEL_Server(std::string socket_path);
+
+      //! \brief Stop listening and remove the socket
+      ~DEL_Server();
+
+      DEL_Server(const DEL_Server&) = delete;
+      DEL_Server& operator=(const DEL_Server&) = delete;
+
+      //! \brief Serve requests, one at a time, until a shutdown request or SIGINT / SIGTERM
+      //! \returns 0 if the server ran, 1 if it could not listen on the socket
+      int serve();
+
+   private:
+
+      struct Request
+      {
+         std::string source;
+         std::vector<std::string> include_paths;
+         std::string output;
+         bool emit_asm = false;
+         bool shutdown = false;
+      };
+
+      bool listen_on_socket();
+
+      //! \brief Read and parse a request
+      //! \returns false with the reason in error if the request could not be used
+      bool read_request(int connection, Request & request, std::string & error);
+
+      //! \brief Compile what a request asks for
+      //! \returns true if the outputs were written
+      bool compile(const Request & request);
+
+      void respond(int connection, bool succeeded, const std::string & text);
+
+      std::string socket_path;
+      int listener;
+
+      std::ostringstream diagnostics;  // Errors of the request being served
+      DEL::DEL_Driver driver;
+   };
+}
+#endif
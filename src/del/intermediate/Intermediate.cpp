@@ -1,53 +1,22 @@
 #include "Intermediate.hpp"
 
-#include <sstream>
-#include <iterator>
+#include <cstdint>
 #include <vector>
-#include <iostream>
 #include <libnabla/endian.hpp>
 #include <libnabla/util.hpp>
 #include "CodegenTypes.hpp"
-#include "EnDecode.hpp"
+#include "Errors.hpp"
 #include "SystemSettings.hpp"
 
-#define N_UNUSED(x) (void)x;
-
 namespace DEL
 {
     namespace
     {
-        template<typename Numeric>
-        inline static bool is_number(const std::string& s)
-        {
-            Numeric n;
-            return((std::istringstream(s) >> n >> std::ws).eof());
-        }
+        typedef CODEGEN::TYPES::InstructionSet Op;
 
-        bool is_only_number(std::string v)
+        bool is_unary(Op op)
         {
-            try
-            {
-                double value = std::stod(v);
-                N_UNUSED(value)
-                return true;
-            }
-            catch(std::exception& e)
-            {
-                // Its not a number
-            }
-            return false;
-        }
-
-        std::vector<std::string> split(std::string s, char c)
-        {
-            std::string segment;
-            std::vector<std::string> list;
-            std::stringstream ss(s);
-            while(std::getline(ss, segment, c))
-            {
-                list.push_back(segment);
-            }
-            return list;
+            return op == Op::BW_NOT || op == Op::NEGATE || op == Op::RETURN;
         }
     }
 
@@ -55,8 +24,8 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    Intermediate::Intermediate(Memory & memory_man, Codegen & code_gen) : 
-            memory_man(memory_man), code_gen(code_gen)
+    Intermediate::Intermediate(Memory & memory_man, Codegen & code_gen, Interner & interner) : 
+            memory_man(memory_man), code_gen(code_gen), interner(interner)
     {
 
     }
@@ -145,13 +114,12 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    void Intermediate::issue_direct_call(std::string encoded_call)
+    void Intermediate::issue_direct_call(const INTERMEDIATE::TYPES::Directive & call)
     {
         // Create the command
         CODEGEN::TYPES::Command command;
 
-        // We know its a call directive, so we pass it to build directive
-        build_assignment_directive(command, encoded_call, 1);
+        build_call_directive(command, call);
 
         // Because the standard case is to expect a return value, we need to edit the command before
         // We send it off
@@ -161,7 +129,7 @@ namespace DEL
         c->expect_return_value = false;
 
         // Execute the call command
-        code_gen.execute_command(command);
+        code_gen.execute_command(std::move(command));
     }
 
     // ----------------------------------------------------------
@@ -205,9 +173,7 @@ namespace DEL
                 break;
             }
             default:
-                std::cerr << "DEFAULT accessed in determining loop type in Intermediate::issue_start_loop()" << std::endl;
-                exit(EXIT_FAILURE);
-                break;
+                throw InternalError("Intermediate::issue_start_loop()", "DEFAULT accessed in determining loop type");
         }
     }
 
@@ -228,9 +194,7 @@ namespace DEL
                 cglt = CODEGEN::TYPES::LoopType::WHILE; 
                 break;
             default:
-                std::cerr << "DEFAULT accessed in determining loop type in Intermediate::issue_start_loop()" << std::endl;
-                exit(EXIT_FAILURE);
-                break;
+                throw InternalError("Intermediate::issue_end_loop()", "DEFAULT accessed in determining loop type");
         }
 
         code_gen.end_loop(cglt);
@@ -240,49 +204,27 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    void Intermediate::issue_assignment(std::string id, bool requires_ds_allocation, Memory::MemAlloc memory_info, INTERMEDIATE::TYPES::AssignmentClassifier classification, std::string postfix_expression)
-    {
-        // Build the instruction set
-        CODEGEN::TYPES::Command command = encode_postfix_assignment_expression(requires_ds_allocation, memory_info, classification, postfix_expression);
-        command.id = id;
-
-        // Issue the command
-        code_gen.execute_command(command);
-
-        // Clean out the instructions
-        for(auto & i : command.instructions)
-        {
-            delete i;
-        }
-    }
-
-    // ----------------------------------------------------------
-    //
-    // ----------------------------------------------------------
-
-    CODEGEN::TYPES::Command Intermediate::encode_postfix_assignment_expression(bool rdsa, Memory::MemAlloc memory_info,  INTERMEDIATE::TYPES::AssignmentClassifier classification, std::string expression)
+    void Intermediate::issue_assignment(std::string id, bool requires_ds_allocation, Memory::MemAlloc memory_info, INTERMEDIATE::TYPES::AssignmentClassifier classification, const INTERMEDIATE::TYPES::Expression & expression)
     {
-        // Build the expression into a string vector
-        std::istringstream buf(expression);
-        std::istream_iterator<std::string> beg(buf), end;
-        std::vector<std::string> tokens(beg, end);
-
-        // Build instructions for command
-        CODEGEN::TYPES::Command command;
+        // Items that fit a word are held in their frame slot, so only larger ones need space in the DS Device
+        bool rdsa = requires_ds_allocation && !Memory::is_frame_resident(memory_info.bytes_requested);
 
-        command = build_assignment(rdsa, classification, tokens, memory_info.bytes_requested);
+        // Build the instruction set from the expression, with what can be known now worked out
+        CODEGEN::TYPES::Command command = build_assignment(rdsa, classification, fold(classification, expression), memory_info.bytes_requested);
+        command.id = id;
 
         // Information regarding where to store result
         command.memory_info = memory_info;
 
-        return command;
+        // Issue the command - codegen takes ownership of the instructions
+        code_gen.execute_command(std::move(command));
     }
     
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    CODEGEN::TYPES::Command Intermediate::build_assignment(bool rdsa, INTERMEDIATE::TYPES::AssignmentClassifier & classification, std::vector<std::string> & tokens, uint64_t byte_len)
+    CODEGEN::TYPES::Command Intermediate::build_assignment(bool rdsa, INTERMEDIATE::TYPES::AssignmentClassifier & classification, const INTERMEDIATE::TYPES::Expression & expression, uint64_t byte_len)
     {
         CODEGEN::TYPES::Command command;
 
@@ -292,32 +234,42 @@ namespace DEL
         case INTERMEDIATE::TYPES::AssignmentClassifier::CHAR:    command.classification = CODEGEN::TYPES::DataClassification::INTEGER; break;
         case INTERMEDIATE::TYPES::AssignmentClassifier::INTEGER: command.classification = CODEGEN::TYPES::DataClassification::INTEGER; break;
         case INTERMEDIATE::TYPES::AssignmentClassifier::DOUBLE:  command.classification = CODEGEN::TYPES::DataClassification::DOUBLE;  break;
-        default: std::cerr << "Devloper Error >>> Intermediate::encode_postfix_assignment_expression() classification switch reached default : " << std::endl;
-                 exit(EXIT_FAILURE);
-                 break;
+        default: throw InternalError("Intermediate::build_assignment()", "Developer Error : classification switch reached default");
         }
 
-        // Check all tokens for what they represent
-        for(auto & token : tokens)
+        // Each item becomes an instruction, in order
+        for(auto & item : expression.items)
         {
-            // Check for a directive
-            if(token[0] == '#')
-            {
-                build_assignment_directive(command, token, byte_len);
-            }
-            // Check for char || int || double (raw values)
-            else if(token[0] == '"' || is_only_number(token) )
-            {
-                command.instructions.push_back(
-                    new CODEGEN::TYPES::RawValueInstruction(CODEGEN::TYPES::InstructionSet::USE_RAW, decompose_primitive(classification, token), byte_len)
-                );
-            }
-            else
+            switch(item.type)
             {
-                // Get the operation token
-                command.instructions.push_back(
-                    new CODEGEN::TYPES::BaseInstruction(get_operation(token))
-                );
+                case INTERMEDIATE::TYPES::ExpressionItemType::VALUE:
+                {
+                    command.instructions.push_back(
+                        new CODEGEN::TYPES::RawValueInstruction(CODEGEN::TYPES::InstructionSet::USE_RAW, decompose_primitive(classification, item), byte_len)
+                    );
+                    break;
+                }
+                case INTERMEDIATE::TYPES::ExpressionItemType::IDENTIFIER:
+                {
+                    command.instructions.push_back(
+                        new CODEGEN::TYPES::AddressValueInstruction(CODEGEN::TYPES::InstructionSet::LOAD,
+                            memory_man.get_slot_info(item.slot).start_pos, byte_len
+                        )
+                    );
+                    break;
+                }
+                case INTERMEDIATE::TYPES::ExpressionItemType::CALL:
+                {
+                    build_call_directive(command, expression.calls[item.call]);
+                    break;
+                }
+                case INTERMEDIATE::TYPES::ExpressionItemType::OPERATION:
+                {
+                    command.instructions.push_back(
+                        new CODEGEN::TYPES::BaseInstruction(item.operation)
+                    );
+                    break;
+                }
             }
         }
 
@@ -343,28 +295,44 @@ namespace DEL
     }
 
     // ----------------------------------------------------------
-    // 
+    //
     // ----------------------------------------------------------
 
-    uint64_t Intermediate::decompose_primitive(INTERMEDIATE::TYPES::AssignmentClassifier & classification, std::string value)
+    bool Intermediate::fold_integer(CODEGEN::TYPES::InstructionSet op, uint64_t lhs, uint64_t rhs, uint64_t & result)
     {
-        switch(classification)
+        int64_t l = static_cast<int64_t>(lhs);
+        int64_t r = static_cast<int64_t>(rhs);
+
+        switch(op)
         {
-            case INTERMEDIATE::TYPES::AssignmentClassifier::CHAR:
-            {
-                return ENDIAN::conditional_to_le_64(static_cast<uint64_t>(value[1]));
-            }
-            case INTERMEDIATE::TYPES::AssignmentClassifier::INTEGER:
-            {
-                return ENDIAN::conditional_to_le_64(std::stoull(value));
-            }
-            case INTERMEDIATE::TYPES::AssignmentClassifier::DOUBLE:
-            {
-                return ENDIAN::conditional_to_le_64(UTIL::convert_double_to_uint64(std::stod(value)));
-            }
-            default: std::cerr << "Devloper Error >>> Intermediate::decompose_primitive() classification switch reached default : " << std::endl;
-                exit(EXIT_FAILURE);
-                break;
+            case Op::ADD:    result = lhs + rhs; return true;
+            case Op::SUB:    result = lhs - rhs; return true;
+            case Op::MUL:    result = lhs * rhs; return true;
+            case Op::DIV:
+                if(r == 0 || (l == INT64_MIN && r == -1)) { return false; }
+                result = static_cast<uint64_t>(l / r);
+                return true;
+            case Op::LSH:
+                if(rhs > 63) { return false; }
+                result = lhs << rhs;
+                return true;
+            case Op::RSH:
+                if(rhs > 63 || l < 0) { return false; }
+                result = lhs >> rhs;
+                return true;
+            case Op::BW_AND: result = lhs & rhs; return true;
+            case Op::BW_OR:  result = lhs | rhs; return true;
+            case Op::BW_XOR: result = lhs ^ rhs; return true;
+            case Op::LT:     result = (l <  r); return true;
+            case Op::GT:     result = (l >  r); return true;
+            case Op::LTE:    result = (l <= r); return true;
+            case Op::GTE:    result = (l >= r); return true;
+            case Op::EQ:     result = (l == r); return true;
+            case Op::NE:     result = (l != r); return true;
+            case Op::AND:    result = (l > 0 && r > 0); return true;
+            case Op::OR:     result = (l > 0 || r > 0); return true;
+            default:
+                return false;
         }
     }
 
@@ -372,90 +340,228 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    void Intermediate::build_assignment_directive(CODEGEN::TYPES::Command & command, std::string directive_token, uint64_t byte_len)
+    bool Intermediate::fold_real(CODEGEN::TYPES::InstructionSet op, double lhs, double rhs, double & result)
     {
-        EnDecode endecode(memory_man);
+        switch(op)
+        {
+            case Op::ADD: result = lhs + rhs; return true;
+            case Op::SUB: result = lhs - rhs; return true;
+            case Op::MUL: result = lhs * rhs; return true;
+            case Op::DIV:
+                if(rhs == 0.0) { return false; }
+                result = lhs / rhs;
+                return true;
+            default:
+                return false;
+        }
+    }
 
-        INTERMEDIATE::TYPES::Directive directive = endecode.decode_directive(directive_token);
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
 
-        // Figure out what type the directive is directing us to do
-        switch(directive.type)
+    INTERMEDIATE::TYPES::Expression Intermediate::fold(INTERMEDIATE::TYPES::AssignmentClassifier classification, const INTERMEDIATE::TYPES::Expression & expression)
+    {
+        bool is_double = (classification == INTERMEDIATE::TYPES::AssignmentClassifier::DOUBLE);
+
+        // A sub-expression already written to the result, starting at 'begin' and running to the end of the
+        // items written so far, or to the start of the sub-expression after it
+        struct Operand
         {
-            // Handle an ID
-            case INTERMEDIATE::TYPES::DirectiveType::ID:
+            std::size_t begin;
+            bool is_constant;       // A single VALUE item
+            bool has_effect;        // Has a call, or something that may stop the VM, and can't be dropped
+            Memory::Slot slot;      // Set if a single IDENTIFIER item
+        };
+
+        INTERMEDIATE::TYPES::Expression result;
+        result.calls = expression.calls;
+
+        std::vector<Operand> operands;
+
+        // Integers are promoted in double expressions, the same way decompose_primitive does it
+        auto real_of = [&](const Operand & o) {
+            const INTERMEDIATE::TYPES::ExpressionItem & item = result.items[o.begin];
+            return (item.value_type == ValType::REAL) ? item.real : static_cast<double>(item.integer);
+        };
+        auto integer_of = [&](const Operand & o) {
+            return result.items[o.begin].integer;
+        };
+        auto is_value = [&](const Operand & o, int value) {
+            return o.is_constant && ((is_double) ? real_of(o) == value : integer_of(o) == static_cast<uint64_t>(value));
+        };
+        auto is_same_identifier = [&](const Operand & l, const Operand & r) {
+            return l.slot != Memory::NO_SLOT && l.slot == r.slot;
+        };
+
+        // Replace everything from 'begin' on with a single value
+        auto set_integer = [&](Operand & o, uint64_t value) {
+            result.items.resize(o.begin);
+            result.add_integer(ValType::INTEGER, value);
+            o = Operand{ o.begin, true, false, Memory::NO_SLOT };
+        };
+        auto set_real = [&](Operand & o, double value) {
+            result.items.resize(o.begin);
+            result.add_real(value);
+            o = Operand{ o.begin, true, false, Memory::NO_SLOT };
+        };
+
+        for(auto & item : expression.items)
+        {
+            switch(item.type)
             {
-                command.instructions.push_back(
-                    new CODEGEN::TYPES::AddressValueInstruction(CODEGEN::TYPES::InstructionSet::LOAD,
-                        directive.allocation[0].start_pos, byte_len
-                    )
-                );
-                break;
+                case INTERMEDIATE::TYPES::ExpressionItemType::VALUE:
+                    operands.push_back(Operand{ result.items.size(), true, false, Memory::NO_SLOT });
+                    result.items.push_back(item);
+                    continue;
+
+                case INTERMEDIATE::TYPES::ExpressionItemType::IDENTIFIER:
+                    operands.push_back(Operand{ result.items.size(), false, false, item.slot });
+                    result.items.push_back(item);
+                    continue;
+
+                case INTERMEDIATE::TYPES::ExpressionItemType::CALL:
+                    operands.push_back(Operand{ result.items.size(), false, true, Memory::NO_SLOT });
+                    result.items.push_back(item);
+                    continue;
+
+                case INTERMEDIATE::TYPES::ExpressionItemType::OPERATION:
+                    break;
             }
 
-            // Handle a call
-            case INTERMEDIATE::TYPES::DirectiveType::CALL:
+            Op op = item.operation;
+
+            if(is_unary(op))
             {
-                // Go through call and create CODEGEN::TYPES::MoveInstructions to move
-                // local variables to the parameter passing zone
-                uint64_t param_gs_slot = SETTINGS::GS_FRAME_OFFSET_RESERVE * SETTINGS::SYSTEM_WORD_SIZE_BYTES;
-                for(auto & d : directive.allocation)
+                Operand & x = operands.back();
+                if(x.is_constant && !is_double && op == Op::BW_NOT)
                 {
-                    command.instructions.push_back(
-                        new CODEGEN::TYPES::MoveInstruction(CODEGEN::TYPES::InstructionSet::MOVE_ADDRESS,
-                            param_gs_slot,
-                            d.start_pos,
-                            d.end_pos - d.start_pos
-                        )
-                    );
-                    param_gs_slot += SETTINGS::SYSTEM_WORD_SIZE_BYTES;
+                    set_integer(x, ~integer_of(x));
+                    continue;
+                }
+                if(x.is_constant && !is_double && op == Op::NEGATE)
+                {
+                    set_integer(x, !(static_cast<int64_t>(integer_of(x)) > 0));
+                    continue;
                 }
 
-                // Call the function
-                command.instructions.push_back(
-                    new CODEGEN::TYPES::CallInstruction(CODEGEN::TYPES::InstructionSet::CALL, directive.data)
-                );
-                break;
+                result.items.push_back(item);
+                x = Operand{ x.begin, false, x.has_effect, Memory::NO_SLOT };
+                continue;
             }
 
-            default:
+            Operand r = operands.back();
+            operands.pop_back();
+            Operand & l = operands.back();
+
+            // Both sides known
+            if(l.is_constant && r.is_constant)
+            {
+                uint64_t integer = 0;
+                double real = 0.0;
+                if(is_double && fold_real(op, real_of(l), real_of(r), real))
+                {
+                    set_real(l, real);
+                    continue;
+                }
+                if(!is_double && fold_integer(op, integer_of(l), integer_of(r), integer))
+                {
+                    set_integer(l, integer);
+                    continue;
+                }
+            }
+
+            // Identities that leave the left side. x - 0 and x * 1 are exact for doubles too, x + 0 is not for -0
+            bool keep_lhs = (op == Op::MUL && is_value(r, 1)) ||
+                            (op == Op::DIV && is_value(r, 1)) ||
+                            (op == Op::SUB && is_value(r, 0));
+            bool keep_rhs = (op == Op::MUL && is_value(l, 1));
+            bool zero     = false;
+
+            if(!is_double)
+            {
+                bool keeps_either = (op == Op::ADD || op == Op::BW_OR || op == Op::BW_XOR);
+                keep_lhs |= (keeps_either && is_value(r, 0)) || ((op == Op::LSH || op == Op::RSH) && is_value(r, 0));
+                keep_rhs |= (keeps_either && is_value(l, 0));
+
+                // Anything thrown away must have no effect of its own
+                zero = ((op == Op::SUB || op == Op::BW_XOR) && is_same_identifier(l, r)) ||
+                       ((op == Op::MUL || op == Op::BW_AND) && ((is_value(r, 0) && !l.has_effect) || (is_value(l, 0) && !r.has_effect)));
+            }
+
+            if(zero)
             {
-                // Shouldn't ever happen 
-                std::cerr << "Developer Error >>> Intermediate was handed a wonky token from the EnDecoder" << std::endl;
-                exit(EXIT_FAILURE);
-                break; 
+                set_integer(l, 0);
+            }
+            else if(keep_lhs)
+            {
+                result.items.resize(r.begin);
+            }
+            else if(keep_rhs)
+            {
+                result.items.erase(result.items.begin() + l.begin, result.items.begin() + r.begin);
+                l = Operand{ l.begin, r.is_constant, r.has_effect, r.slot };
+            }
+            else
+            {
+                bool may_stop = (op == Op::DIV || op == Op::MOD || op == Op::POW);
+
+                result.items.push_back(item);
+                l = Operand{ l.begin, false, l.has_effect || r.has_effect || may_stop, Memory::NO_SLOT };
             }
         }
+
+        return result;
     }
 
     // ----------------------------------------------------------
     // 
     // ----------------------------------------------------------
 
-    CODEGEN::TYPES::InstructionSet Intermediate::get_operation(std::string token)
+    uint64_t Intermediate::decompose_primitive(INTERMEDIATE::TYPES::AssignmentClassifier & classification, const INTERMEDIATE::TYPES::ExpressionItem & value)
+    {
+        switch(classification)
+        {
+            case INTERMEDIATE::TYPES::AssignmentClassifier::CHAR:
+            case INTERMEDIATE::TYPES::AssignmentClassifier::INTEGER:
+            {
+                return ENDIAN::conditional_to_le_64(value.integer);
+            }
+            case INTERMEDIATE::TYPES::AssignmentClassifier::DOUBLE:
+            {
+                // Integers are promoted when they appear in a double expression
+                double d = (value.value_type == ValType::REAL) ? value.real : static_cast<double>(value.integer);
+
+                return ENDIAN::conditional_to_le_64(UTIL::convert_double_to_uint64(d));
+            }
+            default: throw InternalError("Intermediate::decompose_primitive()", "Developer Error : classification switch reached default");
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Intermediate::build_call_directive(CODEGEN::TYPES::Command & command, const INTERMEDIATE::TYPES::Directive & call)
     {
-        if(token == "ADD"   ) { return CODEGEN::TYPES::InstructionSet::ADD;    }
-        if(token == "SUB"   ) { return CODEGEN::TYPES::InstructionSet::SUB;    }
-        if(token == "MUL"   ) { return CODEGEN::TYPES::InstructionSet::MUL;    }
-        if(token == "DIV"   ) { return CODEGEN::TYPES::InstructionSet::DIV;    }
-        if(token == "MOD"   ) { return CODEGEN::TYPES::InstructionSet::MOD;    }
-        if(token == "POW"   ) { return CODEGEN::TYPES::InstructionSet::POW;    }
-        if(token == "LTE"   ) { return CODEGEN::TYPES::InstructionSet::LTE;    }
-        if(token == "LT"    ) { return CODEGEN::TYPES::InstructionSet::LT;     }
-        if(token == "GTE"   ) { return CODEGEN::TYPES::InstructionSet::GTE;    }
-        if(token == "GT"    ) { return CODEGEN::TYPES::InstructionSet::GT;     }
-        if(token == "EQ"    ) { return CODEGEN::TYPES::InstructionSet::EQ;     }
-        if(token == "NE"    ) { return CODEGEN::TYPES::InstructionSet::NE;     }
-        if(token == "LSH"   ) { return CODEGEN::TYPES::InstructionSet::LSH;    }
-        if(token == "RSH"   ) { return CODEGEN::TYPES::InstructionSet::RSH;    }
-        if(token == "NEGATE") { return CODEGEN::TYPES::InstructionSet::NEGATE; }
-        if(token == "OR"    ) { return CODEGEN::TYPES::InstructionSet::OR;     }
-        if(token == "AND"   ) { return CODEGEN::TYPES::InstructionSet::AND;    }
-        if(token == "BW_OR" ) { return CODEGEN::TYPES::InstructionSet::BW_OR;  }
-        if(token == "BW_XOR") { return CODEGEN::TYPES::InstructionSet::BW_XOR; }
-        if(token == "BW_AND") { return CODEGEN::TYPES::InstructionSet::BW_AND; }
-        if(token == "BW_NOT") { return CODEGEN::TYPES::InstructionSet::BW_NOT; }
-        if(token == "RETURN") { return CODEGEN::TYPES::InstructionSet::RETURN; }
-        std::cerr << "Developer error : Intermediate::InstructionSet Intermediate::get_integer_operation(std::string token)" << std::endl;
-        exit(EXIT_FAILURE);
+        // Go through call and create CODEGEN::TYPES::MoveInstructions to move
+        // local variables to the parameter passing zone
+        uint64_t param_gs_slot = SETTINGS::GS_FRAME_OFFSET_RESERVE * SETTINGS::SYSTEM_WORD_SIZE_BYTES;
+        for(auto & d : call.allocation)
+        {
+            command.instructions.push_back(
+                new CODEGEN::TYPES::MoveInstruction(CODEGEN::TYPES::InstructionSet::MOVE_ADDRESS,
+                    param_gs_slot,
+                    d.start_pos,
+                    d.end_pos - d.start_pos
+                )
+            );
+            param_gs_slot += SETTINGS::SYSTEM_WORD_SIZE_BYTES;
+        }
+
+        // Call the function
+        command.instructions.push_back(
+            new CODEGEN::TYPES::CallInstruction(CODEGEN::TYPES::InstructionSet::CALL, interner.name(call.target))
+        );
     }
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "Memory.hpp"
 #include "Codegen.hpp"
 #include "SymbolTable.hpp"
+#include "Interner.hpp"
 #include "Types.hpp"
 #include "IntermediateTypes.hpp"
 #include "CodegenTypes.hpp"
@@ -20,7 +21,7 @@ namespace DEL
     {
     public:
         //! \brief Create the Intermediate 
-        Intermediate(Memory & memory_man, Codegen & code_gen);
+        Intermediate(Memory & memory_man, Codegen & code_gen, Interner & interner);
 
         //! \brief Destruct the Intermediate
         ~Intermediate();
@@ -48,8 +49,8 @@ namespace DEL
         void issue_end_conditional_context();
 
         //! \brief Issue a call outside of an expression 
-        //! \param encoded_call A call instruction encoded by EnDecode
-        void issue_direct_call(std::string encoded_call);
+        //! \param call The call directive
+        void issue_direct_call(const INTERMEDIATE::TYPES::Directive & call);
         
         //! \brief Issue a loop
         //! \param loop The loop interface
@@ -63,22 +64,35 @@ namespace DEL
         //! \param requires_ds_allocation Indicate that the item needs to be allocated in the data store device
         //! \param memory_info The memory information for the resulting assignment
         //! \param classification The classification of the assignment
-        //! \param postfix_expression The expression to be computed
-        void issue_assignment(std::string id, bool requires_ds_allocation, Memory::MemAlloc memory_info, INTERMEDIATE::TYPES::AssignmentClassifier classification, std::string postfix_expression);
+        //! \param expression The expression to be computed
+        void issue_assignment(std::string id, bool requires_ds_allocation, Memory::MemAlloc memory_info, INTERMEDIATE::TYPES::AssignmentClassifier classification, const INTERMEDIATE::TYPES::Expression & expression);
+
+        //! \brief Fold the constant parts of an expression, and apply identities that don't change its result
+        //! \param classification The classification of the assignment the expression is for
+        //! \param expression The postfix expression
+        //! \returns The expression with everything that could be worked out replaced by its value
+        static INTERMEDIATE::TYPES::Expression fold(INTERMEDIATE::TYPES::AssignmentClassifier classification, const INTERMEDIATE::TYPES::Expression & expression);
+
+        //! \brief Work out an integer operation the way the VM would, leaving anything the VM might disagree
+        //!        with (division by zero, shifts out of range, shifting negative values right) to the VM
+        //! \returns true if the operation was worked out into result
+        static bool fold_integer(CODEGEN::TYPES::InstructionSet op, uint64_t lhs, uint64_t rhs, uint64_t & result);
+
+        //! \brief Work out a double operation. Only the arithmetic is folded, as comparisons of doubles leave
+        //!        an integer behind
+        //! \returns true if the operation was worked out into result
+        static bool fold_real(CODEGEN::TYPES::InstructionSet op, double lhs, double rhs, double & result);
 
     private:
-        CODEGEN::TYPES::Command encode_postfix_assignment_expression(bool rdsa, Memory::MemAlloc memory_info, INTERMEDIATE::TYPES::AssignmentClassifier classification, std::string expression);
-    
         Memory & memory_man;
         Codegen & code_gen;
+        Interner & interner;
 
-        void build_assignment_directive(CODEGEN::TYPES::Command & command, std::string directive_token, uint64_t byte_len);
-
-        uint64_t decompose_primitive(INTERMEDIATE::TYPES::AssignmentClassifier & classification, std::string value);
+        void build_call_directive(CODEGEN::TYPES::Command & command, const INTERMEDIATE::TYPES::Directive & call);
 
-        CODEGEN::TYPES::Command build_assignment(bool rdsa, INTERMEDIATE::TYPES::AssignmentClassifier & classification, std::vector<std::string> & tokens, uint64_t byte_len);
+        uint64_t decompose_primitive(INTERMEDIATE::TYPES::AssignmentClassifier & classification, const INTERMEDIATE::TYPES::ExpressionItem & value);
 
-        CODEGEN::TYPES::InstructionSet get_operation(std::string token);
+        CODEGEN::TYPES::Command build_assignment(bool rdsa, INTERMEDIATE::TYPES::AssignmentClassifier & classification, const INTERMEDIATE::TYPES::Expression & expression, uint64_t byte_len);
     };
 }
 
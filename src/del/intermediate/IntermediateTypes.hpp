@@ -2,6 +2,9 @@
 #define DEL_INTERMEDIATE_TYPES_HPP
 
 
+#include <string>
+#include <vector>
+#include "Types.hpp"
 #include "CodegenTypes.hpp" // Remove this once assignments are ported to codegen
 
 namespace DEL
@@ -17,12 +20,6 @@ namespace TYPES
         INTEGER, DOUBLE, CHAR //, STRUCT, STRING
     };
 
-    //! \brief A directive given for loading / calling
-    enum class DirectiveType
-    {
-        ID, CALL
-    };
-
     //! \brief Memory position of a directive
     struct DirectiveAllocation
     {
@@ -30,12 +27,88 @@ namespace TYPES
         uint64_t end_pos;
     };
 
-    //! \brief A directive
+    //! \brief A call directive - the function to call and where each of its arguments lives
     struct Directive
     {
-        DirectiveType type;
+        SymbolId target;
         std::vector<DirectiveAllocation> allocation;
-        std::string data;
+    };
+
+    //! \brief What an item of an expression holds
+    enum class ExpressionItemType
+    {
+        VALUE,          // A raw value
+        IDENTIFIER,     // A variable to load
+        CALL,           // A call whose result is used
+        OPERATION       // An operation on the items before it
+    };
+
+    //! \brief An item of an expression
+    struct ExpressionItem
+    {
+        ExpressionItemType type;
+        ValType value_type;                             // Type of a VALUE
+        union
+        {
+            CODEGEN::TYPES::InstructionSet operation;   // OPERATION
+            Memory::Slot slot;                          // IDENTIFIER
+            uint64_t call;                              // CALL, index into Expression::calls
+            uint64_t integer;                           // VALUE of type INTEGER or CHAR
+            double real;                                // VALUE of type REAL
+        };
+    };
+
+    //! \brief An expression in postfix order, built by the analyzer and consumed by the intermediate layer
+    struct Expression
+    {
+        std::vector<ExpressionItem> items;
+        std::vector<Directive> calls;                   // Calls referenced by CALL items
+
+        void add_operation(CODEGEN::TYPES::InstructionSet operation)
+        {
+            ExpressionItem item;
+            item.type = ExpressionItemType::OPERATION;
+            item.value_type = ValType::NONE;
+            item.operation = operation;
+            items.push_back(item);
+        }
+
+        void add_identifier(Memory::Slot slot)
+        {
+            ExpressionItem item;
+            item.type = ExpressionItemType::IDENTIFIER;
+            item.value_type = ValType::NONE;
+            item.slot = slot;
+            items.push_back(item);
+        }
+
+        void add_call(Directive call)
+        {
+            ExpressionItem item;
+            item.type = ExpressionItemType::CALL;
+            item.value_type = ValType::NONE;
+            item.call = calls.size();
+            items.push_back(item);
+            calls.push_back(std::move(call));
+        }
+
+        void add_integer(ValType type, uint64_t value)
+        {
+            ExpressionItem item;
+            item.type = ExpressionItemType::VALUE;
+            item.value_type = type;
+            item.integer = value;
+            items.push_back(item);
+        }
+
+        void add_real(double value)
+        {
+            ExpressionItem item;
+            item.type = ExpressionItemType::VALUE;
+            item.value_type = ValType::REAL;
+            item.real = value;
+            items.push_back(item);
+        }
     };
 
     //! \brief Parameter information for a function
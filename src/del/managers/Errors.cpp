@@ -9,7 +9,7 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    Errors::Errors(DEL_Driver & driver) : driver(driver)
+    Errors::Errors(DEL_Driver & driver) : driver(driver), stream(&std::cerr), throw_on_fatal(false)
     {
 
     }
@@ -27,14 +27,47 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
+    void Errors::set_batch_mode(std::ostream & out)
+    {
+        stream = &out;
+        throw_on_fatal = true;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    std::ostream & Errors::output()
+    {
+        return *stream;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Errors::fatal()
+    {
+        // Other compilations in the process carry on, so only this one is abandoned
+        if(throw_on_fatal)
+        {
+            throw CompilationFailure();
+        }
+        exit(EXIT_FAILURE);
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
     void Errors::report_previously_declared(std::string id, int line_no)
     {
-        display_error_start(true, line_no); std::cerr  << "Symbol \"" << id << "\" already defined" << std::endl;
+        display_error_start(true, line_no); output()  << "Symbol \"" << id << "\" already defined" << std::endl;
 
         std::string line = driver.preproc.fetch_line(line_no);
         display_line_and_error_pointer(line, line.size()/2, true, false);
 
-        exit(EXIT_FAILURE);
+        fatal();
     }
 
     // ----------------------------------------------------------
@@ -43,13 +76,13 @@ namespace DEL
 
     void Errors::report_unknown_id(std::string id, int line_no, bool is_fatal)
     {
-        display_error_start(is_fatal, line_no); std::cerr  << "Unknown ID \"" << id << "\"" << std::endl;
+        display_error_start(is_fatal, line_no); output()  << "Unknown ID \"" << id << "\"" << std::endl;
 
         std::string line = driver.preproc.fetch_line(line_no);
         display_line_and_error_pointer(line, line.size()/2, true, false);
         if(is_fatal)
         {
-            exit(EXIT_FAILURE);
+            fatal();
         }
     }
 
@@ -59,12 +92,12 @@ namespace DEL
 
     void Errors::report_out_of_memory(std::string symbol, uint64_t size, int max_memory)
     {
-        display_error_start(true); std::cerr  
+        display_error_start(true); output()  
                   << "Allocation of \"" << symbol << "\" (size:" << size 
                   << ") causes mapped memory to exceed target's maximum allowable memory of (" 
                   << max_memory << ") bytes.";
 
-        exit(EXIT_FAILURE);
+        fatal();
     }
 
     // ----------------------------------------------------------
@@ -73,11 +106,11 @@ namespace DEL
 
     void Errors::report_custom(std::string from, std::string error, bool is_fatal)
     {
-        display_error_start(is_fatal); std::cerr  << "[" << from << "]" << error << std::endl; 
+        display_error_start(is_fatal); output()  << "[" << from << "]" << error << std::endl; 
 
         if(is_fatal)
         {
-            exit(EXIT_FAILURE);
+            fatal();
         }        
     }
 
@@ -87,7 +120,7 @@ namespace DEL
 
     void Errors::report_unallowed_type(std::string id, int line_no, bool is_fatal)
     {
-        display_error_start(is_fatal, line_no); std::cerr  << "Type of \"" 
+        display_error_start(is_fatal, line_no); output()  << "Type of \"" 
                   << id 
                   << "\" Forbids current operation"
                   << std::endl;
@@ -99,7 +132,7 @@ namespace DEL
         }
         if(is_fatal)
         {
-            exit(EXIT_FAILURE);
+            fatal();
         }        
     }
 
@@ -109,10 +142,10 @@ namespace DEL
 
     void Errors::report_unable_to_open_result_out(std::string name_used, bool is_fatal)
     {
-        display_error_start(is_fatal); std::cerr  << "Unable to open \"" << name_used << "\" for resulting output!" << std::endl;
+        display_error_start(is_fatal); output()  << "Unable to open \"" << name_used << "\" for resulting output!" << std::endl;
         if(is_fatal)
         {
-            exit(EXIT_FAILURE);
+            fatal();
         } 
     }
 
@@ -122,10 +155,10 @@ namespace DEL
 
     void Errors::report_callee_doesnt_exist(std::string name_called, int line_no)
     {
-        display_error_start(true, line_no); std::cerr  << "Call to unknown function \"" << name_called << "\"" << std::endl;
+        display_error_start(true, line_no); output()  << "Call to unknown function \"" << name_called << "\"" << std::endl;
         std::string line = driver.preproc.fetch_line(line_no);
         display_line_and_error_pointer(line, line.size()/2, true, false);
-        exit(EXIT_FAILURE);
+        fatal();
     }
 
     // ----------------------------------------------------------
@@ -134,11 +167,11 @@ namespace DEL
 
     void Errors::report_mismatched_param_length(std::string caller, std::string callee, uint64_t caller_params, uint64_t callee_params, int line_no)
     {
-        display_error_start(true, line_no); std::cerr  << "Function \"" << callee << "\" expects (" << callee_params 
+        display_error_start(true, line_no); output()  << "Function \"" << callee << "\" expects (" << callee_params 
                   << ") parameters, but call from function \"" << caller << "\" gave (" << caller_params << ")" << std::endl;
         std::string line = driver.preproc.fetch_line(line_no);
         display_line_and_error_pointer(line, line.size()/2, true, false);
-        exit(EXIT_FAILURE);
+        fatal();
     }
 
     // ----------------------------------------------------------
@@ -147,18 +180,18 @@ namespace DEL
 
     void Errors::display_error_start(bool is_fatal, int line_no)
     {
-        std::cerr << "[" << termcolor::red << "Error" << termcolor::reset << "] <";
+        output() << "[" << termcolor::red << "Error" << termcolor::reset << "] <";
 
-        if(is_fatal){ std::cerr << termcolor::red    << "FATAL"   << termcolor::reset ;} 
-        else        { std::cerr << termcolor::yellow << "WARNING" << termcolor::reset ;} 
+        if(is_fatal){ output() << termcolor::red    << "FATAL"   << termcolor::reset ;} 
+        else        { output() << termcolor::yellow << "WARNING" << termcolor::reset ;} 
 
         if(line_no == 0)
         {
-            std::cerr << "> (" << termcolor::green  << driver.current_file_from_directive << termcolor::reset << ") : ";
+            output() << "> (" << termcolor::green  << driver.current_file_from_directive << termcolor::reset << ") : ";
         }
         else
         {
-            std::cerr << "> (" << termcolor::green   << driver.current_file_from_directive             << termcolor::reset << "@"
+            output() << "> (" << termcolor::green   << driver.current_file_from_directive             << termcolor::reset << "@"
                                << termcolor::magenta << driver.preproc.fetch_user_line_number(line_no) << termcolor::reset 
                                << ") : ";
         }
@@ -170,14 +203,14 @@ namespace DEL
 
     void Errors::report_calls_return_value_unhandled(std::string caller_function, std::string callee, int line_no, bool is_fatal)
     {
-        display_error_start(is_fatal, line_no); std::cerr  << "Function call to \"" << callee << "\" in function \"" << caller_function << "\" has a return value that is not handled" << std::endl;
+        display_error_start(is_fatal, line_no); output()  << "Function call to \"" << callee << "\" in function \"" << caller_function << "\" has a return value that is not handled" << std::endl;
 
         std::string line = driver.preproc.fetch_line(line_no);
         display_line_and_error_pointer(line, line.size()/2, false, false);
 
         if(is_fatal)
         {
-            exit(EXIT_FAILURE);
+            fatal();
         }  
     }
 
@@ -187,10 +220,10 @@ namespace DEL
 
     void Errors::report_no_return(std::string f, int line_no)
     {
-        display_error_start(true, line_no); std::cerr  << "Expected 'return <type>' for function :  " << f << std::endl;
+        display_error_start(true, line_no); output()  << "Expected 'return <type>' for function :  " << f << std::endl;
         std::string line = driver.preproc.fetch_line(line_no);
         display_line_and_error_pointer(line, line.size()/2, true, false);
-        exit(EXIT_FAILURE);
+        fatal();
     }
 
     // ----------------------------------------------------------
@@ -199,8 +232,8 @@ namespace DEL
 
     void Errors::report_no_main_function()
     {
-        display_error_start(true); std::cerr  << "No 'main' method found" << std::endl;
-        exit(EXIT_FAILURE);
+        display_error_start(true); output()  << "No 'main' method found" << std::endl;
+        fatal();
     }
 
     // ----------------------------------------------------------
@@ -209,7 +242,7 @@ namespace DEL
 
     void Errors::report_syntax_error(int line, int column, std::string error_message, std::string line_in_question)
     {
-        display_error_start(true, line); std::cerr  << error_message << std::endl;
+        display_error_start(true, line); output()  << error_message << std::endl;
         display_line_and_error_pointer(line_in_question, column, true);
     }
 
@@ -219,10 +252,10 @@ namespace DEL
 
     void Errors::report_range_invalid_start_gt_end(int line_no, std::string start, std::string end)
     {
-        display_error_start(true, line_no); std::cerr << "Start position greater than end position in given range" << std::endl;
+        display_error_start(true, line_no); output() << "Start position greater than end position in given range" << std::endl;
          std::string line = driver.preproc.fetch_line(line_no);
         display_line_and_error_pointer(line, line.size()/2, true, false);
-        exit(EXIT_FAILURE);
+        fatal();
     }
 
     // ----------------------------------------------------------
@@ -231,10 +264,10 @@ namespace DEL
 
     void Errors::report_range_ineffective(int line_no, std::string start, std::string end)
     {
-        display_error_start(true, line_no); std::cerr << "Range does nothing" << std::endl;
+        display_error_start(true, line_no); output() << "Range does nothing" << std::endl;
          std::string line = driver.preproc.fetch_line(line_no);
         display_line_and_error_pointer(line, line.size()/2, true, false);
-        exit(EXIT_FAILURE);
+        fatal();
     }
 
     // ----------------------------------------------------------
@@ -243,10 +276,10 @@ namespace DEL
 
     void Errors::report_invalid_step(int line_no)
     {
-        display_error_start(true, line_no); std::cerr << "Step is ineffective" << std::endl;
+        display_error_start(true, line_no); output() << "Step is ineffective" << std::endl;
          std::string line = driver.preproc.fetch_line(line_no);
         display_line_and_error_pointer(line, line.size()/2, true, false);
-        exit(EXIT_FAILURE);
+        fatal();
     }
 
     // ----------------------------------------------------------
@@ -255,18 +288,18 @@ namespace DEL
 
     void Errors::report_preproc_file_read_fail(std::vector<std::string> include_crumbs, std::string file_in_question)
     {
-        display_error_start(true); std::cerr  << "Unable to open file : " << file_in_question << std::endl;
+        display_error_start(true); output()  << "Unable to open file : " << file_in_question << std::endl;
 
         if(include_crumbs.size() > 0)
         {
-            std::cerr << std::endl << "Include history:" << std::endl;
+            output() << std::endl << "Include history:" << std::endl;
         }
 
         for(auto i = include_crumbs.rbegin(); i != include_crumbs.rend(); i++)
         {
-            std::cerr << "\t " << (*i) << std::endl;
+            output() << "\t " << (*i) << std::endl;
         }
-        exit(EXIT_FAILURE);
+        fatal();
     }
 
     // ----------------------------------------------------------
@@ -275,8 +308,8 @@ namespace DEL
 
     void Errors::report_preproc_include_path_not_dir(std::string path)
     {
-        display_error_start(true); std::cerr  << "Given include path does not exist : " << path << std::endl;
-        exit(EXIT_FAILURE);
+        display_error_start(true); output()  << "Given include path does not exist : " << path << std::endl;
+        fatal();
     }
 
     // ----------------------------------------------------------
@@ -285,8 +318,8 @@ namespace DEL
 
     void Errors::report_preproc_file_not_found(std::string info, std::string file, std::string from)
     {
-        display_error_start(true); std::cerr  << info << " \"" << file << "\" " << "requested by \"" << from  << "\"" << std::endl;
-        exit(EXIT_FAILURE);
+        display_error_start(true); output()  << info << " \"" << file << "\" " << "requested by \"" << from  << "\"" << std::endl;
+        fatal();
     }
 
     // ----------------------------------------------------------
@@ -298,8 +331,8 @@ namespace DEL
         // Weird case
         if(line.size() == 1)
         {
-            std::cerr << termcolor::white << line << termcolor::reset << std::endl;
-            std::cerr << termcolor::red << "^" << termcolor::reset << std::endl;
+            output() << termcolor::white << line << termcolor::reset << std::endl;
+            output() << termcolor::red << "^" << termcolor::reset << std::endl;
             return;
         }
 
@@ -349,15 +382,15 @@ namespace DEL
             }
         }
 
-        std::cerr << termcolor::white << line << termcolor::reset << std::endl;
+        output() << termcolor::white << line << termcolor::reset << std::endl;
 
         if(is_fatal)
         {
-            std::cerr << termcolor::red << pointer_line << termcolor::reset << std::endl;
+            output() << termcolor::red << pointer_line << termcolor::reset << std::endl;
         }
         else 
         {
-            std::cerr << termcolor::yellow << pointer_line << termcolor::reset << std::endl;
+            output() << termcolor::yellow << pointer_line << termcolor::reset << std::endl;
         }
     }
 }
\ No newline at end of file
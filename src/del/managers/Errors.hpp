@@ -1,7 +1,11 @@
 #ifndef DEL_ERRORS_HPP
 #define DEL_ERRORS_HPP
 
+#include <exception>
+#include <ostream>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <stdint.h>
 #include <vector>
 
@@ -9,6 +13,25 @@ namespace DEL
 {
     class DEL_Driver;
 
+    //! \brief Thrown by a fatal error while the error manager is in batch mode
+    class CompilationFailure : public std::exception
+    {
+    public:
+        const char * what() const noexcept override { return "Compilation failed"; }
+    };
+
+    //! \brief Thrown by a developer error found where there is no error manager to report it, such as
+    //!        in a code block or a function being lowered on a worker thread. The code generator and
+    //!        the driver catch it and report it as a fatal error
+    class InternalError : public std::runtime_error
+    {
+    public:
+        InternalError(std::string from, const std::string & error) : std::runtime_error(error), from(std::move(from)) {}
+
+        //! \brief Where the error originates
+        const std::string from;
+    };
+
     //! \class Errors
     //! \brief This is the primary error handler for the compiler. It has a handful of specific error messages
     //!        that we can tell use to trigger fatals. I would like to extend this for different output levels.
@@ -22,6 +45,14 @@ namespace DEL
         //! \brief Deconstruct the error object
         ~Errors();
 
+        //! \brief Use the error manager for one of many compilations in a process
+        //! \param out The stream to write errors to, in place of std::cerr
+        //! \post Fatal errors throw CompilationFailure rather than triggering exit
+        void set_batch_mode(std::ostream & out);
+
+        //! \brief Get the stream errors are written to. This is std::cerr unless in batch mode
+        std::ostream & output();
+
         //! \brief Report that something has already been declared
         //! \param id The thing that has already been declared
         //! \param line_no Line number
@@ -129,6 +160,10 @@ namespace DEL
 
     private:
         DEL_Driver & driver;
+        std::ostream * stream;
+        bool throw_on_fatal;
+
+        [[noreturn]] void fatal();
 
         void display_error_start(bool is_fatal, int line_no=0);
         void display_line_and_error_pointer(std::string line, int column, bool is_fatal, bool show_arrow=true);
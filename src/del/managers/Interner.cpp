@@ -0,0 +1,34 @@
+#include "Interner.hpp"
+
+namespace DEL
+{
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    SymbolId Interner::intern(std::string_view name)
+    {
+        auto it = ids.find(name);
+
+        if(it != ids.end())
+        {
+            return it->second;
+        }
+
+        SymbolId id = static_cast<SymbolId>(names.size());
+
+        names.emplace_back(name);
+        ids.emplace(names.back(), id);
+
+        return id;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    const std::string & Interner::name(SymbolId id) const
+    {
+        return names[id];
+    }
+}
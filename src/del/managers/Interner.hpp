@@ -0,0 +1,36 @@
+#ifndef DEL_INTERNER_HPP
+#define DEL_INTERNER_HPP
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "Types.hpp"
+
+namespace DEL
+{
+    //! \class Interner
+    //! \brief Hands out a dense SymbolId for each distinct identifier so the managers can
+    //!        key on integers. Names are stored once and live as long as the interner
+    class Interner
+    {
+    public:
+
+        //! \brief Get the id of a name, interning it if it has not been seen
+        //! \param name The name
+        //! \returns Id of the name
+        SymbolId intern(std::string_view name);
+
+        //! \brief Get the name of an interned id
+        //! \param id The id, as given by intern
+        //! \returns The name the id was interned from
+        const std::string & name(SymbolId id) const;
+
+    private:
+
+        std::deque<std::string> names;                          // Names by id, stable addresses
+        std::unordered_map<std::string_view, SymbolId> ids;     // Views into names
+    };
+}
+
+#endif
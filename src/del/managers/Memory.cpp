@@ -1,6 +1,7 @@
 #include "Memory.hpp"
+#include "Errors.hpp"
 
-#include <iostream>
+#include <string>
 
 namespace DEL
 {
@@ -26,24 +27,40 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    bool Memory::is_id_mapped(std::string id)
+    bool Memory::is_id_mapped(SymbolId id) const
     {
-        if(memory_map.find(id) != memory_map.end())
-        {
-            return true;
-        }
-        return false;
+        return get_slot(id) != NO_SLOT;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    Memory::Slot Memory::get_slot(SymbolId id) const
+    {
+        return (id < symbol_slots.size()) ? symbol_slots[id] : NO_SLOT;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    const Memory::MemAlloc & Memory::get_slot_info(Slot slot) const
+    {
+        return allocations[slot];
     }
 
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    Memory::MemAlloc Memory::get_mem_info(std::string id)
+    Memory::MemAlloc Memory::get_mem_info(SymbolId id) const
     {
-        if(memory_map.find(id) != memory_map.end())
+        Slot slot = get_slot(id);
+
+        if(slot != NO_SLOT)
         {
-            return memory_map[id];
+            return allocations[slot];
         }
 
         //std::cout << "MEM : " << id << " not found " << std::endl;
@@ -66,7 +83,13 @@ namespace DEL
 
     void Memory::reset()
     {
-        memory_map.clear();
+        // Only touch the ids this function used so a reset doesn't scale with the program
+        for(auto & id : owners)
+        {
+            symbol_slots[id] = NO_SLOT;
+        }
+        allocations.clear();
+        owners.clear();
         currently_allocated_bytes = 0;
     }
 
@@ -74,11 +97,12 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    void Memory::remove_item(std::string id)
+    void Memory::remove_item(SymbolId id)
     {
-        if(is_id_mapped(id))
+        // The slot itself is kept so its bytes stay accounted for
+        if(id < symbol_slots.size())
         {
-            memory_map.erase(memory_map.find(id));
+            symbol_slots[id] = NO_SLOT;
         }
     }
 
@@ -86,33 +110,40 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    bool Memory::alloc_mem(std::string id, uint64_t required_size)
+    Memory::Slot Memory::alloc_mem(SymbolId id, uint64_t required_size)
     {
         if((currently_allocated_bytes + required_size) > MAX_GLOBAL_MEMORY )
         {
-            return false;
+            return NO_SLOT;
         }
 
         // Safety check during development
         if(required_size % SETTINGS::SYSTEM_WORD_SIZE_BYTES != 0)
         {
-            std::cerr << "Memory Manager > Required size for [" << id << "] is does not conform to word boundary" << std::endl;
-            exit(EXIT_FAILURE);
+            throw InternalError("Memory Manager", "Required size for [symbol " + std::to_string(id) + "] does not conform to word boundary");
         }
 
         MemAlloc allocated; 
 
         allocated.bytes_requested = required_size;
-        allocated.bytes_alloced   = SETTINGS::SYSTEM_WORD_SIZE_BYTES;   // We only need to actually store address into DS Device
+        allocated.bytes_alloced   = SETTINGS::SYSTEM_WORD_SIZE_BYTES;   // Word sized items are held in place, anything larger by its DS Device address
 
         allocated.start_pos = currently_allocated_bytes;
 
         currently_allocated_bytes += SETTINGS::SYSTEM_WORD_SIZE_BYTES;
 
-        memory_map[id] = allocated;
+        Slot slot = static_cast<Slot>(allocations.size());
 
-        return true;
-    }
+        allocations.push_back(allocated);
+        owners.push_back(id);
+
+        if(id >= symbol_slots.size())
+        {
+            symbol_slots.resize(id + 1, NO_SLOT);
+        }
+        symbol_slots[id] = slot;
 
+        return slot;
+    }
 
 }
\ No newline at end of file
@@ -1,9 +1,9 @@
 #ifndef DEL_MEMORY_HPP
 #define DEL_MEMORY_HPP
 
-#include <map>
-#include <string>
+#include <vector>
 #include "SystemSettings.hpp"
+#include "Types.hpp"
 #include <libnabla/VSysSettings.hpp>
 
 namespace DEL
@@ -34,15 +34,40 @@ namespace DEL
             uint64_t start_pos;         //! Start position of element in memory
         };
 
+        //! \brief Check if an item of the given size lives directly in its frame slot
+        //! \param bytes Bytes requested for the item
+        //! \retval True if the frame slot holds the value, false if it holds the address of the value in the DS Device
+        static constexpr bool is_frame_resident(uint64_t bytes)
+        {
+            return bytes <= SETTINGS::SYSTEM_WORD_SIZE_BYTES;
+        }
+
+        //! \brief Dense index of an allocation within the current function
+        typedef uint32_t Slot;
+
+        //! \brief Slot given for ids that are not mapped
+        static constexpr Slot NO_SLOT = UINT32_MAX;
+
         //! \brief Check if a given id is mapped
         //! \param id The ID to check if mapped
         //! \retval True if mapped, false otherwise
-        bool is_id_mapped(std::string id);
+        bool is_id_mapped(SymbolId id) const;
+
+        //! \brief Retrieve the slot an id was allocated into
+        //! \param id The ID to get the slot of
+        //! \returns Slot of the id, NO_SLOT if it isn't mapped
+        Slot get_slot(SymbolId id) const;
+
+        //! \brief Retrieve memory information of a slot
+        //! \param slot A slot given by get_slot() that is still mapped
+        //! \retval Memalloc object
+        const MemAlloc & get_slot_info(Slot slot) const;
 
         //! \brief Retrieve memory information of a given object
         //! \retval Memalloc object
         //! \note This method returns {0,0,0} if item not found. Check is_id_mapped() first
-        MemAlloc get_mem_info(std::string id);
+        //! \note Name based shim over get_slot() and get_slot_info()
+        MemAlloc get_mem_info(SymbolId id) const;
 
         //! \brief Retrieve the number of allocated bytes for the current function
         //! \returns Bytes allocated for function
@@ -51,7 +76,7 @@ namespace DEL
         //! \brief Remove a particular id
         //! \param Removes symbol from table if it exists while keeping its impact on the 
         //!        number of bytes allocated to ensure no errors in writing memory locations
-        void remove_item(std::string id);
+        void remove_item(SymbolId id);
 
         //! \brief Clear the memory map of all contents and reset the position counter
         //! \note This is called by the Analyzer as soon as a function is done generating
@@ -63,10 +88,13 @@ namespace DEL
     private:
 
         // Allocate some memory. Only the symbol table accesses this
-        bool alloc_mem(std::string id, uint64_t required_size);
+        // Returns the slot allocated into, NO_SLOT if out of memory
+        Slot alloc_mem(SymbolId id, uint64_t required_size);
 
         uint64_t currently_allocated_bytes;
-        std::map<std::string, MemAlloc> memory_map;
+        std::vector<MemAlloc> allocations;  // By slot
+        std::vector<SymbolId> owners;       // By slot, the id each slot was allocated for
+        std::vector<Slot> symbol_slots;     // By id, dense since ids come from the interner
     };
 }
 
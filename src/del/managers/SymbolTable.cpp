@@ -1,5 +1,7 @@
 #include "SymbolTable.hpp"
 #include <iostream>
+#include <algorithm>
+#include <utility>
 namespace DEL
 {
 
@@ -7,8 +9,9 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    SymbolTable::SymbolTable(Errors & error_man, Memory & mm) : error_man(error_man),
+    SymbolTable::SymbolTable(Errors & error_man, Memory & mm, Interner & interner) : error_man(error_man),
                                                                 memory_man(mm),
+                                                                interner(interner),
                                                                 is_locked(false),
                                                                 unique_counter(0)
     {
@@ -28,7 +31,22 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    void SymbolTable::new_context(std::string name, bool remove_previous)
+    void SymbolTable::reset()
+    {
+        scopes.clear();
+        entries.clear();
+        index.clear();
+        signatures.clear();
+
+        is_locked = false;
+        unique_counter = 0;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void SymbolTable::new_context(SymbolId name, bool remove_previous)
     {
         if(is_locked) { error_man.report_custom("SymbolTable", "Symbol table has been locked by the code generator", true); }
 
@@ -37,55 +55,55 @@ namespace DEL
             remove_current_context();
         }
 
-        contexts.push_back(new Context(name));
+        scopes.push_back(Scope{ name, static_cast<uint32_t>(entries.size()) });
     }
 
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    bool SymbolTable::does_symbol_exist(std::string symbol, bool show_if_found)
+    bool SymbolTable::does_symbol_exist(SymbolId symbol, bool show_if_found)
     {
         if(is_locked) { error_man.report_custom("SymbolTable", "Symbol table has been locked by the code generator", true); }
         
-        for(auto & c : contexts)
+        const Entry * entry = find_entry(symbol);
+
+        if(entry == nullptr)
         {
-            if(c != nullptr)
-            {
-                if(c->symbol_map.find(symbol) != c->symbol_map.end())
-                {
-                    if(show_if_found)
-                    {
-                        std::cout << "\"" << symbol 
-                                  << "\" found in context \"" 
-                                  << c->context_name 
-                                  << "\" defined as : " 
-                                  << ValType_to_string(c->symbol_map[symbol])
-                                  << std::endl;
-                    }
-                    return true;
-                }
-            }
+            return false;
         }
-        return false;
+
+        if(show_if_found)
+        {
+            error_man.output() << "\"" << interner.name(symbol) 
+                               << "\" found in context \"" 
+                               << interner.name(scopes[entry->scope].name) 
+                               << "\" defined as : " 
+                               << ValType_to_string(entry->type)
+                               << std::endl;
+        }
+        return true;
     }
 
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    bool SymbolTable::does_context_exist(std::string context)
+    bool SymbolTable::does_context_exist(SymbolId context)
     {
         if(is_locked) { error_man.report_custom("SymbolTable", "Symbol table has been locked by the code generator", true); }
         
-        for(auto & c : contexts)
+        if(does_function_exist(context))
+        {
+            return true;
+        }
+
+        // Only the scopes currently open are kept, so this is bounded by nesting depth
+        for(auto & scope : scopes)
         {
-            if(c != nullptr)
+            if(scope.name == context)
             {
-                if(c->context_name == context)
-                {
-                    return true;
-                }
+                return true;
             }
         }
         return false;
@@ -95,45 +113,27 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    std::vector<FunctionParam> SymbolTable::get_context_parameters(std::string context)
+    bool SymbolTable::does_function_exist(SymbolId function) const
     {
-        if(is_locked) { error_man.report_custom("SymbolTable", "Symbol table has been locked by the code generator", true); }
-
-        for(auto & c : contexts)
-        {
-            if(c != nullptr)
-            {
-                if(c->context_name == context)
-                {
-                    return c->context_parameters;
-                }
-            }
-        }
-        error_man.report_custom("SymbolTable", "Developer error: Asked to get parameters from a context that did not exist", true);
-
-        return std::vector<FunctionParam>(); // For the compiler
+        return signatures.find(function) != signatures.end();
     }
 
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    void SymbolTable::clear_existing_context(std::string context)
+    const std::vector<FunctionParam> & SymbolTable::get_function_parameters(SymbolId function)
     {
         if(is_locked) { error_man.report_custom("SymbolTable", "Symbol table has been locked by the code generator", true); }
-        
-        for(auto & c : contexts)
+
+        auto it = signatures.find(function);
+
+        if(it == signatures.end())
         {
-            if(c != nullptr)
-            {
-                if(c->context_name == context)
-                {
-                    c->symbol_map.clear();
-                    return;
-                }
-            }
+            error_man.report_custom("SymbolTable", "Developer error: Asked to get parameters from a function that did not exist", true);
         }
-        error_man.report_custom("SymbolTable", "Developer error: Asked to clear existing context, but that context did not exist", true);
+
+        return it->second.params;
     }
 
     // ----------------------------------------------------------
@@ -143,18 +143,16 @@ namespace DEL
     void SymbolTable::remove_current_context()
     {
         // Don't allow the removal of the global context
-        if(contexts.size() > 1)
+        if(scopes.size() > 1)
         {
-            Context * ciq = contexts.back();
-
             // Remove symbols from map for reuse
-            for(auto & el : ciq->symbol_map)
+            for(uint32_t i = scopes.back().first_entry; i < entries.size(); i++)
             {
-                memory_man.remove_item(el.first);
+                memory_man.remove_item(entries[i].symbol);
             }
 
-            delete ciq;
-            contexts.pop_back();
+            pop_scope_entries();
+            scopes.pop_back();
         }
     }
 
@@ -162,47 +160,56 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    bool SymbolTable::is_existing_symbol_of_type(std::string symbol, ValType type)
+    void SymbolTable::pop_scope_entries()
     {
-        if(is_locked) { error_man.report_custom("SymbolTable", "Symbol table has been locked by the code generator", true); }
-        
-        for(auto & c : contexts)
+        uint32_t first_entry = scopes.back().first_entry;
+
+        while(entries.size() > first_entry)
         {
-            if(c != nullptr)
-            {
-                if(c->symbol_map.find(symbol) != c->symbol_map.end())
-                {
-                    if(c->symbol_map[symbol] == type)
-                    {
-                        return true;
-                    }
-                    else
-                    {
-                        return false;
-                    }
-                }
-            }
+            index.head(entries.back().symbol) = NO_ENTRY;
+            entries.pop_back();
         }
-        return false;
     }
 
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    void SymbolTable::add_symbol(std::string symbol, DEL::ValType type, uint64_t memory)
+    bool SymbolTable::is_existing_symbol_of_type(SymbolId symbol, ValType type)
+    {
+        if(is_locked) { error_man.report_custom("SymbolTable", "Symbol table has been locked by the code generator", true); }
+        
+        const Entry * entry = find_entry(symbol);
+
+        return (entry != nullptr) && (entry->type == type);
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void SymbolTable::add_symbol(SymbolId symbol, DEL::ValType type, uint64_t memory)
     {
         if(is_locked) { error_man.report_custom("SymbolTable", "Symbol table has been locked by the code generator", true); }
         
-        contexts.back()->symbol_map[symbol] = type;
+        uint32_t & head = index.head(symbol);
+
+        // Memory is keyed by symbol, so a visible name can't be given a second allocation
+        if(head != NO_ENTRY)
+        {
+            error_man.report_custom("SymbolTable", " Symbol \"" + interner.name(symbol) + "\" is already declared", true);
+        }
+
+        entries.push_back(Entry{ symbol, type, static_cast<uint32_t>(scopes.size() - 1) });
+        head = static_cast<uint32_t>(entries.size() - 1);
 
         // A stop-gap to ensure we know why things break as stuff is expanded
         if(memory > 0 && memory != 8)
         {
-            std::cerr << "You just attempted to allocate \"" << memory << "\" bytes of memory "
-                      << "indicating that more complex types are being written. You're seeing this "
-                      << "because codegen is not yet able to handle non-word aligned bytes. " 
-                      << "This now needs to be supported. Thank you!";
+            error_man.output() << "You just attempted to allocate \"" << memory << "\" bytes of memory "
+                               << "indicating that more complex types are being written. You're seeing this "
+                               << "because codegen is not yet able to handle non-word aligned bytes. " 
+                               << "This now needs to be supported. Thank you!";
             error_man.report_custom("SymbolTable", "Requires further development", true);
         }
 
@@ -240,14 +247,14 @@ namespace DEL
         // Safety check - If things are build correctly by compiler this should never happen
         if(memory_man.is_id_mapped(symbol))
         {
-            std::cerr << "DEVELOPER ERROR : The symbol \" " << symbol << "\" was previously mapped within the memory manager" << std::endl;
+            error_man.output() << "DEVELOPER ERROR : The symbol \" " << interner.name(symbol) << "\" was previously mapped within the memory manager" << std::endl;
             error_man.report_custom("SymbolTable", "Item given to symbol table already exists within the memory map. This is a developer error", true);
         }
 
         // Attempt to 'allocate' memory
-        if(!memory_man.alloc_mem(symbol, mem_request))
+        if(memory_man.alloc_mem(symbol, mem_request) == Memory::NO_SLOT)
         {
-            error_man.report_out_of_memory(symbol, memory, Memory::MAX_GLOBAL_MEMORY);
+            error_man.report_out_of_memory(interner.name(symbol), memory, Memory::MAX_GLOBAL_MEMORY);
         }
     }
 
@@ -255,82 +262,62 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    void SymbolTable::add_parameters_to_current_context(std::vector<FunctionParam> params)
+    void SymbolTable::add_function_signature(SymbolId function, std::vector<FunctionParam> params, ValType return_type)
     {
-        contexts.back()->context_parameters.clear();
-        contexts.back()->context_parameters = params;
+        if(is_locked) { error_man.report_custom("SymbolTable", "Symbol table has been locked by the code generator", true); }
+
+        Signature & signature = signatures[function];
+        signature.params = std::move(params);
+        signature.return_type = return_type;
     }
 
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    DEL::ValType SymbolTable::get_value_type(std::string symbol)
+    DEL::ValType SymbolTable::get_value_type(SymbolId symbol)
     {
         if(is_locked) { error_man.report_custom("SymbolTable", "Symbol table has been locked by the code generator", true); }
         
-        for(auto & c : contexts)
-        {
-            if(c != nullptr)
-            {
-                if(c->symbol_map.find(symbol) != c->symbol_map.end())
-                {
-                    return c->symbol_map[symbol];
-                }
-            }
-        }
-        return ValType::NONE;
-    }
+        const Entry * entry = find_entry(symbol);
 
-    // ----------------------------------------------------------
-    //
-    // ----------------------------------------------------------
-
-    void SymbolTable::add_return_type_to_current_context(DEL::ValType type)
-    {
-        contexts.back()->return_type = type;
+        return (entry != nullptr) ? entry->type : ValType::NONE;
     }
 
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    DEL::ValType SymbolTable::get_return_type_of_context(std::string context)
+    DEL::ValType SymbolTable::get_function_return_type(SymbolId function)
     {
         if(is_locked) { error_man.report_custom("SymbolTable", "Symbol table has been locked by the code generator", true); }
 
-        for(auto & c : contexts)
+        auto it = signatures.find(function);
+
+        if(it == signatures.end())
         {
-            if(c != nullptr)
-            {
-                if(c->context_name == context)
-                {
-                    return c->return_type;
-                }
-            }
+            error_man.report_custom("SymbolTable", "Developer error: Asked to get the return type of a function that did not exist", true);
         }
 
-        error_man.report_custom("SymbolTable", "Developer error: Asked to get parameters from a context that did not exist", true);
-
-        return ValType::NONE; // For the compiler
+        return it->second.return_type;
     }
 
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    std::string SymbolTable::get_current_context_name() const
+    SymbolId SymbolTable::get_current_context_name() const
     {
         if(is_locked) { error_man.report_custom("SymbolTable", "Symbol table has been locked by the code generator", true); }
         
-        return contexts.back()->context_name;
+        return scopes.back().name;
     }
 
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    std::string SymbolTable::generate_unique_return_symbol()
+    SymbolId SymbolTable::generate_unique_return_symbol()
     {
         return generate_unique("__return__assignment__");
     }
@@ -339,7 +326,7 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    std::string SymbolTable::generate_unique_call_param_symbol()
+    SymbolId SymbolTable::generate_unique_call_param_symbol()
     {
         return generate_unique("__call__param__");
     }
@@ -348,7 +335,7 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    std::string SymbolTable::generate_unique_variable_symbol()
+    SymbolId SymbolTable::generate_unique_variable_symbol()
     {
         return generate_unique("__artifical__variable__");
     }
@@ -357,16 +344,16 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    std::string SymbolTable::generate_unique_context()
+    SymbolId SymbolTable::generate_unique_context()
     {
         std::string start = "__artificial__context__";
-        std::string context_name = start + std::to_string(unique_counter);
+        SymbolId context_name = interner.intern(start + std::to_string(unique_counter));
 
         uint64_t stop_count = 0;
         while(does_context_exist(context_name))
         {
             unique_counter++;
-            context_name = start + std::to_string(unique_counter);
+            context_name = interner.intern(start + std::to_string(unique_counter));
 
             stop_count++;
             if(stop_count == 2048)
@@ -383,9 +370,9 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    std::string SymbolTable::generate_unique(std::string start)
+    SymbolId SymbolTable::generate_unique(const std::string & start)
     {
-        std::string unique_label = start + std::to_string(unique_counter);
+        SymbolId unique_label = interner.intern(start + std::to_string(unique_counter));
 
         // Whis should never happen unless a user decides to use "__return__assignment__" as a variable name, which I guess we COULD deny, but why would we? 
         // its a perfectly good name.
@@ -393,7 +380,7 @@ namespace DEL
         while(does_symbol_exist(unique_label, false))
         {
             unique_counter++;
-            unique_label = start + std::to_string(unique_counter);
+            unique_label = interner.intern(start + std::to_string(unique_counter));
 
             stop_count++;
             if(stop_count == 2048)
@@ -416,4 +403,114 @@ namespace DEL
         
         is_locked = true;
     }
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    const SymbolTable::Entry * SymbolTable::find_entry(SymbolId symbol) const
+    {
+        uint32_t entry = index.find(symbol);
+
+        return (entry == NO_ENTRY) ? nullptr : &entries[entry];
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    SymbolTable::Index::Index() : slots(64, Slot{ NO_SYMBOL, NO_ENTRY }), used(0)
+    {
+
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    uint32_t SymbolTable::Index::probe_start(SymbolId symbol) const
+    {
+        // Ids are dense, so scatter them with a multiplicative hash before masking
+        return static_cast<uint32_t>((symbol * 2654435761u) & (slots.size() - 1));
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    uint32_t SymbolTable::Index::find(SymbolId symbol) const
+    {
+        uint32_t mask = static_cast<uint32_t>(slots.size() - 1);
+
+        for(uint32_t i = probe_start(symbol); ; i = (i + 1) & mask)
+        {
+            if(slots[i].symbol == symbol)    { return slots[i].entry; }
+            if(slots[i].symbol == NO_SYMBOL) { return NO_ENTRY;       }
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    uint32_t & SymbolTable::Index::head(SymbolId symbol)
+    {
+        // Keep the load under a half so probes stay short. Slots are never removed, a symbol
+        // that leaves scope keeps its slot with an empty chain for the next time it is declared
+        if((used + 1) * 2 > slots.size())
+        {
+            grow();
+        }
+
+        uint32_t mask = static_cast<uint32_t>(slots.size() - 1);
+
+        uint32_t i = probe_start(symbol);
+        while(slots[i].symbol != symbol && slots[i].symbol != NO_SYMBOL)
+        {
+            i = (i + 1) & mask;
+        }
+
+        if(slots[i].symbol == NO_SYMBOL)
+        {
+            slots[i].symbol = symbol;
+            used++;
+        }
+        return slots[i].entry;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void SymbolTable::Index::clear()
+    {
+        std::fill(slots.begin(), slots.end(), Slot{ NO_SYMBOL, NO_ENTRY });
+        used = 0;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void SymbolTable::Index::grow()
+    {
+        std::vector<Slot> old = std::move(slots);
+        slots.assign(old.size() * 2, Slot{ NO_SYMBOL, NO_ENTRY });
+
+        uint32_t mask = static_cast<uint32_t>(slots.size() - 1);
+
+        for(auto & slot : old)
+        {
+            if(slot.symbol == NO_SYMBOL)
+            {
+                continue;
+            }
+
+            uint32_t i = probe_start(slot.symbol);
+            while(slots[i].symbol != NO_SYMBOL)
+            {
+                i = (i + 1) & mask;
+            }
+            slots[i] = slot;
+        }
+    }
 }
\ No newline at end of file
@@ -2,11 +2,12 @@
 #define DEL_SYMBOL_TABLE_HPP
 
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <string>
 #include "Ast.hpp"
 #include "Memory.hpp"
 #include "Errors.hpp"
+#include "Interner.hpp"
 
 namespace DEL
 {
@@ -21,60 +22,65 @@ namespace DEL
         //!\brief Setup a symbol table
         //!\param error_man The error manager
         //!\param memory_man The memory manager
-        SymbolTable(Errors & error_man, Memory & memory_man);
+        //!\param interner The interner that symbols and context names are drawn from
+        SymbolTable(Errors & error_man, Memory & memory_man, Interner & interner);
 
         //!\brief Destruct table
         ~SymbolTable();
 
+        //! \brief Forget every context, symbol and function signature so the table can be
+        //!        used for another program. Storage is kept for reuse
+        void reset();
+
         //! \brief Create a new named context
         //! \param name The name of the context
         //! \param remove_previous If true, the current context will be removed from knowledge base
-        void new_context(std::string name, bool remove_previous=false);
+        void new_context(SymbolId name, bool remove_previous=false);
 
         //! \brief Check if a symbol exists
         //! \param symbol The symbol to check for
         //! \param show_if_found Displays symbol information if true
         //! \retval True if exists, false otherwise
-        bool does_symbol_exist(std::string symbol, bool show_if_found=false);
+        bool does_symbol_exist(SymbolId symbol, bool show_if_found=false);
 
         //! \brief Check if a context exits
         //! \param context The context name to check for
+        //! \retval True if a function or an open scope has the name, false otherwise
+        bool does_context_exist(SymbolId context);
+
+        //! \brief Check if a function has been declared
+        //! \param function The function name to check for
         //! \retval True if exists, false otherwise
-        bool does_context_exist(std::string context);
+        bool does_function_exist(SymbolId function) const;
 
         //! \brief Check if a symbol is a given type
         //! \param symbol The symbol to check
         //! \param type The type to check
         //! \retval True if is type, false otherwise (including if the symbol doesn't exist)
-        bool is_existing_symbol_of_type(std::string symbol, ValType type);
+        bool is_existing_symbol_of_type(SymbolId symbol, ValType type);
 
-        //! \brief Add a symbol to the current context
+        //! \brief Add a symbol to the current context. Declaring a symbol that is already visible
+        //!        from the current context is a fatal error
         //! \param symbol The symbol to add
         //! \param type The value type to add as
         //! \param memory How much memory to ask for, if 0 (default) the default amount
         //!        of memory for the type will be asked for, if there is a default
-        void add_symbol(std::string symbol, DEL::ValType type, uint64_t memory=0);
-
-        //! \brief Add parameters to the current context
-        //! \param params The parameters to add to the context
-        //! \note  This assumes that parameters don't yet exist. If they do, they'll be overwritten
-        void add_parameters_to_current_context(std::vector<FunctionParam> params);
-
-        //! \brief Get the parameters for a given context
-        //! \param context The name of the context to get the parameters of
-        std::vector<FunctionParam> get_context_parameters(std::string context);
+        void add_symbol(SymbolId symbol, DEL::ValType type, uint64_t memory=0);
 
-        //! \brief Add a return type to the current context
-        //! \param type The type that the context is expected to return
-        void add_return_type_to_current_context(ValType type);
+        //! \brief Record the signature of a function so later calls can be checked against it
+        //! \param function The function name
+        //! \param params The parameters of the function
+        //! \param return_type The type that the function is expected to return
+        //! \note  This assumes that the function doesn't yet exist. If it does, it'll be overwritten
+        void add_function_signature(SymbolId function, std::vector<FunctionParam> params, ValType return_type);
 
-        //! \brief Get the return type of the given context
-        //! \param context The context name to get the return type of
-        ValType get_return_type_of_context(std::string context);
+        //! \brief Get the parameters of a declared function
+        //! \param function The name of the function to get the parameters of
+        const std::vector<FunctionParam> & get_function_parameters(SymbolId function);
 
-        //! \brief Clear the existing context of all symbols
-        //! \param context The context to clear
-        void clear_existing_context(std::string context);
+        //! \brief Get the return type of a declared function
+        //! \param function The function name to get the return type of
+        ValType get_function_return_type(SymbolId function);
 
         //! \brief Remove the current operating context 
         //! \post  This will remove all information regarding current context,
@@ -86,27 +92,27 @@ namespace DEL
         //! \brief Retrieve the data type of a symbol
         //! \param symbol The symbol to check for
         //! \returns Type of the given symbol, DEL::ValType::NONE if it doesn't exist
-        DEL::ValType get_value_type(std::string symbol);
+        DEL::ValType get_value_type(SymbolId symbol);
 
         //! \brief Get the name of the current context
-        //! \returns String of the current context name
-        std::string get_current_context_name() const;
+        //! \returns Id of the current context name
+        SymbolId get_current_context_name() const;
 
         //! \brief Generate a unique symbol for a return
         //! \returns Unique symbol to use as a return item in assignment
-        std::string generate_unique_return_symbol();
+        SymbolId generate_unique_return_symbol();
 
         //! \brief Generate a unique symbol for a raw item in a function call
         //! \returns Unique symbol to use as a call parameter in a call
-        std::string generate_unique_call_param_symbol();
+        SymbolId generate_unique_call_param_symbol();
 
         //! \brief Generate a unique symbol for an artificial variable
         //! \returns Unique symbol to use as a variable name
-        std::string generate_unique_variable_symbol();
+        SymbolId generate_unique_variable_symbol();
 
         //! \brief Generate a unique context name
         //! \returns Unique symbol to use as a context
-        std::string generate_unique_context();
+        SymbolId generate_unique_context();
 
         friend Codegen;
 
@@ -114,6 +120,7 @@ namespace DEL
 
         Errors & error_man;
         Memory & memory_man;
+        Interner & interner;
         
         bool is_locked;
         uint64_t unique_counter;
@@ -122,19 +129,71 @@ namespace DEL
         // lock functionality. Once we get things done this should be removed.
         void lock();
 
-        std::string generate_unique(std::string start);
+        SymbolId generate_unique(const std::string & start);
 
-        class Context
+        static constexpr uint32_t NO_ENTRY = UINT32_MAX;
+
+        // A symbol living in a scope. Entries are stacked in declaration order so a scope
+        // owns the contiguous run starting at its first_entry. Memory is keyed by symbol alone,
+        // so a name is declared at most once across the open scopes
+        struct Entry
         {
-        public:
-            Context(std::string name) : context_name(name), return_type(ValType::NONE) {}
-            std::string context_name;
-            std::map< std::string, DEL::ValType > symbol_map; 
-            std::vector<FunctionParam> context_parameters;
+            SymbolId symbol;
+            ValType  type;
+            uint32_t scope;
+        };
+
+        struct Scope
+        {
+            SymbolId name;
+            uint32_t first_entry;
+        };
+
+        struct Signature
+        {
+            std::vector<FunctionParam> params;
             ValType return_type;
         };
 
-        std::vector<Context * > contexts; 
+        // Open addressed (linear probe) map from a symbol to its entry
+        class Index
+        {
+        public:
+            Index();
+
+            //! \brief Get the entry of a symbol, NO_ENTRY if it isn't in scope
+            uint32_t find(SymbolId symbol) const;
+
+            //! \brief Get the head slot of a symbol, inserting an empty one if needed
+            uint32_t & head(SymbolId symbol);
+
+            //! \brief Empty every slot, keeping the table size
+            void clear();
+
+        private:
+            struct Slot
+            {
+                SymbolId symbol;
+                uint32_t entry;
+            };
+
+            std::vector<Slot> slots;
+            uint32_t used;
+
+            uint32_t probe_start(SymbolId symbol) const;
+            void grow();
+        };
+
+        std::vector<Scope> scopes;
+        std::vector<Entry> entries;
+        Index index;
+
+        std::unordered_map<SymbolId, Signature> signatures;
+
+        const Entry * find_entry(SymbolId symbol) const;
+
+        // Unlink and release every entry of the innermost scope
+        void pop_scope_entries();
     };
 }
 
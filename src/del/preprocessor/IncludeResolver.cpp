@@ -0,0 +1,125 @@
+#include "IncludeResolver.hpp"
+
+#include <filesystem>
+#include <system_error>
+#include <sys/stat.h>
+
+namespace DEL
+{
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool IncludeResolver::add_directory(const std::string & path)
+    {
+        std::error_code ec;
+        if(!std::filesystem::is_directory(std::filesystem::path(path), ec))
+        {
+            return false;
+        }
+
+        std::string key = canonical(path);
+        if(known_directories.insert(key).second)
+        {
+            auto found = listings.try_emplace(key, Listing{ -1, false, {} }).first;
+            directories.push_back({path, &found->second});
+        }
+        return true;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool IncludeResolver::resolve(const std::string & file, std::string & path)
+    {
+        for(auto & dir : directories)
+        {
+            if(!dir.listing->checked)
+            {
+                refresh(dir);
+            }
+
+            if(dir.listing->files.find(file) != dir.listing->files.end())
+            {
+                path = (std::filesystem::path(dir.path) / file).string();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool IncludeResolver::mark_included(const std::string & path)
+    {
+        return included.insert(canonical(path)).second;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void IncludeResolver::reset()
+    {
+        directories.clear();
+        known_directories.clear();
+        included.clear();
+
+        for(auto & entry : listings)
+        {
+            entry.second.checked = false;
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void IncludeResolver::refresh(const Directory & dir)
+    {
+        Listing & listing = *dir.listing;
+        listing.checked = true;
+
+        // Adding or removing a file changes the directory, so an unchanged directory keeps its listing
+        struct stat info;
+        int64_t modified = (::stat(dir.path.c_str(), &info) == 0) ?
+                static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec : -1;
+
+        if(modified >= 0 && modified == listing.modified)
+        {
+            return;
+        }
+
+        listing.modified = modified;
+        listing.files.clear();
+
+        std::error_code ec;
+        for(auto & entry : std::filesystem::directory_iterator(std::filesystem::path(dir.path), ec))
+        {
+            std::error_code entry_ec;
+            if(entry.is_regular_file(entry_ec))
+            {
+                listing.files.insert(entry.path().filename().string());
+            }
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    std::string IncludeResolver::canonical(const std::string & path) const
+    {
+        std::error_code ec;
+        std::filesystem::path result = std::filesystem::canonical(std::filesystem::path(path), ec);
+        if(ec)
+        {
+            // Fall back to a lexical normalisation if the path can't be resolved on disk
+            result = std::filesystem::absolute(std::filesystem::path(path), ec).lexically_normal();
+        }
+        return result.string();
+    }
+}
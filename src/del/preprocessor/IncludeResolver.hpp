@@ -0,0 +1,64 @@
+#ifndef DEL_INCLUDE_RESOLVER_HPP
+#define DEL_INCLUDE_RESOLVER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace DEL
+{
+    //! \brief Locates files named by use statements and tracks which files have been included.
+    //!        Directories are canonicalised once and their listings cached, so each lookup
+    //!        is a hash probe rather than a stat per search path. Listings outlive reset(), and
+    //!        are only read again if the directory has changed since
+    class IncludeResolver
+    {
+    public:
+        //! \brief Add a directory to search, ignoring directories already added
+        //! \param path The directory
+        //! \returns false if the path is not a directory
+        bool add_directory(const std::string & path);
+
+        //! \brief Find a file within the search directories, in the order they were added
+        //! \param file The file name given to the use statement
+        //! \param path [out] The path to the file, formed from the search directory as given
+        //! \returns true if the file was found
+        bool resolve(const std::string & file, std::string & path);
+
+        //! \brief Mark a file as included
+        //! \param path Path to the file
+        //! \returns false if the file (by canonical path) was already included
+        bool mark_included(const std::string & path);
+
+        //! \brief Forget the search directories and included files, ready for another compilation
+        //! \post Directory listings are kept
+        void reset();
+
+    private:
+
+        struct Listing
+        {
+            int64_t modified;                           // Modification time of the directory when listed
+            bool checked;                               // Compared against the directory since the last reset
+            std::unordered_set<std::string> files;      // Regular files within the directory
+        };
+
+        struct Directory
+        {
+            std::string path;                           // Path as given
+            Listing * listing;
+        };
+
+        std::string canonical(const std::string & path) const;
+        void refresh(const Directory & dir);
+
+        std::vector<Directory> directories;             // Directories in search order
+        std::unordered_map<std::string, Listing> listings;  // Canonical path -> listing, kept across resets
+        std::unordered_set<std::string> known_directories;  // Canonical paths of the search directories
+        std::unordered_set<std::string> included;       // Canonical paths of included files
+    };
+}
+
+#endif
@@ -0,0 +1,93 @@
+#include "MappedFile.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace DEL
+{
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    MappedFile::MappedFile(std::string path) : opened(false),
+                                               mapping(nullptr),
+                                               mapping_size(0)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+        {
+            return;
+        }
+
+        struct stat info;
+        if(::fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+        {
+            // Empty files can't be mapped, but they are still perfectly readable
+            if(info.st_size == 0)
+            {
+                ::close(fd);
+                opened = true;
+                return;
+            }
+
+            void * addr = (static_cast<size_t>(info.st_size) < MAP_THRESHOLD) ? MAP_FAILED :
+                            ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(addr != MAP_FAILED)
+            {
+                ::close(fd);
+                mapping      = addr;
+                mapping_size = info.st_size;
+                opened       = true;
+                return;
+            }
+        }
+        ::close(fd);
+
+        // Small, or not something we can map, so read it into memory
+        std::ifstream in_file(path, std::ios::in | std::ios::binary);
+        if(!in_file.good())
+        {
+            return;
+        }
+        fallback.assign(std::istreambuf_iterator<char>(in_file), std::istreambuf_iterator<char>());
+        opened = true;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    MappedFile::~MappedFile()
+    {
+        if(mapping != nullptr)
+        {
+            ::munmap(mapping, mapping_size);
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool MappedFile::is_open() const
+    {
+        return opened;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    std::string_view MappedFile::contents() const
+    {
+        if(mapping != nullptr)
+        {
+            return std::string_view(static_cast<const char*>(mapping), mapping_size);
+        }
+        return std::string_view(fallback);
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef DEL_MAPPED_FILE_HPP
+#define DEL_MAPPED_FILE_HPP
+
+#include <string>
+#include <string_view>
+
+namespace DEL
+{
+    //! \brief A read-only view of a file's contents. Large files are memory-mapped where possible,
+    //!        anything else is read into an owned buffer. A mapping faults with SIGBUS if the file is
+    //!        truncated while it is in use, so only files big enough to be worth it are mapped
+    class MappedFile
+    {
+    public:
+        //! \brief Files smaller than this are read rather than mapped
+        static constexpr size_t MAP_THRESHOLD = 256 * 1024;
+
+        //! \brief Create a mapped file
+        //! \param path The file to map
+        MappedFile(std::string path);
+
+        //! \brief Unmap the file
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        //! \brief Check if the file was opened
+        //! \returns true if the contents are available
+        bool is_open() const;
+
+        //! \brief Get the contents of the file
+        //! \returns View over the entire file
+        std::string_view contents() const;
+
+    private:
+        bool opened;
+        void * mapping;
+        size_t mapping_size;
+        std::string fallback;
+    };
+}
+
+#endif
@@ -1,19 +1,120 @@
 #include "Preprocessor.hpp"
+#include "WorkPool.hpp"
 
-#include <fstream>
 #include <filesystem>
 #include <iostream>
-#include <regex>
+#include <cstring>
+#include <cctype>
+#include <mutex>
+#include <functional>
+#include <sys/stat.h>
 
 namespace DEL
 {
+    namespace
+    {
+        //  Check a word of the line at a time. A byte is blank if it is ' ' or falls in '\t' to '\r', the
+        //  same set isspace() accepts in the C locale. Each test leaves the high bit of a byte set
+        //  when the byte passes, and the masked adds can't carry from one byte into the next
+        inline bool is_blank(const char * start, uint64_t length)
+        {
+            constexpr uint64_t ONES = 0x0101010101010101ULL;
+            constexpr uint64_t HIGH = 0x80 * ONES;
+            constexpr uint64_t LOW  = 0x7F * ONES;
+
+            uint64_t i = 0;
+            for(; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t))
+            {
+                uint64_t word;
+                std::memcpy(&word, start + i, sizeof(word));
+
+                // Bytes equal to ' '
+                uint64_t spaces = word ^ (' ' * ONES);
+                spaces = ~(((spaces & LOW) + LOW) | spaces) & HIGH;
+
+                // Bytes at least '\t' and not past '\r'
+                uint64_t low = word & LOW;
+                uint64_t controls = (low + (0x80 - '\t') * ONES) & ~(low + (0x80 - '\r' - 1) * ONES) & ~word & HIGH;
+
+                if((spaces | controls) != HIGH)
+                {
+                    return false;
+                }
+            }
+
+            for(; i < length; i++)
+            {
+                if(!isspace(static_cast<unsigned char>(start[i])))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        inline bool is_use_file_char(char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        }
+
+        //  Recognize : <ws>use("<[a-zA-Z0-9_]+>.del")<ws><// comment>
+        //  On a match the file name is placed in use_file
+        bool match_use_directive(std::string_view line, std::string_view & use_file)
+        {
+            static constexpr std::string_view PREFIX    = "use(\"";
+            static constexpr std::string_view EXTENSION = ".del";
+            static constexpr std::string_view SUFFIX    = "\")";
+
+            uint64_t pos = 0;
+            while(pos < line.size() && isspace(static_cast<unsigned char>(line[pos]))) { pos++; }
+
+            // Almost every line is rejected here
+            if(line.size() - pos < PREFIX.size() || line.compare(pos, PREFIX.size(), PREFIX) != 0)
+            {
+                return false;
+            }
+            pos += PREFIX.size();
+
+            uint64_t name_start = pos;
+            while(pos < line.size() && is_use_file_char(line[pos])) { pos++; }
+
+            if(pos == name_start || line.compare(pos, EXTENSION.size(), EXTENSION) != 0)
+            {
+                return false;
+            }
+            pos += EXTENSION.size();
+
+            uint64_t name_end = pos;
+
+            if(line.compare(pos, SUFFIX.size(), SUFFIX) != 0)
+            {
+                return false;
+            }
+            pos += SUFFIX.size();
+
+            // Only whitespace or a comment may follow
+            while(pos < line.size() && isspace(static_cast<unsigned char>(line[pos]))) { pos++; }
+
+            if(pos != line.size() && line.compare(pos, 2, "//") != 0)
+            {
+                return false;
+            }
+
+            use_file = line.substr(name_start, name_end - name_start);
+            return true;
+        }
+    }
+
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
     Preprocessor::Preprocessor(Errors & error_man) : error_man(error_man),
                                                      preproc_ready(false),
-                                                     default_path("del.preproc")
+                                                     worker_count(1),
+                                                     generation(0),
+                                                     preprocessed_buffer(*this),
+                                                     preprocessed_stream(&preprocessed_buffer)
     {
 
     }
@@ -24,7 +125,7 @@ namespace DEL
 
     Preprocessor::~Preprocessor()
     {
-        std::filesystem::remove_all(std::filesystem::path(default_path));
+
     }
 
     // ----------------------------------------------------------
@@ -36,31 +137,35 @@ namespace DEL
         // Add the directory of the file to the include path
         add_include_path(std::filesystem::path(filename).parent_path().string());
 
-        // Begin processing
-        process_file(filename);
+        // Read and scan every file reachable from the entry file
+        discover_files(filename);
 
-        // Check if output file exists, and if it does, remove it
-        if(std::filesystem::is_regular_file(std::filesystem::path(default_path)))
-        {
-            std::filesystem::remove_all(std::filesystem::path(default_path));
-        }
+        // Build the result in the order the use statements dictate
+        include_resolver.mark_included(filename);
+        splice_file(*scanned_files[filename]);
 
-        // Open the output file
-        std::ofstream out_file( default_path );
-        if( ! out_file.good() )
-        {
-            error_man.report_custom("Preprocessor", " Unable to open output file for preprocessing", true);
-        }
-
-        // Write the preprocessed file
-        for(auto & pair : pre_processed_pair)
-        {
-            out_file << pair.line << std::endl;;
-        }
-        out_file.close();
+        // Files that no recent call has reached only hold on to memory and mappings
+        evict_files();
 
         preproc_ready = true;
-        preprocessed_file = default_path;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Preprocessor::reset()
+    {
+        pre_processed_pair.clear();
+        sources.clear();
+        directives.clear();
+        current_file_stack = std::stack<std::string>();
+        include_resolver.reset();
+
+        preproc_ready = false;
+
+        preprocessed_buffer.rewind();
+        preprocessed_stream.clear();
     }
 
     // ----------------------------------------------------------
@@ -69,13 +174,9 @@ namespace DEL
 
     void Preprocessor::add_include_path(std::string path)
     {
-        if(std::find(std::begin(include_paths), std::end(include_paths), path) == std::end(include_paths))
+        if(!include_resolver.add_directory(path))
         {
-            if(!std::filesystem::is_directory(std::filesystem::path(path)))
-            {
-                error_man.report_preproc_include_path_not_dir(path);
-            }
-            include_paths.push_back(path);
+            error_man.report_preproc_include_path_not_dir(path);
         }
     }
 
@@ -83,115 +184,310 @@ namespace DEL
     //
     // ----------------------------------------------------------
 
-    void Preprocessor::process_file(std::string file)
+    void Preprocessor::set_worker_count(std::size_t count)
     {
-        // Indicate that we are currently looking at this file
-        current_file_stack.push(file);
+        worker_count = (count == 0) ? 1 : count;
+    }
 
-        pre_processed_pair.push_back({"@file:" + file, 0});
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
 
-        // Start reading file
-        std::ifstream in_file( file );
-        if( ! in_file.good() )
+    void Preprocessor::scan_file(scanned_file & file)
+    {
+        // A file left from an earlier call is only read again if it changed
+        if(is_current(file))
         {
-            error_man.report_custom("Error", " Unable to open given input file for preprocessing", true);
+            return;
         }
 
+        file.lines.clear();
+        file.uses.clear();
+        file.modified = 0;
+        file.size     = 0;
+
+        struct stat info;
+        if(::stat(file.path.c_str(), &info) == 0)
+        {
+            file.modified = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+            file.size     = static_cast<uint64_t>(info.st_size);
+        }
+
+        // Map the file, lines will be viewed directly from the mapping
+        file.file = std::make_unique<MappedFile>(file.path);
+        if( ! file.file->is_open() )
+        {
+            return;
+        }
+
+        std::string_view text = file.file->contents();
+
+        const char * base = text.data();
+        uint64_t size = text.size();
+        uint64_t pos  = 0;
+
         uint64_t line_no = 1;
 
-        // Read each line
-        std::string line;
-        while(std::getline(in_file, line))
+        // Walk each line, letting memchr find the line endings
+        while(pos < size)
         {
-            if(!std::all_of(line.begin(),line.end(),isspace))
+            const char * newline = static_cast<const char*>(std::memchr(base + pos, '\n', size - pos));
+            uint64_t end = (newline != nullptr) ? static_cast<uint64_t>(newline - base) : size;
+
+            if(!is_blank(base + pos, end - pos))
             {
-                process_line(line, line_no);
+                int32_t use = -1;
+
+                // Check for a use statement
+                std::string_view use_file;
+                if(match_use_directive(text.substr(pos, end - pos), use_file))
+                {
+                    use = file.uses.size();
+                    file.uses.push_back({std::string(use_file), ""});
+                }
+
+                file.lines.push_back({pos, static_cast<uint32_t>(end - pos), use, line_no});
             }
             // Count line numbers even if they're blank
             line_no++;
+            pos = end + 1;
         }
+    }
 
-        in_file.close();
-
-        // Add the file as its already processed
-        included_files.push_back(current_file_stack.top());
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
 
-        // Remove this line because we're done
-        current_file_stack.pop();
+    bool Preprocessor::is_current(const scanned_file & file) const
+    {
+        if(file.file == nullptr || !file.file->is_open())
+        {
+            return false;
+        }
 
-        if(current_file_stack.size() > 0)
+        struct stat info;
+        if(::stat(file.path.c_str(), &info) != 0)
         {
-            pre_processed_pair.push_back({"@file:" + current_file_stack.top(), 0});
+            return false;
         }
+
+        return file.modified == static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec &&
+               file.size     == static_cast<uint64_t>(info.st_size);
     }
 
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    void Preprocessor::process_line(std::string line, uint64_t number)
+    void Preprocessor::discover_files(std::string entry)
     {
-        /*
-            Check for a use statement
-        */
-        if(std::regex_match(line, std::regex("use\\(\"[a-zA-Z0-9_]+\\.del\"\\)")))
+        // Files from earlier calls stay in scanned_files. The generation marks the ones reached by this call
+        generation++;
+
+        std::unique_ptr<scanned_file> & entry_file = scanned_files[entry];
+        if(entry_file == nullptr)
         {
-            // Remove spaces
-            line.erase(remove_if(line.begin(), line.end(), isspace), line.end());
+            entry_file = std::make_unique<scanned_file>();
+            entry_file->path = entry;
+        }
+        entry_file->generation = generation;
+
+        // Most programs are a single file, so the entry is scanned here and threads
+        // are only started once there is something to include
+        scan_file(*entry_file);
 
-            // Get the string that indicates a file name (hopefully)
-            std::string use_file = line.substr(5, line.size()-7);
+        std::vector<scanned_file*> to_scan;
 
-            // Go through the include directories given to the preproc and see 
-            // if the file can be located
-            for(auto & include_dir : include_paths)
+        // Resolve use statements, gathering files that haven't been reached yet. The include paths
+        // may differ from the last call, so even files that are already scanned resolve their uses again
+        auto resolve_uses = [&](scanned_file & file, std::vector<scanned_file*> & found)
+        {
+            for(auto & use : file.uses)
             {
-                // Make a path from the include dir string
-                auto p = std::filesystem::path(include_dir);
+                use.path.clear();
+                if(!include_resolver.resolve(use.file, use.path))
+                {
+                    continue;
+                }
 
-                // Add the file given to us to the path
-                p /= use_file;
+                std::unique_ptr<scanned_file> & next = scanned_files[use.path];
+                if(next == nullptr)
+                {
+                    next = std::make_unique<scanned_file>();
+                    next->path = use.path;
+                }
 
-                // Check if the file has already been included
-                if(std::find(std::begin(included_files), std::end(included_files), p.string()) != std::end(included_files))
+                if(next->generation != generation)
                 {
-                    return;
+                    next->generation = generation;
+                    found.push_back(next.get());
                 }
+            }
+        };
+
+        resolve_uses(*entry_file, to_scan);
+
+        if(to_scan.empty())
+        {
+            return;
+        }
 
-                // If its a file, we use it
-                if(std::filesystem::is_regular_file(p))
+        if(worker_count == 1)
+        {
+            while(!to_scan.empty())
+            {
+                scanned_file * file = to_scan.back();
+                to_scan.pop_back();
+
+                scan_file(*file);
+                resolve_uses(*file, to_scan);
+            }
+            return;
+        }
+
+        // Files are read and scanned in parallel. Resolving their use statements touches
+        // shared state so that is done under the lock
+        WorkPool pool(worker_count);
+        std::mutex resolve_lock;
+
+        std::function<void(scanned_file*)> scan_job = [&](scanned_file * file)
+        {
+            scan_file(*file);
+
+            std::vector<scanned_file*> found;
+            {
+                std::lock_guard<std::mutex> guard(resolve_lock);
+                resolve_uses(*file, found);
+            }
+
+            for(auto & next : found)
+            {
+                pool.submit([&scan_job, next]() { scan_job(next); });
+            }
+        };
+
+        for(auto & file : to_scan)
+        {
+            pool.submit([&scan_job, file]() { scan_job(file); });
+        }
+        pool.wait();
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Preprocessor::evict_files()
+    {
+        if(generation <= CACHE_GENERATIONS)
+        {
+            return;
+        }
+
+        for(auto it = scanned_files.begin(); it != scanned_files.end(); )
+        {
+            if(it->second->generation <= generation - CACHE_GENERATIONS)
+            {
+                it = scanned_files.erase(it);
+                continue;
+            }
+            ++it;
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Preprocessor::splice_file(scanned_file & file)
+    {
+        // Indicate that we are currently looking at this file
+        current_file_stack.push(file.path);
+
+        add_file_directive(file.path);
+
+        if( ! file.file->is_open() )
+        {
+            error_man.report_custom("Error", " Unable to open given input file for preprocessing", true);
+        }
+
+        uint32_t source = sources.size();
+        sources.push_back(file.file->contents());
+
+        for(auto & line : file.lines)
+        {
+            if(line.use >= 0)
+            {
+                use_statement & use = file.uses[line.use];
+
+                // Files that were already included (through any path) are dropped
+                if(!use.path.empty())
                 {
-                    // Start the processing
-                    process_file(p.string());
-                    return;
+                    if(include_resolver.mark_included(use.path))
+                    {
+                        splice_file(*scanned_files[use.path]);
+                    }
+                    continue;
                 }
+
+                // If we didn't find it, then.. well.. thats a problem
+                error_man.report_preproc_file_not_found("Unable to locate file for use statement", use.file, current_file_stack.top());
             }
 
-            // If we didn't return, then.. well.. thats a problem
-            error_man.report_preproc_file_not_found("Unable to locate file for use statement", use_file, current_file_stack.top());
+            pre_processed_pair.push_back({source, line.length, line.offset, line.number});
+        }
+
+        // Remove this line because we're done
+        current_file_stack.pop();
+
+        if(current_file_stack.size() > 0)
+        {
+            add_file_directive(current_file_stack.top());
         }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Preprocessor::add_file_directive(std::string file)
+    {
+        directives.push_back("@file:" + file);
+
+        uint32_t source = sources.size();
+        sources.push_back(directives.back());
 
-        /*
-            Add the line to the final list
-        */
-        pre_processed_pair.push_back({line, number});
+        pre_processed_pair.push_back({source, static_cast<uint32_t>(directives.back().size()), 0, 0});
     }
 
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    std::string Preprocessor::get_preprocessed_filename() const
+    std::string_view Preprocessor::line_view(const line_no_pair & line) const
+    {
+        return sources[line.source].substr(line.offset, line.length);
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    std::istream & Preprocessor::get_preprocessed_stream()
     {
         if(!preproc_ready)
         {
             // This is a developer error
-            error_man.report_custom("Preprocessor", " get_preprocessed_filename called before preprocessor was ran", true);
+            error_man.report_custom("Preprocessor", " get_preprocessed_stream called before preprocessor was ran", true);
         }
 
-        return preprocessed_file;
+        return preprocessed_stream;
     }
 
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
     std::string Preprocessor::fetch_line(int line_number)
     {
         if(!preproc_ready)
@@ -201,13 +497,13 @@ namespace DEL
         }
 
         if(line_number > 0)  { line_number = line_number-1; }
-        if((uint64_t)line_number > pre_processed_pair.size() || line_number < 0)
+        if((uint64_t)line_number >= pre_processed_pair.size() || line_number < 0)
         {
             // This is a developer error
             error_man.report_custom("Preprocessor", " fetch_line requested line out of range", true);
         }
 
-        return pre_processed_pair[line_number].line;
+        return std::string(line_view(pre_processed_pair[line_number]));
     }
 
     // ----------------------------------------------------------
@@ -223,7 +519,7 @@ namespace DEL
         }
 
         if(line_number > 0)  { line_number = line_number-1; }
-        if((uint64_t)line_number > pre_processed_pair.size() || line_number < 0)
+        if((uint64_t)line_number >= pre_processed_pair.size() || line_number < 0)
         {
             // This is a developer error
             error_man.report_custom("Preprocessor", " fetch_user_line_number requested line out of range", true);
@@ -231,4 +527,59 @@ namespace DEL
 
         return pre_processed_pair[line_number].number;
     }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    Preprocessor::PreprocessedBuffer::PreprocessedBuffer(const Preprocessor & preproc) : preproc(preproc),
+                                                                                      current_line(0),
+                                                                                      newline_pending(false),
+                                                                                      newline('\n')
+    {
+
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void Preprocessor::PreprocessedBuffer::rewind()
+    {
+        current_line    = 0;
+        newline_pending = false;
+        setg(nullptr, nullptr, nullptr);
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    Preprocessor::PreprocessedBuffer::int_type Preprocessor::PreprocessedBuffer::underflow()
+    {
+        while(current_line < preproc.pre_processed_pair.size())
+        {
+            // Hand out the line itself, pointing directly at its storage
+            if(!newline_pending)
+            {
+                newline_pending = true;
+
+                std::string_view line = preproc.line_view(preproc.pre_processed_pair[current_line]);
+                if(!line.empty())
+                {
+                    char * start = const_cast<char*>(line.data());
+                    setg(start, start, start + line.size());
+                    return traits_type::to_int_type(*start);
+                }
+            }
+
+            // Then the newline that ends it
+            newline_pending = false;
+            current_line++;
+            setg(&newline, &newline, &newline + 1);
+            return traits_type::to_int_type(newline);
+        }
+
+        return traits_type::eof();
+    }
 }
\ No newline at end of file
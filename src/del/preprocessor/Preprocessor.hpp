@@ -2,10 +2,18 @@
 #define DEL_PRE_PROCESSOR_HPP
 
 #include "Errors.hpp"
+#include "MappedFile.hpp"
+#include "IncludeResolver.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
+#include <deque>
+#include <memory>
+#include <unordered_map>
 #include <filesystem>
 #include <stack>
+#include <istream>
+#include <streambuf>
 
 namespace DEL
 {
@@ -13,6 +21,9 @@ namespace DEL
     class Preprocessor
     {
     public:
+        //! \brief Number of calls to process() a file is kept for after it was last reached
+        static constexpr uint64_t CACHE_GENERATIONS = 16;
+
         //! \brief Construct the preprocessor
         //! \param error_man The error manager
         Preprocessor(Errors & error_man);
@@ -24,9 +35,18 @@ namespace DEL
         //! \param filename The entry file
         void process(const char * const filename);
 
-        //! \brief Get the name of the filename generated by the preprocessor
-        //! \returns Filename of preprocessed file
-        std::string get_preprocessed_filename() const;
+        //! \brief Forget the last file processed so another can be. Include paths are dropped,
+        //!        but directory listings and files that were read are kept and reused while they are unchanged on disk
+        //!        and have been reached by one of the last CACHE_GENERATIONS calls to process()
+        void reset();
+
+        //! \brief Get the result of preprocessing as a stream that can be handed to the scanner
+        //! \returns Stream that reads directly from the preprocessed lines
+        std::istream & get_preprocessed_stream();
+
+        //! \brief Set the number of threads used to read and scan files
+        //! \param count Number of threads. 1 scans every file on the calling thread
+        void set_worker_count(std::size_t count);
 
         //! \brief Add a path to look for to resolve use / include statements
         //! \param path The path to include
@@ -44,25 +64,88 @@ namespace DEL
 
     private:
 
-        void process_file(std::string file);
-        void process_line(std::string line, uint64_t number);
+        //! \brief A non-blank line of a source file, or a use statement found on one
+        struct scanned_line
+        {
+            uint64_t    offset;     // Offset of the line within the file
+            uint32_t    length;     // Length of the line, not including the newline
+            int32_t     use;        // Index into the file's use statements, -1 if the line isn't one
+            uint64_t    number;     // Line number in the file
+        };
+
+        //! \brief A use statement and the path it resolved to
+        struct use_statement
+        {
+            std::string file;       // File named by the statement
+            std::string path;       // Path to the file, empty if it could not be found
+        };
+
+        //! \brief The result of reading and scanning a single file. Scanning is independent
+        //!        of every other file so it can be done on any thread
+        struct scanned_file
+        {
+            std::string path;
+            std::unique_ptr<MappedFile> file;
+            std::vector<scanned_line> lines;
+            std::vector<use_statement> uses;
+            int64_t  modified;      // Modification time (ns) when the file was scanned
+            uint64_t size;          // Size when the file was scanned
+            uint64_t generation;    // Last call to process() that reached the file
+        };
+
+        void scan_file(scanned_file & file);
+        bool is_current(const scanned_file & file) const;
+        void discover_files(std::string entry);
+        void evict_files();
+        void splice_file(scanned_file & file);
+        void add_file_directive(std::string file);
 
+        //! \brief A line of the preprocessed output, stored as a view into one of the sources
         struct line_no_pair
         {
-            std::string line;
-            uint64_t    number;
+            uint32_t    source;     // Index into sources
+            uint32_t    length;     // Length of the line, not including the newline
+            uint64_t    offset;     // Offset of the line within the source
+            uint64_t    number;     // Line number in the user's file
+        };
+
+        std::string_view line_view(const line_no_pair & line) const;
+
+        //! \brief A read-only stream buffer that walks the preprocessed lines in place,
+        //!        presenting each line followed by a newline without copying them
+        class PreprocessedBuffer : public std::streambuf
+        {
+        public:
+            PreprocessedBuffer(const Preprocessor & preproc);
+
+            //! \brief Go back to the first line
+            void rewind();
+
+        protected:
+            int_type underflow() override;
+
+        private:
+            const Preprocessor & preproc;
+            uint64_t current_line;
+            bool newline_pending;
+            char newline;
         };
 
         std::vector<line_no_pair> pre_processed_pair;   // Resulting preprocessed file with original line indexing
-        std::vector<std::string> include_paths;         // Paths to search for use statements
+        std::vector<std::string_view> sources;          // Text that lines are viewed from
+        std::unordered_map<std::string, std::unique_ptr<scanned_file>> scanned_files;  // Files backing the sources, by path
+        std::deque<std::string> directives;             // Generated directive text backing the sources
+        IncludeResolver include_resolver;               // Paths to search for use statements, and files included
 
         std::stack<std::string> current_file_stack;     // File processing stack for generating @file directives
-        std::vector<std::string> included_files;        // Files already included
 
         Errors & error_man;
         bool preproc_ready;
-        std::string default_path;
-        std::string preprocessed_file;
+        std::size_t worker_count;
+        uint64_t generation;
+
+        PreprocessedBuffer preprocessed_buffer;         // Buffer over pre_processed_pair
+        std::istream preprocessed_stream;               // Stream given to the scanner
     };
 }
 
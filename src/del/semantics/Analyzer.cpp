@@ -6,38 +6,21 @@
 
 #include "SystemSettings.hpp"
 
-#define N_UNUSED(x) (void)x;
-
 namespace DEL
 {
-namespace
-{
-    bool is_only_number(std::string v)
-    {
-        try
-        {
-            double value = std::stod(v);
-            N_UNUSED(value)
-            return true;
-        }
-        catch(std::exception& e)
-        {
-            // Its not a number
-        }
-        return false;
-    }
-}
     // ----------------------------------------------------------
     //
     // ----------------------------------------------------------
 
-    Analyzer::Analyzer(Errors & err, SymbolTable & symbolTable, Codegen & code_gen, Memory & memory) : 
+    Analyzer::Analyzer(Errors & err, SymbolTable & symbolTable, Codegen & code_gen, Memory & memory, Arena & arena, Interner & interner) : 
                                                                         error_man(err), 
                                                                         symbol_table(symbolTable),
                                                                         memory_man(memory),
-                                                                        endecoder(memory_man),
-                                                                        intermediate_layer(memory, code_gen)
+                                                                        arena(arena),
+                                                                        interner(interner),
+                                                                        intermediate_layer(memory, code_gen, interner)
     {
+        main_symbol = interner.intern("main");
         program_watcher.setup();
     }
 
@@ -54,6 +37,18 @@ namespace
     //
     // ----------------------------------------------------------
 
+    void Analyzer::reset()
+    {
+        current_function = nullptr;
+        loop_names.clear();
+        function_watcher.has_return = false;
+        program_watcher.setup();
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
     void Analyzer::check_for_finalization()
     {
         if(!program_watcher.has_main)
@@ -66,11 +61,11 @@ namespace
     //
     // ----------------------------------------------------------
 
-    void Analyzer::ensure_unique_symbol(std::string id, int line_no)
+    void Analyzer::ensure_unique_symbol(SymbolId id, int line_no)
     {
         if(symbol_table.does_symbol_exist(id, true))
         {
-            error_man.report_previously_declared(id, line_no);
+            error_man.report_previously_declared(interner.name(id), line_no);
         }
     }
 
@@ -78,13 +73,13 @@ namespace
     //
     // ----------------------------------------------------------
 
-    void Analyzer::ensure_id_in_current_context(std::string id, int line_no, std::vector<ValType> allowed)
+    void Analyzer::ensure_id_in_current_context(SymbolId id, int line_no, std::vector<ValType> allowed)
     {
         // Check symbol table to see if an id exists, don't display information yet
         if(!symbol_table.does_symbol_exist(id, false))
         {
             // Reports the error and true marks the program for death
-            error_man.report_unknown_id(id, line_no, true);
+            error_man.report_unknown_id(interner.name(id), line_no, true);
         }
 
         // If allowed is empty, we just wanted to make sure the thing existed
@@ -106,7 +101,7 @@ namespace
         // If the type isn't allowed
         if(!is_allowed)
         {
-            error_man.report_unallowed_type(id, line_no, true);
+            error_man.report_unallowed_type(interner.name(id), line_no, true);
         }
     }
 
@@ -114,13 +109,13 @@ namespace
     //
     // ----------------------------------------------------------
 
-    ValType Analyzer::get_id_type(std::string id, int line_no)
+    ValType Analyzer::get_id_type(SymbolId id, int line_no)
     {
         ValType t = symbol_table.get_value_type(id);
 
         if(t == ValType::NONE)
         {
-            error_man.report_unknown_id(id, line_no, true);
+            error_man.report_unknown_id(interner.name(id), line_no, true);
         }
 
         return t;
@@ -136,13 +131,13 @@ namespace
         if(symbol_table.does_context_exist(function->name))
         {
             // Dies if not unique
-            error_man.report_previously_declared(function->name, function->line_no);
+            error_man.report_previously_declared(interner.name(function->name), function->line_no);
         }
 
         symbol_table.new_context(function->name);
 
         // Check for 'main'
-        if(function->name == "main")
+        if(function->name == main_symbol)
         {
             program_watcher.has_main = true;
         }
@@ -164,14 +159,11 @@ namespace
             symbol_table.add_symbol(p.id, p.type);
         }
 
-        // Add parameters to the context
-        symbol_table.add_parameters_to_current_context(function->params);
-
-        // Add return type to the context
-        symbol_table.add_return_type_to_current_context(function->return_type);
+        // Record the signature so calls made after this function can be checked against it
+        symbol_table.add_function_signature(function->name, function->params, function->return_type);
 
         // Tell intermediate layer to start function with given parametrs
-        intermediate_layer.issue_start_function(function->name, function->params);
+        intermediate_layer.issue_start_function(interner.name(function->name), function->params);
 
         // So elements can access function information as we visit them
         current_function = function;
@@ -186,21 +178,18 @@ namespace
             // for any errors that may be present, and then analyzer will ask Intermediate to
             // generate instructions for the Codegen / Send the instructions to code gen
             el->visit(*this);
-
-            // Now that the item is constructed, we free the memory
-            delete el;
         }
 
         // Tell intermediate layer that we are done constructin the current function
         intermediate_layer.issue_end_function();
 
-        // Clear the symbol table for the given function so elements cant be accessed externally
-        // We dont delete the context though, that way can confirm existence later
-        symbol_table.clear_existing_context(function->name);
+        // Drop the function's scope so elements cant be accessed externally
+        // The signature stays in the table, that way can confirm existence later
+        symbol_table.remove_current_context();
 
         if(!function_watcher.has_return)
         {
-            error_man.report_no_return(function->name, function->line_no);
+            error_man.report_no_return(interner.name(function->name), function->line_no);
         }
 
         current_function = nullptr;
@@ -208,8 +197,8 @@ namespace
         // Reset the memory manager for alloc variables in new space
         memory_man.reset();
 
-        // Function is constructed - and elements have been freed
-        delete function;
+        // Function is constructed - release everything the parser and analyzer built for it
+        arena.reset();
     }
 
     // -----------------------------------------------------------------------------------------
@@ -258,7 +247,9 @@ namespace
         */
         INTERMEDIATE::TYPES::AssignmentClassifier classification = INTERMEDIATE::TYPES::AssignmentClassifier::INTEGER; // Assume int 
         
-        std::string postfix_expression = validate_assignment_ast(stmt.line_no, stmt.rhs, classification, stmt.data_type, stmt.lhs);
+        INTERMEDIATE::TYPES::Expression expression;
+
+        validate_assignment_ast(stmt.line_no, stmt.rhs, classification, stmt.data_type, stmt.lhs, expression);
 
         // The unique value doesn't exist yet and needs some memory allocated and 
         // needs to be added to the symbol table
@@ -276,7 +267,7 @@ namespace
             memory_info = memory_man.get_mem_info(stmt.lhs);
         }
 
-        intermediate_layer.issue_assignment(stmt.lhs, requires_ds_allocation, memory_info, classification, postfix_expression);
+        intermediate_layer.issue_assignment(interner.name(stmt.lhs), requires_ds_allocation, memory_info, classification, expression);
     }
 
     // ----------------------------------------------------------
@@ -286,7 +277,7 @@ namespace
     void Analyzer::accept(ReturnStmt & stmt)
     {
         // Create a 'variable assignment' for the return so we can copy the value or whatever
-        std::string variable_for_return = symbol_table.generate_unique_return_symbol();
+        SymbolId variable_for_return = symbol_table.generate_unique_return_symbol();
 
         function_watcher.has_return = true;
 
@@ -298,11 +289,9 @@ namespace
         }
 
         // Create an assignment for the return, this will execute the return withing code gen as we set a RETURN node type that is processed by the assignment
-        Assignment * return_assignment = new Assignment(current_function->return_type, variable_for_return, new DEL::AST(DEL::NodeType::RETURN, stmt.rhs, nullptr));
+        Assignment * return_assignment = arena.make<Assignment>(current_function->return_type, variable_for_return, arena.make<DEL::AST>(DEL::NodeType::RETURN, stmt.rhs, nullptr));
         return_assignment->line_no = stmt.line_no;
         this->accept(*return_assignment);
-
-        delete return_assignment;
     }
 
     // ----------------------------------------------------------
@@ -313,16 +302,16 @@ namespace
     {
         validate_call(stmt);
 
-        ValType callee_type = symbol_table.get_return_type_of_context(stmt.name);
+        ValType callee_type = symbol_table.get_function_return_type(stmt.name);
 
         if(callee_type != ValType::NONE)
         {
-            error_man.report_calls_return_value_unhandled(current_function->name, stmt.name, stmt.line_no, false);
+            error_man.report_calls_return_value_unhandled(interner.name(current_function->name), interner.name(stmt.name), stmt.line_no, false);
         }
 
-        // We endocde it to leverage the same functionality that is required by an expression-based call
+        // The same directive is used by an expression-based call
         intermediate_layer.issue_direct_call(
-            endecoder.encode_call(&stmt)
+            build_call_directive(stmt)
         );
     }
 
@@ -334,31 +323,27 @@ namespace
     {
         If * if_ptr = & stmt;
 
-        std::string artificial_context = symbol_table.generate_unique_context();
+        SymbolId artificial_context = symbol_table.generate_unique_context();
         symbol_table.new_context(artificial_context, false );
 
         // Setup variables for conditions
         while(if_ptr != nullptr)
         {
-            std::string if_condition_variable = symbol_table.generate_unique_variable_symbol();
+            SymbolId if_condition_variable = symbol_table.generate_unique_variable_symbol();
 
             // Attempt to determine the type of the expression
             ValType condition_type = determine_expression_type(if_ptr->expr, if_ptr->expr, true, if_ptr->line_no);
 
-            std::string value = (condition_type == ValType::REAL) ? "0.0" : "0";
-            DEL::AST * artificial_value = new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, condition_type, value);
-            DEL::AST * artificial_check = new DEL::AST(DEL::NodeType::GT , if_ptr->expr, artificial_value);
+            Literal value = (condition_type == ValType::REAL) ? Literal(0.0) : Literal();
+            DEL::AST * artificial_value = arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, condition_type, value);
+            DEL::AST * artificial_check = arena.make<DEL::AST>(DEL::NodeType::GT , if_ptr->expr, artificial_value);
 
             // Create an assignment for the conditional 
-            Assignment * c_assign = new Assignment(condition_type, if_condition_variable, artificial_check);
+            Assignment * c_assign = arena.make<Assignment>(condition_type, if_condition_variable, artificial_check);
 
             c_assign->line_no = if_ptr->line_no;
             c_assign->visit(*this);
 
-            delete artificial_value;
-            delete artificial_check;
-            delete c_assign;
-
             if_ptr->set_var_name(if_condition_variable);
 
             // Inc the if_ptr to its trail. Check for nullptr so we dont attempt to stati cast nothing
@@ -384,7 +369,7 @@ namespace
         {
             case IfType::IF:
             {
-                std::string artificial_context = symbol_table.generate_unique_context();
+                SymbolId artificial_context = symbol_table.generate_unique_context();
 
                 // Create an artificial context in symbol table for the current if statement
                 symbol_table.new_context(artificial_context, false );
@@ -396,7 +381,6 @@ namespace
                 for(auto & el : stmt.element_list)
                 {
                     el->visit(*this);
-                    delete el;
                 }
 
                 // Remove the current context from the symbol table
@@ -415,7 +399,7 @@ namespace
             case IfType::ELIF:
             case IfType::ELSE:
             {
-                std::string artificial_context = symbol_table.generate_unique_context();
+                SymbolId artificial_context = symbol_table.generate_unique_context();
 
                 // Create an artificial context in symbol table for the current if statement
                 symbol_table.new_context(artificial_context, false );
@@ -427,7 +411,6 @@ namespace
                 for(auto & el : stmt.element_list)
                 {
                     el->visit(*this);
-                    delete el;
                 }
 
                 // Remove the current context from the symbol table
@@ -443,7 +426,7 @@ namespace
                 return;
             }
             default:
-                std::cout << "If statement : DEFAULT : " << (int)stmt.type << std::endl;
+                error_man.report_custom("Analyzer", "If statement : DEFAULT : " + std::to_string((int)stmt.type), false);
                 return;
         }
 
@@ -465,45 +448,42 @@ namespace
         validate_step(stmt.line_no, stmt.step, stmt.type);
 
         // Create a context for the loop
-        std::string artificial_context = symbol_table.generate_unique_context();
+        SymbolId artificial_context = symbol_table.generate_unique_context();
         symbol_table.new_context(artificial_context, false );
 
         // Create a name for the end variable
-        std::string end_var;
+        SymbolId end_var;
 
         if(stmt.range->type == ValType::REQ_CHECK)
         {
-            if(is_only_number(stmt.range->to))
+            if(!stmt.range->to.is_variable())
             {
                 end_var = symbol_table.generate_unique_variable_symbol();
 
                 // Create the end variable, and assign it to the final position (to)
-                Assignment * assign_end_var = new Assignment(stmt.type, end_var, new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, stmt.type, stmt.range->to));
+                Assignment * assign_end_var = arena.make<Assignment>(stmt.type, end_var, arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, stmt.type, stmt.range->to.value));
                 assign_end_var->line_no = stmt.line_no;
                 this->accept(*assign_end_var);
-                delete assign_end_var;
             }
             else
             {
                 // Here we will use the raw var
-                end_var = stmt.range->to;
+                end_var = stmt.range->to.symbol;
             }
 
-            if(is_only_number(stmt.range->from))
+            if(!stmt.range->from.is_variable())
             {
                 // Create the loop variable, and assign it to the initial position (from) represented by a raw value
-                Assignment * assign_loop_var = new Assignment(stmt.type, stmt.id, new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, stmt.type, stmt.range->from));
+                Assignment * assign_loop_var = arena.make<Assignment>(stmt.type, stmt.id, arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, stmt.type, stmt.range->from.value));
                 assign_loop_var->line_no = stmt.line_no;
                 this->accept(*assign_loop_var);
-                delete assign_loop_var;
             }
             else
             {
                 // Create the loop variable, and assign it to the initial position (from) represented by a variable value
-                Assignment * assign_loop_var = new Assignment(stmt.type, stmt.id, new DEL::AST(DEL::NodeType::ID, nullptr, nullptr, stmt.type, stmt.range->from));
+                Assignment * assign_loop_var = arena.make<Assignment>(stmt.type, stmt.id, arena.make<DEL::AST>(DEL::NodeType::ID, nullptr, nullptr, stmt.type, stmt.range->from.symbol));
                 assign_loop_var->line_no = stmt.line_no;
                 this->accept(*assign_loop_var);
-                delete assign_loop_var;
             }
         }
         else
@@ -511,20 +491,18 @@ namespace
             end_var = symbol_table.generate_unique_variable_symbol();
 
             // Create the end variable, and assign it to the final position (to)
-            Assignment * assign_end_var = new Assignment(stmt.type, end_var, new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, stmt.type, stmt.range->to));
+            Assignment * assign_end_var = arena.make<Assignment>(stmt.type, end_var, arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, stmt.type, stmt.range->to.value));
             assign_end_var->line_no = stmt.line_no;
             this->accept(*assign_end_var);
-            delete assign_end_var;
 
             // Create the loop variable, and assign it to the initial position (from) represented by a raw value
-            Assignment * assign_loop_var = new Assignment(stmt.type, stmt.id, new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, stmt.type, stmt.range->from));
+            Assignment * assign_loop_var = arena.make<Assignment>(stmt.type, stmt.id, arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, stmt.type, stmt.range->from.value));
             assign_loop_var->line_no = stmt.line_no;
             this->accept(*assign_loop_var);
-            delete assign_loop_var;
         }
 
         // Setup 'step'
-        std::string step_var_name;
+        SymbolId step_var_name;
 
         // If step is just a raw value, create a variable for it
         if(stmt.step->type != ValType::REQ_CHECK)
@@ -532,16 +510,15 @@ namespace
             step_var_name = symbol_table.generate_unique_variable_symbol();
 
             // Create the step variable, and assign it to the final position (to)
-            Assignment * assign_end_var = new Assignment(stmt.type, step_var_name, new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, stmt.type, stmt.step->val));
+            Assignment * assign_end_var = arena.make<Assignment>(stmt.type, step_var_name, arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, stmt.type, stmt.step->val.value));
             assign_end_var->line_no = stmt.line_no;
             this->accept(*assign_end_var);
-            delete assign_end_var;
         }
 
         // Otherwise, use the value given to us
         else
         {
-            step_var_name = stmt.step->val;
+            step_var_name = stmt.step->val.symbol;
         }
 
         // Translate data type
@@ -549,30 +526,26 @@ namespace
                 INTERMEDIATE::TYPES::AssignmentClassifier::DOUBLE : 
                 INTERMEDIATE::TYPES::AssignmentClassifier::INTEGER;
 
-        // Create intermediate representation for the loop
-        INTERMEDIATE::TYPES::ForLoop * ifl = new INTERMEDIATE::TYPES::ForLoop(classifier,
-                                                                              memory_man.get_mem_info(stmt.id),
-                                                                              memory_man.get_mem_info(end_var),
-                                                                              memory_man.get_mem_info(step_var_name));
+        // Create intermediate representation for the loop. It is only needed while the loop is built,
+        // and must not leak if an error is thrown from within the loop
+        INTERMEDIATE::TYPES::ForLoop ifl(classifier,
+                                         memory_man.get_mem_info(stmt.id),
+                                         memory_man.get_mem_info(end_var),
+                                         memory_man.get_mem_info(step_var_name));
         // Start off the for loop
-        intermediate_layer.issue_start_loop(ifl);
+        intermediate_layer.issue_start_loop(&ifl);
  
         // Compile the statements in the for loop
         for(auto & el : stmt.elements)
         {
             el->visit(*this);
-            delete el;
         }
 
         // End the loop
-        intermediate_layer.issue_end_loop(ifl);
+        intermediate_layer.issue_end_loop(&ifl);
 
         // Remove the context for the loop
         symbol_table.remove_current_context();
-
-        delete ifl;
-        delete stmt.step;
-        delete stmt.range;
     }
 
     // ----------------------------------------------------------
@@ -585,22 +558,22 @@ namespace
         ValType condition_type = determine_expression_type(stmt.expr, stmt.expr, true, stmt.line_no);
 
         // Create a context for the loop
-        std::string artificial_context = symbol_table.generate_unique_context();
+        SymbolId artificial_context = symbol_table.generate_unique_context();
         symbol_table.new_context(artificial_context, false );
 
-        std::string while_condition_variable = symbol_table.generate_unique_variable_symbol();
+        SymbolId while_condition_variable = symbol_table.generate_unique_variable_symbol();
 
         // A reassignment statement to update artificial variable that checks the condition of the while
         // when loop is executed
         Assignment * update_condition;
 
         // Create a variable to mark the expression as true or false
-        std::string value = (condition_type == ValType::REAL) ? "0.0" : "0";
-        DEL::AST * artificial_value = new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, condition_type, value);
-        DEL::AST * artificial_check = new DEL::AST(DEL::NodeType::GT , stmt.expr, artificial_value);
+        Literal value = (condition_type == ValType::REAL) ? Literal(0.0) : Literal();
+        DEL::AST * artificial_value = arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, condition_type, value);
+        DEL::AST * artificial_check = arena.make<DEL::AST>(DEL::NodeType::GT , stmt.expr, artificial_value);
 
         // Create an assignment for the conditional 
-        Assignment * c_assign = new Assignment(condition_type, while_condition_variable, artificial_check);
+        Assignment * c_assign = arena.make<Assignment>(condition_type, while_condition_variable, artificial_check);
 
         // Create the conditional assignment
 
@@ -608,7 +581,7 @@ namespace
         c_assign->visit(*this);
 
         // To update the while condition inside the loop
-        update_condition = new DEL::Assignment(DEL::ValType::REQ_CHECK, while_condition_variable, artificial_check);
+        update_condition = arena.make<DEL::Assignment>(DEL::ValType::REQ_CHECK, while_condition_variable, artificial_check);
         update_condition->line_no = stmt.line_no;
 
         // Get the memory information
@@ -620,35 +593,25 @@ namespace
                 INTERMEDIATE::TYPES::AssignmentClassifier::INTEGER;
 
         // Indicate loop start to intermediate
-        INTERMEDIATE::TYPES::WhileLoop * while_loop = new INTERMEDIATE::TYPES::WhileLoop(classifier, condition_mem_alloc);
+        INTERMEDIATE::TYPES::WhileLoop while_loop(classifier, condition_mem_alloc);
 
         // Start the loop
-        intermediate_layer.issue_start_loop(while_loop);
+        intermediate_layer.issue_start_loop(&while_loop);
 
         // Now that we've started the loop, we need to ensure the condition is updated each iteration
         update_condition->visit(*this);
 
-        // Cleanup of things we don't need anymore
-        delete artificial_value;
-        delete artificial_check;
-        delete c_assign;
-        delete update_condition;
-
-
         // Compile the statements in the for loop
         for(auto & el : stmt.elements)
         {
             el->visit(*this);
-            delete el;
         }
 
         // End the loop
-        intermediate_layer.issue_end_loop(while_loop);
+        intermediate_layer.issue_end_loop(&while_loop);
 
         // Remove the context for the loop
         symbol_table.remove_current_context();
-
-        delete while_loop;
     }
 
     // ----------------------------------------------------------
@@ -657,32 +620,27 @@ namespace
 
     void Analyzer::accept(NamedLoop & stmt)
     {
-        std::string artificial_context = symbol_table.generate_unique_context();
+        SymbolId artificial_context = symbol_table.generate_unique_context();
         symbol_table.new_context(artificial_context, false );
 
         // Ensure the symbol for the loop name is unique
         ensure_unique_symbol(stmt.name, stmt.line_no);
 
         // Create a variable for the named loop
-        DEL::AST * loop_variable = new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, ValType::INTEGER, "1");
-        Assignment * c_assign = new Assignment(ValType::INTEGER, stmt.name, loop_variable); 
+        DEL::AST * loop_variable = arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, ValType::INTEGER, Literal(uint64_t(1)));
+        Assignment * c_assign = arena.make<Assignment>(ValType::INTEGER, stmt.name, loop_variable); 
         c_assign->line_no = stmt.line_no;
         c_assign->visit(*this);
 
-        delete loop_variable;
-        delete c_assign;
-
         // Make an expression that is the loop name 
-        DEL::AST * expr = new DEL::AST(DEL::NodeType::ID,  nullptr, nullptr, DEL::ValType::STRING,  stmt.name);
+        DEL::AST * expr = arena.make<DEL::AST>(DEL::NodeType::ID,  nullptr, nullptr, DEL::ValType::STRING,  stmt.name);
 
         // Create a while loop with that expression and the loop's elements  ==>  while(loop_name){ loop.eleemnts; }
         //
-        DEL::WhileLoop * wl = new DEL::WhileLoop(expr, stmt.elements);
+        DEL::WhileLoop * wl = arena.make<DEL::WhileLoop>(expr, std::move(stmt.elements));
 
         wl->visit(*this);
 
-        // Wl will be deleted by the function that it accepts to
-
         // Remove the context for the loop
         symbol_table.remove_current_context();
     }
@@ -701,23 +659,19 @@ namespace
         // Create the correct annulment
         if(symbol_table.is_existing_symbol_of_type(stmt.var, ValType::REAL))
         {
-            annul_val = new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, ValType::REAL, "0.0");
+            annul_val = arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, ValType::REAL, Literal(0.0));
         }
         else
         {
-            annul_val = new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, ValType::INTEGER, "0");
+            annul_val = arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, ValType::INTEGER, Literal());
         }
 
         // Assignment to annul the variable
-        DEL::Assignment * annulment = new DEL::Assignment(DEL::ValType::REQ_CHECK, stmt.var, annul_val); 
+        DEL::Assignment * annulment = arena.make<DEL::Assignment>(DEL::ValType::REQ_CHECK, stmt.var, annul_val); 
         annulment->set_line_no(stmt.line_no);
 
         // Execute assignment
         annulment->visit(*this);
-
-        // Cleanup
-        delete annul_val;
-        delete annulment;
     }
 
     // -----------------------------------------------------------------------------------------
@@ -732,7 +686,7 @@ namespace
         {
             // If the step is a variable all we can do is ensure that the step variable
             // exists and matches the type of the loop
-            ensure_id_in_current_context(step->val, line, {loop_type});
+            ensure_id_in_current_context(step->val.symbol, line, {loop_type});
             return;
         }
 
@@ -744,18 +698,14 @@ namespace
 
         if(ValType::INTEGER == step->type)
         {
-            uint64_t s = std::stoull(step->val);
-
-            if(s == 0)
+            if(step->val.value.integer == 0)
             {
                 error_man.report_invalid_step(line);
             }
         }
         else if(ValType::REAL == step->type)
         {
-            double s = std::stod(step->val);
-
-            if(s == 0.0)
+            if(step->val.value.real == 0.0)
             {
                 error_man.report_invalid_step(line);
             }
@@ -777,17 +727,17 @@ namespace
         // Integers
         if(ValType::INTEGER == range->type)
         {
-            uint64_t start = std::stoull(range->from);
-            uint64_t end   = std::stoull(range->to);
+            uint64_t start = range->from.value.integer;
+            uint64_t end   = range->to.value.integer;
 
             if(start > end)
             {
-                error_man.report_range_invalid_start_gt_end(range->line_no, range->from, range->to);
+                error_man.report_range_invalid_start_gt_end(range->line_no, std::to_string(start), std::to_string(end));
             }
 
             if(start == end)
             {
-                error_man.report_range_ineffective(range->line_no, range->from, range->to);
+                error_man.report_range_ineffective(range->line_no, std::to_string(start), std::to_string(end));
             }
             return;
         }
@@ -795,17 +745,17 @@ namespace
         // Reals
         if(ValType::REAL == range->type)
         {
-            double start = std::stod(range->from);
-            double end   = std::stod(range->to);
+            double start = range->from.value.real;
+            double end   = range->to.value.real;
 
             if(start > end)
             {
-                error_man.report_range_invalid_start_gt_end(range->line_no, range->from, range->to);
+                error_man.report_range_invalid_start_gt_end(range->line_no, std::to_string(start), std::to_string(end));
             }
 
             if(start == end)
             {
-                error_man.report_range_ineffective(range->line_no, range->from, range->to);
+                error_man.report_range_ineffective(range->line_no, std::to_string(start), std::to_string(end));
             }
             return;
         }
@@ -815,14 +765,14 @@ namespace
         {
             // Check from and to, if they aren't a number then they are a variable.
             // If they are a variable we need to ensure the variable exists and is the same type as the range statement
-            if(!is_only_number(range->from))
+            if(range->from.is_variable())
             {
-                ensure_id_in_current_context(range->from, range->line_no, {loop_type});
+                ensure_id_in_current_context(range->from.symbol, range->line_no, {loop_type});
             }
 
-            if(!is_only_number(range->to))
+            if(range->to.is_variable())
             {
-                ensure_id_in_current_context(range->to, range->line_no, {loop_type});
+                ensure_id_in_current_context(range->to.symbol, range->line_no, {loop_type});
             }
             return;
         }
@@ -847,18 +797,18 @@ namespace
         }
 
         // Ensure that the called method exists
-        if(!symbol_table.does_context_exist(stmt.name))
+        if(!symbol_table.does_function_exist(stmt.name))
         {
-            error_man.report_callee_doesnt_exist(stmt.name, stmt.line_no);
+            error_man.report_callee_doesnt_exist(interner.name(stmt.name), stmt.line_no);
         }
 
         // Get the callee params
-        std::vector<FunctionParam> callee_params = symbol_table.get_context_parameters(stmt.name);
+        const std::vector<FunctionParam> & callee_params = symbol_table.get_function_parameters(stmt.name);
 
         // Ensure number of params match
         if(stmt.params.size() != callee_params.size())
         {
-            error_man.report_mismatched_param_length(current_function->name, stmt.name, callee_params.size(), stmt.params.size(), stmt.line_no);
+            error_man.report_mismatched_param_length(interner.name(current_function->name), interner.name(stmt.name), callee_params.size(), stmt.params.size(), stmt.line_no);
         }
 
         // Ensure all paramters exist
@@ -870,8 +820,8 @@ namespace
                 // Ensure the thing exists, because REQ_CHECK dictates that the parameter is a variable, not a raw
                 if(!symbol_table.does_symbol_exist(p.id))
                 {
-                    std::cerr << "Paramter in call to \"" << stmt.name << "\" does not exist in the current context" << std::endl;
-                    error_man.report_unknown_id(p.id, stmt.line_no, true);
+                    error_man.output() << "Paramter in call to \"" << interner.name(stmt.name) << "\" does not exist in the current context" << std::endl;
+                    error_man.report_unknown_id(interner.name(p.id), stmt.line_no, true);
                 }
 
                 // Set the type to the type of the known variable
@@ -882,22 +832,20 @@ namespace
             else
             {
                 // Generate a unique label for the raw parameter
-                std::string param_label = symbol_table.generate_unique_call_param_symbol();
+                SymbolId param_label = symbol_table.generate_unique_call_param_symbol();
 
                 // Create an assignment for the variable
-                Assignment * raw_parameter_assignment = new Assignment(p.type, param_label, 
-                    new DEL::AST(DEL::NodeType::VAL, nullptr, nullptr, p.type, p.id)
+                Assignment * raw_parameter_assignment = arena.make<Assignment>(p.type, param_label, 
+                    arena.make<DEL::AST>(DEL::NodeType::VAL, nullptr, nullptr, p.type, p.value)
                 );
                 raw_parameter_assignment->line_no = stmt.line_no;
 
                 this->accept(*raw_parameter_assignment);
 
-                delete raw_parameter_assignment;
-
                 if(!symbol_table.does_symbol_exist(param_label))
                 {
-                    std::cerr << "Auto generated parameter variable in call to \"" << stmt.name << "\" did not exist after assignment" << std::endl;
-                    error_man.report_unknown_id(param_label, stmt.line_no, true); 
+                    error_man.output() << "Auto generated parameter variable in call to \"" << interner.name(stmt.name) << "\" did not exist after assignment" << std::endl;
+                    error_man.report_unknown_id(interner.name(param_label), stmt.line_no, true); 
                 }
 
                 // If the call works, which it should, then we update the id to the name of the varaible
@@ -911,8 +859,8 @@ namespace
         {
             if(stmt.params[i].type != callee_params[i].type)
             {
-                std::cerr << "Parameter \"" << stmt.params[i].id << "\" does not match expected type in paramter list of function \"" << stmt.name << "\"" << std::endl;
-                error_man.report_unallowed_type(stmt.params[i].id, stmt.line_no, true);
+                error_man.output() << "Parameter \"" << interner.name(stmt.params[i].id) << "\" does not match expected type in paramter list of function \"" << interner.name(stmt.name) << "\"" << std::endl;
+                error_man.report_unallowed_type(interner.name(stmt.params[i].id), stmt.line_no, true);
             }
         }
     }
@@ -921,6 +869,31 @@ namespace
     //
     // ----------------------------------------------------------
 
+    INTERMEDIATE::TYPES::Directive Analyzer::build_call_directive(Call & stmt)
+    {
+        INTERMEDIATE::TYPES::Directive directive;
+
+        directive.target = stmt.name;
+        directive.allocation.reserve(stmt.params.size());
+
+        // validate_call has given every parameter a variable, so each one has memory
+        for(auto & p : stmt.params)
+        {
+            Memory::MemAlloc mem_info = memory_man.get_mem_info(p.id);
+
+            directive.allocation.push_back(INTERMEDIATE::TYPES::DirectiveAllocation{
+                mem_info.start_pos,
+                mem_info.start_pos + mem_info.bytes_alloced
+            });
+        }
+
+        return directive;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
     ValType Analyzer::determine_expression_type(AST * ast, AST * traverse, bool left, int line_no)
     {
         if(ast->node_type == NodeType::VAL)
@@ -929,12 +902,11 @@ namespace
         }
         else if (ast->node_type == NodeType::ID)
         {
-            return get_id_type(ast->value, line_no);
+            return get_id_type(ast->symbol, line_no);
         }
         else if (ast->node_type == NodeType::CALL)
         {
-            Call * call = static_cast<Call*>(ast);
-            return call->val_type;
+            return ast->val_type;
         }
 
         if(left)
@@ -964,7 +936,7 @@ namespace
     //
     // ----------------------------------------------------------
 
-    void Analyzer::check_value_is_valid_for_assignment(int line_no, ValType type_to_check, INTERMEDIATE::TYPES::AssignmentClassifier & c, ValType & et, std::string & id)
+    void Analyzer::check_value_is_valid_for_assignment(int line_no, ValType type_to_check, INTERMEDIATE::TYPES::AssignmentClassifier & c, ValType & et, SymbolId & id)
     {
         switch(type_to_check)
         {
@@ -978,13 +950,13 @@ namespace
                 c = INTERMEDIATE::TYPES::AssignmentClassifier::DOUBLE;
                 if(et != ValType::REAL)
                 {
-                    std::string error_message = id;
+                    std::string error_message = interner.name(id);
 
                     // There are better ways to do this, but if it happens at all it will only happen once during the compiler run
                     // as we are about to die
-                    if(std::regex_match(id, std::regex("(__return__assignment__).*")))
+                    if(std::regex_match(error_message, std::regex("(__return__assignment__).*")))
                     {
-                        error_message = "Function (" + current_function->name + ")";
+                        error_message = "Function (" + interner.name(current_function->name) + ")";
                     } 
                     error_man.report_unallowed_type(error_message, line_no, true); 
                 }
@@ -994,13 +966,13 @@ namespace
             case ValType::INTEGER  :
             {
                 // We assume its an integer to start with so we dont set type (because we allow ints inside double exprs)
-                if(et != ValType::INTEGER) { error_man.report_unallowed_type(id, line_no, true); }
+                if(et != ValType::INTEGER) { error_man.report_unallowed_type(interner.name(id), line_no, true); }
                 break;
             }
             case ValType::CHAR     :
             {
                 c = INTERMEDIATE::TYPES::AssignmentClassifier::CHAR;
-                if(et != ValType::CHAR)   { error_man.report_unallowed_type(id, line_no, true); } // If Assignee isn't a char, we need to die
+                if(et != ValType::CHAR)   { error_man.report_unallowed_type(interner.name(id), line_no, true); } // If Assignee isn't a char, we need to die
                 break;
             }
         }
@@ -1010,29 +982,30 @@ namespace
     // Assignee's expected type abbreviated to 'et' 
     // ----------------------------------------------------------
 
-    std::string Analyzer::validate_assignment_ast(int line_no, AST * ast, INTERMEDIATE::TYPES::AssignmentClassifier & c, ValType & et, std::string & id)
+    void Analyzer::validate_assignment_ast(int line_no, AST * ast, INTERMEDIATE::TYPES::AssignmentClassifier & c, ValType & et, SymbolId & id, INTERMEDIATE::TYPES::Expression & expression)
     {
         switch(ast->node_type)
         {
             case NodeType::ID  : 
             {
                 // Ensure the ID is within current context. Allowing any type
-                ensure_id_in_current_context(ast->value, line_no, {});
+                ensure_id_in_current_context(ast->symbol, line_no, {});
 
                 // Check for promotion
-                ValType id_type = get_id_type(ast->value, line_no);
+                ValType id_type = get_id_type(ast->symbol, line_no);
 
                 // Make sure that the known value of the identifier is one valid given the current assignemnt
                 check_value_is_valid_for_assignment(line_no, id_type, c, et, id);
 
-                // Encode the identifier information so we can handle it in the intermediate layer
-                return endecoder.encode_identifier(ast->value);
+                // Resolve the identifier to its memory slot so the intermediate layer can index it directly
+                expression.add_identifier(memory_man.get_slot(ast->symbol));
+                return;
             }
             
             case NodeType::CALL :
             {
                 // We know its a call, so lets treat it like a call
-                Call * call = static_cast<Call*>(ast);
+                Call * call = ast->call;
 
                 // This call to validate_call will ensure that all parameters within the call exist in the system as variables
                 // and it will update the current object to the new information we need to pull addresses
@@ -1043,50 +1016,78 @@ namespace
                 // so we can use that value directly
                 check_value_is_valid_for_assignment(
                     line_no,
-                    symbol_table.get_return_type_of_context(call->name)
+                    symbol_table.get_function_return_type(call->name)
                     , c, et, id
                 );
                 
-                // Encode the call to something we can handle in the intermediate layer
-                return endecoder.encode_call(call);
+                // Describe the call to the intermediate layer
+                expression.add_call(build_call_directive(*call));
+                return;
             }
 
             case NodeType::VAL : 
             { 
                 // Check that the raw value is one that is valid within the current assignment
                 check_value_is_valid_for_assignment(line_no, ast->val_type, c, et, id);
-                return ast->value;
+
+                // The scanner has already decoded the raw value
+                switch(ast->val_type)
+                {
+                    case ValType::INTEGER: expression.add_integer(ValType::INTEGER, ast->value.integer); break;
+                    case ValType::CHAR:    expression.add_integer(ValType::CHAR,    ast->value.integer); break;
+                    case ValType::REAL:    expression.add_real(ast->value.real);                         break;
+                    default:               break; // Reported by the check above
+                }
+                return;
             }
-            
-            //  This is where we convert NodeType to the Assignment type. This should make it so we can change the actual tokens in the language
-            //  without having to modify this statement
-
-            case NodeType::ADD    :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " ADD    " );  
-            case NodeType::SUB    :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " SUB    " );
-            case NodeType::DIV    :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " DIV    " );
-            case NodeType::MUL    :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " MUL    " );
-            case NodeType::MOD    :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " MOD    " );
-            case NodeType::POW    :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " POW    " );
-            case NodeType::LTE    :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " LTE    " );
-            case NodeType::GTE    :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " GTE    " );
-            case NodeType::GT     :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " GT     " );
-            case NodeType::LT     :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " LT     " );
-            case NodeType::EQ     :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " EQ     " );
-            case NodeType::NE     :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " NE     " );
-            case NodeType::LSH    :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " LSH    " );
-            case NodeType::RSH    :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " RSH    " );
-            case NodeType::BW_OR  :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " BW_OR  " );
-            case NodeType::BW_XOR :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " BW_XOR " );
-            case NodeType::BW_AND :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " BW_AND " );
-            case NodeType::OR     :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " OR     " );
-            case NodeType::AND    :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " " + validate_assignment_ast(line_no, ast->r, c, et, id) + " AND    " );
-            case NodeType::BW_NOT :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " BW_NOT ");
-            case NodeType::NEGATE :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " NEGATE "  );
-            case NodeType::RETURN :return (validate_assignment_ast(line_no, ast->l, c, et, id) + " RETURN "  );
-            case NodeType::ROOT   : error_man.report_custom("Analyzer", "ROOT NODE found in arithmetic exp", true); break;
+
+            case NodeType::ROOT   : error_man.report_custom("Analyzer", "ROOT NODE found in arithmetic exp", true); return;
             default:
-            return "Its dead, jim";
+                break;
         }
-        return "Complete";
+
+        // Everything else is an operation on its operands, emitted in postfix order
+        CODEGEN::TYPES::InstructionSet operation;
+
+        //  This is where we convert NodeType to the instruction. This should make it so we can change the actual tokens in the language
+        //  without having to modify this statement
+        switch(ast->node_type)
+        {
+            case NodeType::ADD    : operation = CODEGEN::TYPES::InstructionSet::ADD;    break;
+            case NodeType::SUB    : operation = CODEGEN::TYPES::InstructionSet::SUB;    break;
+            case NodeType::DIV    : operation = CODEGEN::TYPES::InstructionSet::DIV;    break;
+            case NodeType::MUL    : operation = CODEGEN::TYPES::InstructionSet::MUL;    break;
+            case NodeType::MOD    : operation = CODEGEN::TYPES::InstructionSet::MOD;    break;
+            case NodeType::POW    : operation = CODEGEN::TYPES::InstructionSet::POW;    break;
+            case NodeType::LTE    : operation = CODEGEN::TYPES::InstructionSet::LTE;    break;
+            case NodeType::GTE    : operation = CODEGEN::TYPES::InstructionSet::GTE;    break;
+            case NodeType::GT     : operation = CODEGEN::TYPES::InstructionSet::GT;     break;
+            case NodeType::LT     : operation = CODEGEN::TYPES::InstructionSet::LT;     break;
+            case NodeType::EQ     : operation = CODEGEN::TYPES::InstructionSet::EQ;     break;
+            case NodeType::NE     : operation = CODEGEN::TYPES::InstructionSet::NE;     break;
+            case NodeType::LSH    : operation = CODEGEN::TYPES::InstructionSet::LSH;    break;
+            case NodeType::RSH    : operation = CODEGEN::TYPES::InstructionSet::RSH;    break;
+            case NodeType::BW_OR  : operation = CODEGEN::TYPES::InstructionSet::BW_OR;  break;
+            case NodeType::BW_XOR : operation = CODEGEN::TYPES::InstructionSet::BW_XOR; break;
+            case NodeType::BW_AND : operation = CODEGEN::TYPES::InstructionSet::BW_AND; break;
+            case NodeType::OR     : operation = CODEGEN::TYPES::InstructionSet::OR;     break;
+            case NodeType::AND    : operation = CODEGEN::TYPES::InstructionSet::AND;    break;
+            case NodeType::BW_NOT : operation = CODEGEN::TYPES::InstructionSet::BW_NOT; break;
+            case NodeType::NEGATE : operation = CODEGEN::TYPES::InstructionSet::NEGATE; break;
+            case NodeType::RETURN : operation = CODEGEN::TYPES::InstructionSet::RETURN; break;
+            default:
+                error_man.report_custom("Analyzer", " Developer Error: Unhandled node type found in arithmetic exp", true);
+                return;
+        }
+
+        validate_assignment_ast(line_no, ast->l, c, et, id, expression);
+
+        // Unary operations only have a left side
+        if(ast->r != nullptr)
+        {
+            validate_assignment_ast(line_no, ast->r, c, et, id, expression);
+        }
+
+        expression.add_operation(operation);
     }
 }
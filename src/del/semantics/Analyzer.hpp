@@ -2,12 +2,12 @@
 #define DEL_ANALYZER_HPP
 
 #include "Ast.hpp"
+#include "Arena.hpp"
 #include "Errors.hpp"
 #include "SymbolTable.hpp"
 #include "Codegen.hpp"
 #include "Intermediate.hpp"
 #include "IntermediateTypes.hpp"
-#include "EnDecode.hpp"
 
 namespace DEL
 {
@@ -19,11 +19,16 @@ namespace DEL
         //! \brief Construct an analyzer
         //! \param err The error manager
         //! \param The symbol table
-        Analyzer(Errors & err, SymbolTable & symbolTable, Codegen & code_gen, Memory & memory);
+        //! \param arena The arena that owns the AST, reset after each function is built
+        //! \param interner The interner that identifiers were drawn from
+        Analyzer(Errors & err, SymbolTable & symbolTable, Codegen & code_gen, Memory & memory, Arena & arena, Interner & interner);
 
         //! \brief Deconstruct tha analyzer
         ~Analyzer();
 
+        //! \brief Forget the program analyzed so far so another can be analyzed
+        void reset();
+
         //! \brief Check for finalization
         //!        If the program can not be finalized an error will be thrown
         void check_for_finalization();
@@ -44,11 +49,11 @@ namespace DEL
 
     private:
 
-        void ensure_unique_symbol(std::string id, int line_no);
+        void ensure_unique_symbol(SymbolId id, int line_no);
 
-        void ensure_id_in_current_context(std::string id, int line_no, std::vector<ValType> allowed);
+        void ensure_id_in_current_context(SymbolId id, int line_no, std::vector<ValType> allowed);
 
-        ValType get_id_type(std::string id, int line_no);
+        ValType get_id_type(SymbolId id, int line_no);
 
         void validate_step(int line, Step * step, ValType loop_type);
 
@@ -56,26 +61,32 @@ namespace DEL
 
         void validate_call(Call & stmt);
 
+        // Build the directive that tells the intermediate layer where a validated call's arguments live
+        INTERMEDIATE::TYPES::Directive build_call_directive(Call & stmt);
+
         void build_if_stmt(If & stmt);
 
         // Given an expression attempt to determine the type that should result from its execution
         ValType determine_expression_type(AST * ast, AST * traverse, bool left_traversal, int line_no);
 
         // Check that a given value is valid within the scope of an assignment 
-        void check_value_is_valid_for_assignment(int line_no, ValType type_to_check, INTERMEDIATE::TYPES::AssignmentClassifier & classifier, ValType & assignee_type, std::string & id);
+        void check_value_is_valid_for_assignment(int line_no, ValType type_to_check, INTERMEDIATE::TYPES::AssignmentClassifier & classifier, ValType & assignee_type, SymbolId & id);
 
-        // Validate an assignment ast
-        std::string validate_assignment_ast(int line_no, AST * ast, INTERMEDIATE::TYPES::AssignmentClassifier & classifier, ValType & assignee_type, std::string & id);
+        // Validate an assignment ast, appending it to the expression in postfix order
+        void validate_assignment_ast(int line_no, AST * ast, INTERMEDIATE::TYPES::AssignmentClassifier & classifier, ValType & assignee_type, SymbolId & id, INTERMEDIATE::TYPES::Expression & expression);
 
         Errors & error_man;             // Error manager
         SymbolTable & symbol_table;     // Symbol table
         Memory & memory_man;            // Memory manager
-        EnDecode endecoder;
+        Arena & arena;                  // AST storage
+        Interner & interner;            // Identifier names
         Intermediate intermediate_layer;
 
         Function * current_function;
 
-        std::vector<std::string> loop_names;
+        SymbolId main_symbol;           // Id of "main"
+
+        std::vector<SymbolId> loop_names;
 
         struct FunctionWatch
         {
@@ -0,0 +1,94 @@
+#include "JobPool.hpp"
+
+#include <thread>
+
+namespace DEL
+{
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    JobPool::JobPool(std::size_t threads)
+    {
+        if(threads == 0) { threads = 1; }
+
+        for(std::size_t i = 0; i < threads; i++)
+        {
+            queues.emplace_back(new Queue());
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void JobPool::run(std::size_t count, const std::function<void(std::size_t)> & job)
+    {
+        // Deal the jobs out. Nothing is running yet so the queues don't need locking
+        for(std::size_t i = 0; i < count; i++)
+        {
+            queues[i % queues.size()]->jobs.push_back(i);
+        }
+
+        // The calling thread works as well, as worker 0
+        std::vector<std::thread> workers;
+        for(std::size_t i = 1; i < queues.size() && i < count; i++)
+        {
+            workers.emplace_back(&JobPool::work, this, i, std::cref(job));
+        }
+
+        work(0, job);
+
+        for(auto & worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void JobPool::work(std::size_t worker, const std::function<void(std::size_t)> & job)
+    {
+        std::size_t next;
+        while(take(worker, next))
+        {
+            job(next);
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool JobPool::take(std::size_t worker, std::size_t & job)
+    {
+        // Own queue first, newest job
+        {
+            Queue & own = *queues[worker];
+            std::lock_guard<std::mutex> guard(own.lock);
+            if(!own.jobs.empty())
+            {
+                job = own.jobs.back();
+                own.jobs.pop_back();
+                return true;
+            }
+        }
+
+        // Then steal the oldest job of another worker. Jobs are never added once running,
+        // so if every queue is empty there is nothing left to do
+        for(std::size_t i = 1; i < queues.size(); i++)
+        {
+            Queue & victim = *queues[(worker + i) % queues.size()];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if(!victim.jobs.empty())
+            {
+                job = victim.jobs.front();
+                victim.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+}
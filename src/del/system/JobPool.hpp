@@ -0,0 +1,46 @@
+#ifndef DEL_JOB_POOL_HPP
+#define DEL_JOB_POOL_HPP
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace DEL
+{
+    //! \brief Runs a known set of jobs across worker threads. Each worker takes jobs from the back of its
+    //!        own queue, and once that runs dry steals from the front of the others, so a worker that drew
+    //!        a few long jobs does not hold up the rest
+    class JobPool
+    {
+    public:
+        //! \brief Create the pool
+        //! \param threads Number of worker threads, at least one will be used
+        JobPool(std::size_t threads);
+
+        JobPool(const JobPool&) = delete;
+        JobPool& operator=(const JobPool&) = delete;
+
+        //! \brief Run jobs 0 through count - 1, returning once all have completed
+        //! \param count Number of jobs
+        //! \param job Called once with the index of each job. Calls are made from many threads at once
+        void run(std::size_t count, const std::function<void(std::size_t)> & job);
+
+    private:
+
+        struct Queue
+        {
+            std::mutex lock;
+            std::deque<std::size_t> jobs;
+        };
+
+        void work(std::size_t worker, const std::function<void(std::size_t)> & job);
+        bool take(std::size_t worker, std::size_t & job);
+
+        std::vector<std::unique_ptr<Queue>> queues;
+    };
+}
+
+#endif
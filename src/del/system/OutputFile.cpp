@@ -0,0 +1,49 @@
+#include "OutputFile.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace DEL
+{
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    bool OutputFile::write(const std::string & path, const void * data, std::size_t size)
+    {
+        // Keep the temporary in the same directory so the rename can't cross file systems
+        std::string temp_path = path + ".tmp." + std::to_string(::getpid());
+
+        int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if(fd < 0)
+        {
+            return false;
+        }
+
+        // A single write normally takes everything, but regular files are allowed to come up short
+        const char * remaining = static_cast<const char *>(data);
+        while(size > 0)
+        {
+            ssize_t written = ::write(fd, remaining, size);
+            if(written < 0)
+            {
+                if(errno == EINTR) { continue; }
+
+                ::close(fd);
+                ::unlink(temp_path.c_str());
+                return false;
+            }
+            remaining += written;
+            size      -= static_cast<std::size_t>(written);
+        }
+
+        if(::close(fd) != 0 || std::rename(temp_path.c_str(), path.c_str()) != 0)
+        {
+            ::unlink(temp_path.c_str());
+            return false;
+        }
+        return true;
+    }
+}
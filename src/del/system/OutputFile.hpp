@@ -0,0 +1,24 @@
+#ifndef DEL_OUTPUT_FILE_HPP
+#define DEL_OUTPUT_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace DEL
+{
+    //! \brief Writes result files. The contents go to a temporary file next to the destination
+    //!        in a single write and are then renamed into place, so a reader only ever sees
+    //!        the previous file or the complete new one
+    class OutputFile
+    {
+    public:
+        //! \brief Write a file
+        //! \param path The destination
+        //! \param data The contents
+        //! \param size Number of bytes in data
+        //! \returns true if the file is in place, false if nothing was changed
+        static bool write(const std::string & path, const void * data, std::size_t size);
+    };
+}
+
+#endif
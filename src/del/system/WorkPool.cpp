@@ -0,0 +1,127 @@
+#include "WorkPool.hpp"
+
+namespace DEL
+{
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    WorkPool::WorkPool(std::size_t threads) : active(0),
+                                              stopping(false)
+    {
+        if(threads == 0) { threads = 1; }
+
+        for(std::size_t i = 0; i < threads; i++)
+        {
+            workers.emplace_back(&WorkPool::run, this);
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    WorkPool::~WorkPool()
+    {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            work_complete.wait(guard, [this]() { return tasks.empty() && active == 0; });
+            stopping = true;
+        }
+        work_available.notify_all();
+
+        for(auto & worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void WorkPool::submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            tasks.push_back(std::move(task));
+        }
+        work_available.notify_one();
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void WorkPool::wait()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        work_complete.wait(guard, [this]() { return tasks.empty() && active == 0; });
+
+        if(failure)
+        {
+            std::exception_ptr thrown = failure;
+            failure = nullptr;
+            std::rethrow_exception(thrown);
+        }
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    std::size_t WorkPool::default_thread_count()
+    {
+        std::size_t count = std::thread::hardware_concurrency();
+        return (count == 0) ? 1 : count;
+    }
+
+    // ----------------------------------------------------------
+    //
+    // ----------------------------------------------------------
+
+    void WorkPool::run()
+    {
+        while(true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                work_available.wait(guard, [this]() { return stopping || !tasks.empty(); });
+
+                if(tasks.empty())
+                {
+                    return;
+                }
+
+                task = std::move(tasks.front());
+                tasks.pop_front();
+                active++;
+            }
+
+            // Nothing may escape the worker, the caller finds out through wait()
+            std::exception_ptr thrown;
+            try
+            {
+                task();
+            }
+            catch(...)
+            {
+                thrown = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if(thrown && !failure)
+                {
+                    failure = thrown;
+                }
+                active--;
+                if(tasks.empty() && active == 0)
+                {
+                    work_complete.notify_all();
+                }
+            }
+        }
+    }
+}
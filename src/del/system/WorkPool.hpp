@@ -0,0 +1,58 @@
+#ifndef DEL_WORK_POOL_HPP
+#define DEL_WORK_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DEL
+{
+    //! \brief A fixed set of worker threads that execute submitted tasks
+    class WorkPool
+    {
+    public:
+        //! \brief Create the pool
+        //! \param threads Number of worker threads, at least one will be created
+        WorkPool(std::size_t threads);
+
+        //! \brief Waits for all submitted work and joins the workers. A failure no one waited for is dropped
+        ~WorkPool();
+
+        WorkPool(const WorkPool&) = delete;
+        WorkPool& operator=(const WorkPool&) = delete;
+
+        //! \brief Submit a task. Tasks may submit further tasks
+        //! \param task The task to run. Anything it throws is caught and handed to the next call to wait()
+        void submit(std::function<void()> task);
+
+        //! \brief Block until every submitted task, including those submitted by tasks, has completed
+        //! \post If any task threw, the first exception thrown is rethrown here. The other tasks still ran
+        void wait();
+
+        //! \brief Get a sensible default number of workers for the machine
+        static std::size_t default_thread_count();
+
+    private:
+
+        void run();
+
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+
+        std::mutex lock;
+        std::condition_variable work_available;
+        std::condition_variable work_complete;
+
+        std::size_t active;
+        bool stopping;
+
+        std::exception_ptr failure;     // First exception thrown by a task since the last wait()
+    };
+}
+
+#endif
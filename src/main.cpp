@@ -1,9 +1,16 @@
+#include <algorithm>
 #include <iostream>
+#include <iomanip>
 #include <string>
+#include <sstream>
 #include <chrono>
+#include <filesystem>
+#include <set>
 #include <vector>
 
 #include "del/del_driver.hpp"
+#include "del/del_server.hpp"
+#include "del/system/JobPool.hpp"
 
 namespace
 {
@@ -17,7 +24,9 @@ namespace
     std::vector<Args> DelArguments;
 }
 
-int handle_compilation(std::string file);
+int handle_compilation(std::string file, bool peephole_report, std::size_t jobs);
+
+int handle_batch(const std::vector<std::string> & files, std::string output_dir, bool emit_asm, bool peephole_report, std::size_t jobs);
 
 void show_help();
 
@@ -38,12 +47,24 @@ int main(int argc, char ** argv)
     DelArguments = {
 
         { "-h", "--help   ",    "Display help message."},
-        { "-v", "--version",    "Display the version of Del." }
+        { "-v", "--version",    "Display the version of Del." },
+        { "-a", "--asm    ",    "Write the generated ASM next to each output of many files. A single file always writes del.asm" },
+        { "-j", "--jobs N ",    "Use N threads. 0 uses every core. Default 1, or every core for many files" },
+        { "-o", "--out DIR",    "Write outputs to DIR, named after each input. Any number of inputs may be given" },
+        { "-p", "--peephole",   "Report how many times each peephole optimization was applied" },
+        { "-s", "--serve SOCK", "Stay resident and compile files sent as requests over the unix socket SOCK" }
     };
     
     std::vector<std::string> args(argv, argv + argc);
 
-    for(int i = 0; i < argc; i++)
+    std::vector<std::string> input_files;
+    std::string output_dir;
+    std::string serve_socket;
+    bool emit_asm = false;
+    bool peephole_report = false;
+    std::size_t jobs = 0;
+
+    for(int i = 1; i < argc; i++)
     {
         //  Help
         //
@@ -60,24 +81,229 @@ int main(int argc, char ** argv)
             show_version();
             return 0;
         }
+
+        // Keep the ASM
+        //
+        if(args[i] == "-a" || args[i] == "--asm")
+        {
+            emit_asm = true;
+            continue;
+        }
+
+        // Peephole counts
+        //
+        if(args[i] == "-p" || args[i] == "--peephole")
+        {
+            peephole_report = true;
+            continue;
+        }
+
+        // Worker threads
+        //
+        if(args[i] == "-j" || args[i] == "--jobs")
+        {
+            if(i + 1 >= argc || args[i+1].empty() || args[i+1].find_first_not_of("0123456789") != std::string::npos)
+            {
+                std::cout << "Expected a number of jobs after " << args[i] << ". Use -h for help" << std::endl;
+                return 1;
+            }
+
+            jobs = std::stoul(args[++i]);
+
+            if(jobs == 0)
+            {
+                jobs = DEL::WorkPool::default_thread_count();
+            }
+            continue;
+        }
+
+        // Output directory
+        //
+        if(args[i] == "-o" || args[i] == "--out")
+        {
+            if(i + 1 >= argc || args[i+1].empty())
+            {
+                std::cout << "Expected a directory after " << args[i] << ". Use -h for help" << std::endl;
+                return 1;
+            }
+
+            output_dir = args[++i];
+            continue;
+        }
+
+        // Compile server
+        //
+        if(args[i] == "-s" || args[i] == "--serve")
+        {
+            if(i + 1 >= argc || args[i+1].empty())
+            {
+                std::cout << "Expected a socket path after " << args[i] << ". Use -h for help" << std::endl;
+                return 1;
+            }
+
+            serve_socket = args[++i];
+            continue;
+        }
+
+        // Anything that isn't a flag is a file to compile
+        //
+        if(args[i][0] != '-')
+        {
+            input_files.push_back(args[i]);
+            continue;
+        }
+
+        std::cout << "Unknown argument : " << args[i] << ". Use -h for help" << std::endl;
+        return 1;
+    }
+
+    if(!serve_socket.empty())
+    {
+        if(!input_files.empty() || !output_dir.empty() || emit_asm || peephole_report)
+        {
+            std::cout << "Files and outputs are given with each request when serving. Use -h for help" << std::endl;
+            return 1;
+        }
+
+        DEL::DEL_Server server(serve_socket);
+        return server.serve();
     }
 
-    return handle_compilation(args[1]);
+    if(input_files.empty())
+    {
+        std::cout << "No input file given. Use -h for help" << std::endl;
+        return 1;
+    }
+
+    if(input_files.size() == 1 && output_dir.empty())
+    {
+        return handle_compilation(input_files[0], peephole_report, jobs);
+    }
+
+    return handle_batch(input_files, (output_dir.empty()) ? "." : output_dir, emit_asm, peephole_report, jobs);
 }
 
 // --------------------------------------------
 // Compile
 // --------------------------------------------
     
-int handle_compilation(std::string file)
+int handle_compilation(std::string file, bool peephole_report, std::size_t jobs)
 {
     DEL::DEL_Driver driver;
 
+    // del.asm is always written alongside del.out for a single file
+    driver.set_peephole_report(peephole_report);
+
+    if(jobs > 0)
+    {
+        driver.set_worker_count(jobs);
+    }
+
     driver.parse(file.c_str());
 
     return 0;
 }
 
+// --------------------------------------------
+// Compile many
+// --------------------------------------------
+
+int handle_batch(const std::vector<std::string> & files, std::string output_dir, bool emit_asm, bool peephole_report, std::size_t jobs)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(output_dir, ec);
+
+    if(!std::filesystem::is_directory(output_dir))
+    {
+        std::cerr << "Unable to use \"" << output_dir << "\" as an output directory" << std::endl;
+        return 1;
+    }
+
+    // Outputs are named after their inputs, so two inputs can't share a name
+    std::vector<std::string> output_names;
+    std::set<std::string> used;
+    for(auto & f : files)
+    {
+        std::string name = std::filesystem::path(f).stem().string();
+        if(!used.insert(name).second)
+        {
+            std::cerr << "More than one input would be written to \"" << name << "\" in " << output_dir << std::endl;
+            return 1;
+        }
+        output_names.push_back((std::filesystem::path(output_dir) / name).string());
+    }
+
+    struct Result
+    {
+        bool compiled = false;
+        std::string diagnostics;
+        DEL::PeepholeStats peephole;
+    };
+    std::vector<Result> results(files.size());
+
+    if(jobs == 0)
+    {
+        jobs = DEL::WorkPool::default_thread_count();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Each job gets a driver of its own. Errors are kept with the job and shown once all are done
+    DEL::JobPool pool(jobs);
+    pool.run(files.size(), [&](std::size_t job)
+    {
+        std::ostringstream diagnostics;
+
+        // Anything the driver doesn't turn into an error of its own, like a failed allocation or
+        // an unusable output path, fails the job rather than the process
+        try
+        {
+            DEL::DEL_Driver driver;
+            driver.set_batch_mode(diagnostics);
+            driver.set_asm_output(emit_asm);
+            driver.set_output_name(output_names[job]);
+
+            results[job].compiled = driver.parse(files[job].c_str());
+            results[job].peephole = driver.get_peephole_stats();
+        }
+        catch(std::exception & e)
+        {
+            results[job].compiled = false;
+            diagnostics << "Unexpected failure : " << e.what() << std::endl;
+        }
+        results[job].diagnostics = diagnostics.str();
+    });
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::size_t compiled = 0;
+    DEL::PeepholeStats peephole;
+    for(std::size_t i = 0; i < files.size(); i++)
+    {
+        if(results[i].compiled)
+        {
+            compiled++;
+            peephole += results[i].peephole;
+            continue;
+        }
+
+        std::cerr << ">>> Failed : " << files[i] << std::endl << results[i].diagnostics;
+    }
+
+    std::cout << ">>> Compiled " << compiled << " of " << files.size() << " files in "
+              << std::fixed << std::setprecision(3) << elapsed.count() << "s ("
+              << std::setprecision(1) << (files.size() / std::max(elapsed.count(), 1e-9)) << " files/s, "
+              << jobs << " threads)" << std::endl
+              << "Output directory   : " << output_dir << std::endl;
+
+    if(peephole_report)
+    {
+        peephole.report(std::cout);
+    }
+
+    return (compiled == files.size()) ? 0 : 1;
+}
+
 // --------------------------------------------
 // Show help
 // --------------------------------------------
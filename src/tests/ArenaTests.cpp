@@ -0,0 +1,154 @@
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Arena.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+namespace
+{
+    //  Records its destruction, so the order can be checked
+    struct Tracked
+    {
+        Tracked(std::vector<int> & log, int id) : log(log), id(id) {}
+        ~Tracked() { log.push_back(id); }
+
+        std::vector<int> & log;
+        int id;
+    };
+
+    struct alignas(32) Wide
+    {
+        char bytes[32];
+    };
+
+    struct Large
+    {
+        char bytes[1000];
+    };
+}
+
+TEST_GROUP(ArenaTests)
+{
+    // Small blocks so the tests cross them quickly
+    DEL::Arena arena{256};
+};
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(ArenaTests, objectsAreConstructed)
+{
+    std::string * s = arena.make<std::string>(3, 'x');
+    int * i = arena.make<int>(42);
+
+    STRCMP_EQUAL("xxx", s->c_str());
+    LONGS_EQUAL(42, *i);
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(ArenaTests, resetReusesMemory)
+{
+    std::vector<void*> first;
+    for(int i = 0; i < 100; i++)
+    {
+        first.push_back(arena.make<uint64_t>(i));
+    }
+
+    arena.reset();
+
+    // The same sequence of requests is given the same memory, blocks and all
+    for(int i = 0; i < 100; i++)
+    {
+        POINTERS_EQUAL(first[i], arena.make<uint64_t>(i));
+    }
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(ArenaTests, resetRunsDestructorsInReverse)
+{
+    std::vector<int> log;
+    arena.make<Tracked>(log, 1);
+    arena.make<Tracked>(log, 2);
+    arena.make<Tracked>(log, 3);
+
+    CHECK_TRUE(log.empty());
+    arena.reset();
+
+    LONGS_EQUAL(3, log.size());
+    LONGS_EQUAL(3, log[0]);
+    LONGS_EQUAL(2, log[1]);
+    LONGS_EQUAL(1, log[2]);
+
+    // Each object is only destroyed once
+    arena.reset();
+    LONGS_EQUAL(3, log.size());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(ArenaTests, destructorRunsWhatIsLeft)
+{
+    std::vector<int> log;
+    {
+        DEL::Arena local(256);
+        local.make<Tracked>(log, 1);
+        local.reset();
+        local.make<Tracked>(log, 2);
+    }
+
+    LONGS_EQUAL(2, log.size());
+    LONGS_EQUAL(1, log[0]);
+    LONGS_EQUAL(2, log[1]);
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(ArenaTests, objectsAreAligned)
+{
+    for(int i = 0; i < 20; i++)
+    {
+        arena.make<char>('a');
+        Wide * wide = arena.make<Wide>();
+        UNSIGNED_LONGS_EQUAL(0, reinterpret_cast<uintptr_t>(wide) % alignof(Wide));
+
+        arena.make<char>('b');
+        double * d = arena.make<double>(1.5);
+        UNSIGNED_LONGS_EQUAL(0, reinterpret_cast<uintptr_t>(d) % alignof(double));
+    }
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(ArenaTests, objectsLargerThanABlock)
+{
+    uint64_t * before = arena.make<uint64_t>(1);
+    Large * large = arena.make<Large>();
+    std::memset(large->bytes, 0xAB, sizeof(large->bytes));
+    uint64_t * after = arena.make<uint64_t>(2);
+
+    // Filling the large object mustn't touch its neighbours
+    UNSIGNED_LONGS_EQUAL(1, *before);
+    UNSIGNED_LONGS_EQUAL(2, *after);
+
+    // And after a reset the large block is still usable for one as large
+    arena.reset();
+    arena.make<uint64_t>(1);
+    Large * again = arena.make<Large>();
+    std::memset(again->bytes, 0xCD, sizeof(again->bytes));
+}
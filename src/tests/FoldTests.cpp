@@ -0,0 +1,233 @@
+#include <cstdint>
+
+#include "Intermediate.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+namespace
+{
+    typedef DEL::CODEGEN::TYPES::InstructionSet Op;
+    typedef DEL::INTERMEDIATE::TYPES::AssignmentClassifier Classifier;
+    typedef DEL::INTERMEDIATE::TYPES::ExpressionItemType ItemType;
+
+    uint64_t as_word(int64_t value)
+    {
+        return static_cast<uint64_t>(value);
+    }
+}
+
+TEST_GROUP(FoldTests)
+{
+    DEL::INTERMEDIATE::TYPES::Expression expression;
+
+    DEL::INTERMEDIATE::TYPES::Expression fold(Classifier classification = Classifier::INTEGER)
+    {
+        return DEL::Intermediate::fold(classification, expression);
+    }
+
+    uint64_t integer(Op op, int64_t lhs, int64_t rhs)
+    {
+        uint64_t result = 0;
+        CHECK_TRUE(DEL::Intermediate::fold_integer(op, as_word(lhs), as_word(rhs), result));
+        return result;
+    }
+
+    bool folds(Op op, int64_t lhs, int64_t rhs)
+    {
+        uint64_t result = 0;
+        return DEL::Intermediate::fold_integer(op, as_word(lhs), as_word(rhs), result);
+    }
+
+    //  The folded expression is a single integer with the given value
+    void check_integer(const DEL::INTERMEDIATE::TYPES::Expression & folded, uint64_t value)
+    {
+        LONGS_EQUAL(1, folded.items.size());
+        CHECK(folded.items[0].type == ItemType::VALUE);
+        UNSIGNED_LONGS_EQUAL(value, folded.items[0].integer);
+    }
+};
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(FoldTests, logicalOperatorsTestGreaterThanZero)
+{
+    // Only values above zero count as true, the same as the VM
+    UNSIGNED_LONGS_EQUAL(1, integer(Op::AND, 2, 3));
+    UNSIGNED_LONGS_EQUAL(0, integer(Op::AND, 0, 3));
+    UNSIGNED_LONGS_EQUAL(0, integer(Op::AND, -1, 3));
+
+    UNSIGNED_LONGS_EQUAL(1, integer(Op::OR, 0, 4));
+    UNSIGNED_LONGS_EQUAL(0, integer(Op::OR, 0, 0));
+    UNSIGNED_LONGS_EQUAL(0, integer(Op::OR, -3, 0));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(FoldTests, notTestsGreaterThanZero)
+{
+    expression.add_integer(DEL::ValType::INTEGER, 5);
+    expression.add_operation(Op::NEGATE);
+    check_integer(fold(), 0);
+
+    expression.items.clear();
+    expression.add_integer(DEL::ValType::INTEGER, 0);
+    expression.add_operation(Op::NEGATE);
+    check_integer(fold(), 1);
+
+    expression.items.clear();
+    expression.add_integer(DEL::ValType::INTEGER, as_word(-2));
+    expression.add_operation(Op::NEGATE);
+    check_integer(fold(), 1);
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(FoldTests, comparisonsGiveOneOrZero)
+{
+    // Compared as signed values
+    UNSIGNED_LONGS_EQUAL(1, integer(Op::LT, -1, 1));
+    UNSIGNED_LONGS_EQUAL(0, integer(Op::GT, -1, 1));
+    UNSIGNED_LONGS_EQUAL(1, integer(Op::LTE, 2, 2));
+    UNSIGNED_LONGS_EQUAL(0, integer(Op::GTE, 1, 2));
+    UNSIGNED_LONGS_EQUAL(1, integer(Op::EQ, 7, 7));
+    UNSIGNED_LONGS_EQUAL(0, integer(Op::NE, 7, 7));
+
+    // Doubles are compared by the VM
+    double real = 0.0;
+    CHECK_FALSE(DEL::Intermediate::fold_real(Op::LT, 1.0, 2.0, real));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(FoldTests, arithmetic)
+{
+    UNSIGNED_LONGS_EQUAL(as_word(-3), integer(Op::SUB, 2, 5));
+    UNSIGNED_LONGS_EQUAL(as_word(-2), integer(Op::DIV, -7, 3));
+    UNSIGNED_LONGS_EQUAL(as_word(INT64_MIN), integer(Op::LSH, 1, 63));
+    UNSIGNED_LONGS_EQUAL(2, integer(Op::RSH, 17, 3));
+
+    double real = 0.0;
+    CHECK_TRUE(DEL::Intermediate::fold_real(Op::DIV, 1.0, 4.0, real));
+    DOUBLES_EQUAL(0.25, real, 0.0);
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(FoldTests, operationsTheVmMightDisagreeWithAreLeft)
+{
+    CHECK_FALSE(folds(Op::DIV, 1, 0));
+    CHECK_FALSE(folds(Op::DIV, INT64_MIN, -1));
+    CHECK_FALSE(folds(Op::LSH, 1, 64));
+    CHECK_FALSE(folds(Op::RSH, 1, 64));
+    CHECK_FALSE(folds(Op::RSH, -8, 1));
+
+    double real = 0.0;
+    CHECK_FALSE(DEL::Intermediate::fold_real(Op::DIV, 1.0, 0.0, real));
+
+    // And the expression keeps the operation for the VM to carry out
+    expression.add_integer(DEL::ValType::INTEGER, 1);
+    expression.add_integer(DEL::ValType::INTEGER, 0);
+    expression.add_operation(Op::DIV);
+    LONGS_EQUAL(3, fold().items.size());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(FoldTests, integersArePromotedInDoubleExpressions)
+{
+    expression.add_integer(DEL::ValType::INTEGER, 3);
+    expression.add_real(0.5);
+    expression.add_operation(Op::MUL);
+
+    DEL::INTERMEDIATE::TYPES::Expression folded = fold(Classifier::DOUBLE);
+    LONGS_EQUAL(1, folded.items.size());
+    CHECK(folded.items[0].value_type == DEL::ValType::REAL);
+    DOUBLES_EQUAL(1.5, folded.items[0].real, 0.0);
+
+    // Even when both sides are integers
+    expression.items.clear();
+    expression.add_integer(DEL::ValType::INTEGER, 1);
+    expression.add_integer(DEL::ValType::INTEGER, 2);
+    expression.add_operation(Op::DIV);
+
+    folded = fold(Classifier::DOUBLE);
+    LONGS_EQUAL(1, folded.items.size());
+    DOUBLES_EQUAL(0.5, folded.items[0].real, 0.0);
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(FoldTests, identities)
+{
+    // x * 0 is 0
+    expression.add_identifier(0);
+    expression.add_integer(DEL::ValType::INTEGER, 0);
+    expression.add_operation(Op::MUL);
+    check_integer(fold(), 0);
+
+    // x - x is 0
+    expression.items.clear();
+    expression.add_identifier(0);
+    expression.add_identifier(0);
+    expression.add_operation(Op::SUB);
+    check_integer(fold(), 0);
+
+    // 0 + x is x
+    expression.items.clear();
+    expression.add_integer(DEL::ValType::INTEGER, 0);
+    expression.add_identifier(1);
+    expression.add_operation(Op::ADD);
+
+    DEL::INTERMEDIATE::TYPES::Expression folded = fold();
+    LONGS_EQUAL(1, folded.items.size());
+    CHECK(folded.items[0].type == ItemType::IDENTIFIER);
+
+    // But not for doubles, where -0 + 0 is 0
+    LONGS_EQUAL(3, fold(Classifier::DOUBLE).items.size());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(FoldTests, identitiesKeepOperandsWithEffects)
+{
+    // The call has to be made even though its result is not needed
+    expression.add_call(DEL::INTERMEDIATE::TYPES::Directive{});
+    expression.add_integer(DEL::ValType::INTEGER, 0);
+    expression.add_operation(Op::MUL);
+    LONGS_EQUAL(3, fold().items.size());
+
+    // A division may stop the VM, so it isn't thrown away either
+    expression.items.clear();
+    expression.add_identifier(0);
+    expression.add_identifier(1);
+    expression.add_operation(Op::DIV);
+    expression.add_integer(DEL::ValType::INTEGER, 0);
+    expression.add_operation(Op::BW_AND);
+    LONGS_EQUAL(5, fold().items.size());
+
+    // Identities that keep the call are still fine
+    expression.items.clear();
+    expression.add_call(DEL::INTERMEDIATE::TYPES::Directive{});
+    expression.add_integer(DEL::ValType::INTEGER, 1);
+    expression.add_operation(Op::MUL);
+
+    DEL::INTERMEDIATE::TYPES::Expression folded = fold();
+    LONGS_EQUAL(1, folded.items.size());
+    CHECK(folded.items[0].type == ItemType::CALL);
+}
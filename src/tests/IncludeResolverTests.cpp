@@ -0,0 +1,92 @@
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+#include "IncludeResolver.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+TEST_GROUP(IncludeResolverTests)
+{
+    DEL::IncludeResolver resolver;
+    std::string dir;
+
+    void setup()
+    {
+        char pattern[] = "/tmp/del_include_XXXXXX";
+        CHECK(::mkdtemp(pattern) != nullptr);
+        dir = pattern;
+    }
+
+    void teardown()
+    {
+        ::unlink((dir + "/a.del").c_str());
+        ::unlink((dir + "/b.del").c_str());
+        ::rmdir(dir.c_str());
+    }
+
+    void create(const std::string & name)
+    {
+        std::ofstream(dir + "/" + name) << "def f() -> nil { return; }\n";
+    }
+};
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(IncludeResolverTests, resolvesWithinSearchDirectories)
+{
+    create("a.del");
+    CHECK_FALSE(resolver.add_directory(dir + "/a.del"));
+    CHECK_TRUE(resolver.add_directory(dir));
+
+    std::string path;
+    CHECK_TRUE(resolver.resolve("a.del", path));
+    STRCMP_EQUAL((dir + "/a.del").c_str(), path.c_str());
+    CHECK_FALSE(resolver.resolve("b.del", path));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(IncludeResolverTests, resetForgetsSearchDirectoriesAndIncludes)
+{
+    create("a.del");
+    resolver.add_directory(dir);
+
+    std::string path;
+    CHECK_TRUE(resolver.resolve("a.del", path));
+    CHECK_TRUE(resolver.mark_included(path));
+    CHECK_FALSE(resolver.mark_included(path));
+
+    resolver.reset();
+
+    CHECK_FALSE(resolver.resolve("a.del", path));
+    CHECK_TRUE(resolver.mark_included(dir + "/a.del"));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(IncludeResolverTests, keptListingSeesNewFiles)
+{
+    create("a.del");
+    resolver.add_directory(dir);
+
+    std::string path;
+    CHECK_TRUE(resolver.resolve("a.del", path));
+    CHECK_FALSE(resolver.resolve("b.del", path));
+
+    // Added between compilations, as a server would see it
+    create("b.del");
+    resolver.reset();
+    resolver.add_directory(dir);
+
+    CHECK_TRUE(resolver.resolve("b.del", path));
+    CHECK_TRUE(resolver.resolve("a.del", path));
+}
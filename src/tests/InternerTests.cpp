@@ -0,0 +1,59 @@
+#include <string>
+#include <vector>
+
+#include "Interner.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+TEST_GROUP(InternerTests)
+{
+    DEL::Interner interner;
+};
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(InternerTests, idsAreDenseAndStable)
+{
+    DEL::SymbolId a = interner.intern("alpha");
+    DEL::SymbolId b = interner.intern("beta");
+
+    UNSIGNED_LONGS_EQUAL(0, a);
+    UNSIGNED_LONGS_EQUAL(1, b);
+
+    // Asking again gives back the same id, whatever the name is stored in
+    std::string again = "alpha";
+    UNSIGNED_LONGS_EQUAL(a, interner.intern(again));
+    UNSIGNED_LONGS_EQUAL(b, interner.intern(std::string_view("beta_extra").substr(0, 4)));
+
+    STRCMP_EQUAL("alpha", interner.name(a).c_str());
+    STRCMP_EQUAL("beta",  interner.name(b).c_str());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(InternerTests, namesSurviveGrowth)
+{
+    DEL::SymbolId first = interner.intern("first");
+    const std::string * first_name = &interner.name(first);
+
+    std::vector<DEL::SymbolId> ids;
+    for(int i = 0; i < 10000; i++)
+    {
+        ids.push_back(interner.intern("name_" + std::to_string(i)));
+    }
+
+    // Names are looked up through views into the stored names, so they must not move
+    POINTERS_EQUAL(first_name, &interner.name(first));
+    UNSIGNED_LONGS_EQUAL(first, interner.intern("first"));
+
+    for(int i = 0; i < 10000; i++)
+    {
+        UNSIGNED_LONGS_EQUAL(i + 1, ids[i]);
+        STRCMP_EQUAL(("name_" + std::to_string(i)).c_str(), interner.name(ids[i]).c_str());
+        UNSIGNED_LONGS_EQUAL(ids[i], interner.intern("name_" + std::to_string(i)));
+    }
+}
@@ -0,0 +1,149 @@
+#include <sstream>
+
+#include "del_driver.hpp"
+#include "Errors.hpp"
+#include "Interner.hpp"
+#include "Memory.hpp"
+#include "SymbolTable.hpp"
+#include "SystemSettings.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+namespace
+{
+    constexpr uint64_t WORD = DEL::SETTINGS::SYSTEM_WORD_SIZE_BYTES;
+}
+
+//  Memory is only allocated through the symbol table, so the tests declare symbols to fill the slot table
+TEST_GROUP(MemoryTests)
+{
+    std::ostringstream diagnostics;
+    DEL::DEL_Driver driver;
+    DEL::Errors errors{driver};
+    DEL::Memory memory;
+    DEL::Interner interner;
+    DEL::SymbolTable table{errors, memory, interner};
+
+    void setup()
+    {
+        errors.set_batch_mode(diagnostics);
+        table.new_context(interner.intern("main"));
+    }
+
+    DEL::SymbolId declare(const char * name)
+    {
+        DEL::SymbolId id = interner.intern(name);
+        table.add_symbol(id, DEL::ValType::INTEGER);
+        return id;
+    }
+};
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(MemoryTests, slotsAreDenseAndWordAligned)
+{
+    DEL::SymbolId a = declare("a");
+    DEL::SymbolId b = declare("b");
+    DEL::SymbolId c = declare("c");
+
+    UNSIGNED_LONGS_EQUAL(0, memory.get_slot(a));
+    UNSIGNED_LONGS_EQUAL(1, memory.get_slot(b));
+    UNSIGNED_LONGS_EQUAL(2, memory.get_slot(c));
+
+    UNSIGNED_LONGS_EQUAL(0,        memory.get_mem_info(a).start_pos);
+    UNSIGNED_LONGS_EQUAL(WORD,     memory.get_mem_info(b).start_pos);
+    UNSIGNED_LONGS_EQUAL(2 * WORD, memory.get_mem_info(c).start_pos);
+    UNSIGNED_LONGS_EQUAL(3 * WORD, memory.get_currently_allocated_bytes_amnt());
+
+    // The slot and the id lookups agree
+    const DEL::Memory::MemAlloc & by_slot = memory.get_slot_info(memory.get_slot(b));
+    UNSIGNED_LONGS_EQUAL(memory.get_mem_info(b).start_pos,       by_slot.start_pos);
+    UNSIGNED_LONGS_EQUAL(memory.get_mem_info(b).bytes_requested, by_slot.bytes_requested);
+    UNSIGNED_LONGS_EQUAL(WORD, by_slot.bytes_alloced);
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(MemoryTests, unmappedIdsHaveNoSlot)
+{
+    DEL::SymbolId a = declare("a");
+    DEL::SymbolId never = interner.intern("never");
+
+    CHECK_TRUE(memory.is_id_mapped(a));
+    CHECK_FALSE(memory.is_id_mapped(never));
+    UNSIGNED_LONGS_EQUAL(DEL::Memory::NO_SLOT, memory.get_slot(never));
+
+    // Ids past the end of the table are simply not mapped
+    UNSIGNED_LONGS_EQUAL(DEL::Memory::NO_SLOT, memory.get_slot(100000));
+
+    DEL::Memory::MemAlloc info = memory.get_mem_info(never);
+    UNSIGNED_LONGS_EQUAL(0, info.bytes_alloced);
+    UNSIGNED_LONGS_EQUAL(0, info.bytes_requested);
+    UNSIGNED_LONGS_EQUAL(0, info.start_pos);
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(MemoryTests, removedItemsKeepTheirBytes)
+{
+    DEL::SymbolId a = declare("a");
+    DEL::SymbolId b = declare("b");
+
+    memory.remove_item(a);
+
+    CHECK_FALSE(memory.is_id_mapped(a));
+    CHECK_TRUE(memory.is_id_mapped(b));
+
+    // Code already generated may still address the removed item, so its space is not reused
+    UNSIGNED_LONGS_EQUAL(2 * WORD, memory.get_currently_allocated_bytes_amnt());
+
+    DEL::SymbolId c = declare("c");
+    UNSIGNED_LONGS_EQUAL(2 * WORD, memory.get_mem_info(c).start_pos);
+    UNSIGNED_LONGS_EQUAL(2, memory.get_slot(c));
+
+    // Removing something that was never mapped is harmless
+    memory.remove_item(interner.intern("never"));
+    memory.remove_item(100000);
+    UNSIGNED_LONGS_EQUAL(3 * WORD, memory.get_currently_allocated_bytes_amnt());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(MemoryTests, resetStartsTheNextFunctionAfresh)
+{
+    DEL::SymbolId a = declare("a");
+    DEL::SymbolId b = declare("b");
+
+    table.remove_current_context();
+    memory.reset();
+
+    CHECK_FALSE(memory.is_id_mapped(a));
+    CHECK_FALSE(memory.is_id_mapped(b));
+    UNSIGNED_LONGS_EQUAL(0, memory.get_currently_allocated_bytes_amnt());
+
+    table.new_context(interner.intern("next"));
+    DEL::SymbolId c = declare("c");
+
+    UNSIGNED_LONGS_EQUAL(0, memory.get_slot(c));
+    UNSIGNED_LONGS_EQUAL(0, memory.get_mem_info(c).start_pos);
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(MemoryTests, onlyWordsAreFrameResident)
+{
+    CHECK_TRUE(DEL::Memory::is_frame_resident(1));
+    CHECK_TRUE(DEL::Memory::is_frame_resident(WORD));
+    CHECK_FALSE(DEL::Memory::is_frame_resident(WORD + 1));
+    CHECK_FALSE(DEL::Memory::is_frame_resident(64));
+}
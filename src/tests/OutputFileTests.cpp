@@ -0,0 +1,147 @@
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "OutputFile.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+namespace
+{
+    void remove_tree(const std::string & path)
+    {
+        if(::unlink(path.c_str()) == 0) { return; }
+
+        if(DIR * d = ::opendir(path.c_str()))
+        {
+            while(dirent * entry = ::readdir(d))
+            {
+                std::string name = entry->d_name;
+                if(name != "." && name != "..") { remove_tree(path + "/" + name); }
+            }
+            ::closedir(d);
+        }
+        ::rmdir(path.c_str());
+    }
+}
+
+TEST_GROUP(OutputFileTests)
+{
+    std::string dir;
+
+    void setup()
+    {
+        char pattern[] = "/tmp/del_output_XXXXXX";
+        CHECK(::mkdtemp(pattern) != nullptr);
+        dir = pattern;
+    }
+
+    void teardown()
+    {
+        remove_tree(dir);
+    }
+
+    bool write(const std::string & path, const std::string & contents)
+    {
+        return DEL::OutputFile::write(path, contents.data(), contents.size());
+    }
+
+    std::string read(const std::string & path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    //  Number of entries in the scratch directory, so a stray temporary is noticed
+    std::size_t entries()
+    {
+        std::size_t count = 0;
+        DIR * d = ::opendir(dir.c_str());
+        while(dirent * entry = ::readdir(d))
+        {
+            std::string name = entry->d_name;
+            if(name != "." && name != "..") { ++count; }
+        }
+        ::closedir(d);
+        return count;
+    }
+};
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(OutputFileTests, writesAndReplaces)
+{
+    std::string path = dir + "/out.asm";
+
+    CHECK_TRUE(write(path, "first"));
+    STRCMP_EQUAL("first", read(path).c_str());
+
+    CHECK_TRUE(write(path, "second, and longer"));
+    STRCMP_EQUAL("second, and longer", read(path).c_str());
+
+    // Only the destination is left behind
+    UNSIGNED_LONGS_EQUAL(1, entries());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(OutputFileTests, emptyContents)
+{
+    std::string path = dir + "/empty.asm";
+
+    CHECK_TRUE(write(path, "old"));
+    CHECK_TRUE(DEL::OutputFile::write(path, nullptr, 0));
+    STRCMP_EQUAL("", read(path).c_str());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(OutputFileTests, missingDirectoryFails)
+{
+    CHECK_FALSE(write(dir + "/missing/out.asm", "contents"));
+    UNSIGNED_LONGS_EQUAL(0, entries());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(OutputFileTests, failedRenameRemovesTemporary)
+{
+    // A non empty directory can't be replaced by a file, so the temporary is written but the rename fails
+    std::string path = dir + "/taken";
+    CHECK(::mkdir(path.c_str(), 0777) == 0);
+    CHECK_TRUE(write(path + "/inside", "kept"));
+
+    CHECK_FALSE(write(path, "contents"));
+
+    UNSIGNED_LONGS_EQUAL(1, entries());
+    STRCMP_EQUAL("kept", read(path + "/inside").c_str());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(OutputFileTests, failedWriteLeavesOldFile)
+{
+    // A name that fits, but leaves no room for the temporary's suffix. Unlike permissions this fails even as root
+    std::string path = dir + "/" + std::string(250, 'x');
+    std::ofstream(path) << "old contents";
+
+    CHECK_FALSE(write(path, "new contents"));
+
+    STRCMP_EQUAL("old contents", read(path).c_str());
+    UNSIGNED_LONGS_EQUAL(1, entries());
+}
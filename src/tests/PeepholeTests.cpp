@@ -0,0 +1,244 @@
+#include <string>
+#include <utility>
+
+#include "Buffer.hpp"
+#include "Peephole.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+namespace
+{
+    using DEL::CODE::Op;
+    using DEL::CODE::Operand;
+    using DEL::CODE::Stack;
+
+    Operand r(int number)
+    {
+        return Operand::reg(number);
+    }
+
+    const Operand LS = Operand::stack(Stack::LS);
+    const Operand SP = Operand::fixed(0, Stack::LS);
+}
+
+TEST_GROUP(PeepholeTests)
+{
+    DEL::Peephole peephole;
+    DEL::CODE::Buffer code;
+
+    // Optimize what has been added to code, and get the result as text
+    std::string optimize()
+    {
+        return peephole.optimize(std::move(code)).str();
+    }
+
+    uint64_t hits(DEL::PeepholeStats::Rule rule)
+    {
+        return peephole.get_stats().hits[rule];
+    }
+
+    uint64_t total_hits()
+    {
+        uint64_t total = 0;
+        for(int i = 0; i < DEL::PeepholeStats::RULE_COUNT; i++)
+        {
+            total += peephole.get_stats().hits[i];
+        }
+        return total;
+    }
+};
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(PeepholeTests, pushPopBecomesMov)
+{
+    code.instruction(Op::PUSHW, { LS, r(3) });
+    code.instruction(Op::POPW,  { r(4), LS });
+    STRCMP_EQUAL("\tmov r4 r3\n", optimize().c_str());
+    UNSIGNED_LONGS_EQUAL(1, hits(DEL::PeepholeStats::PUSH_POP));
+
+    // Into the same register there is nothing left to do
+    code.instruction(Op::PUSHW, { LS, r(3) });
+    code.instruction(Op::POPW,  { r(3), LS });
+    STRCMP_EQUAL("", optimize().c_str());
+    UNSIGNED_LONGS_EQUAL(2, hits(DEL::PeepholeStats::PUSH_POP));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(PeepholeTests, pushPopAcrossLabelIsKept)
+{
+    // Something may jump to the label with a different value on the stack
+    code.instruction(Op::PUSHW, { LS, r(3) });
+    code.label("label");
+    code.instruction(Op::POPW,  { r(4), LS });
+    STRCMP_EQUAL("\tpushw ls r3\nlabel:\n\tpopw r4 ls\n", optimize().c_str());
+
+    // And nothing is done with the device registers
+    code.instruction(Op::PUSHW, { LS, r(11) });
+    code.instruction(Op::POPW,  { r(4), LS });
+    STRCMP_EQUAL("\tpushw ls r11\n\tpopw r4 ls\n", optimize().c_str());
+
+    UNSIGNED_LONGS_EQUAL(0, total_hits());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(PeepholeTests, repeatedSpLoadIsDropped)
+{
+    code.instruction(Op::LDW, { r(0), SP });
+    code.instruction(Op::ADD, { r(3), r(0), r(4) });
+    code.comment("Comments and blank lines are passed over");
+    code.blank();
+    code.instruction(Op::LDW, { r(0), SP });
+    STRCMP_EQUAL("\tldw r0 $0(ls)\n\tadd r3 r0 r4\n\t; Comments and blank lines are passed over\n\n", optimize().c_str());
+    UNSIGNED_LONGS_EQUAL(1, hits(DEL::PeepholeStats::SP_RELOAD));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(PeepholeTests, spLoadAfterStackStoreIsKept)
+{
+    code.instruction(Op::LDW, { r(0), SP });
+    code.instruction(Op::STW, { SP, r(3) });
+    code.instruction(Op::LDW, { r(0), SP });
+    STRCMP_EQUAL("\tldw r0 $0(ls)\n\tstw $0(ls) r3\n\tldw r0 $0(ls)\n", optimize().c_str());
+
+    code.instruction(Op::LDW, { r(0), SP });
+    code.instruction(Op::ADD, { r(0), r(0), r(4) });
+    code.instruction(Op::LDW, { r(0), SP });
+    STRCMP_EQUAL("\tldw r0 $0(ls)\n\tadd r0 r0 r4\n\tldw r0 $0(ls)\n", optimize().c_str());
+
+    UNSIGNED_LONGS_EQUAL(0, total_hits());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(PeepholeTests, offsetIsFoldedIntoAdd)
+{
+    code.instruction(Op::MOV, { r(1), Operand::imm(16) });
+    code.instruction(Op::ADD, { r(1), r(1), r(0) }, "Item location");
+    STRCMP_EQUAL("\tadd r1 r0 $16\t; Item location\n", optimize().c_str());
+    UNSIGNED_LONGS_EQUAL(1, hits(DEL::PeepholeStats::ADDRESS_OFFSET));
+
+    // Adding nothing is just a move
+    code.instruction(Op::MOV, { r(1), Operand::imm(0) });
+    code.instruction(Op::ADD, { r(1), r(0), r(1) });
+    STRCMP_EQUAL("\tmov r1 r0\n", optimize().c_str());
+    UNSIGNED_LONGS_EQUAL(2, hits(DEL::PeepholeStats::ADDRESS_OFFSET));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(PeepholeTests, largeOffsetIsKept)
+{
+    code.instruction(Op::MOV, { r(1), Operand::imm(40000) });
+    code.instruction(Op::ADD, { r(1), r(1), r(0) });
+    STRCMP_EQUAL("\tmov r1 $40000\n\tadd r1 r1 r0\n", optimize().c_str());
+
+    // The constant is read by something other than the add
+    code.instruction(Op::MOV, { r(1), Operand::imm(16) });
+    code.instruction(Op::STW, { SP, r(1) });
+    code.instruction(Op::ADD, { r(1), r(1), r(0) });
+    STRCMP_EQUAL("\tmov r1 $16\n\tstw $0(ls) r1\n\tadd r1 r1 r0\n", optimize().c_str());
+
+    UNSIGNED_LONGS_EQUAL(0, total_hits());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(PeepholeTests, movChainIsShortened)
+{
+    code.instruction(Op::ADD, { r(3), r(4), r(5) });
+    code.instruction(Op::MOV, { r(6), r(3) });
+    code.instruction(Op::MOV, { r(3), Operand::imm(0) });
+    STRCMP_EQUAL("\tadd r6 r4 r5\n\tmov r3 $0\n", optimize().c_str());
+    UNSIGNED_LONGS_EQUAL(1, hits(DEL::PeepholeStats::MOV_CHAIN));
+
+    code.instruction(Op::MOV, { r(3), r(3) });
+    STRCMP_EQUAL("", optimize().c_str());
+    UNSIGNED_LONGS_EQUAL(2, hits(DEL::PeepholeStats::MOV_CHAIN));
+
+    // The base register of an address is replaced too
+    code.instruction(Op::MOV, { r(3), r(4) });
+    code.instruction(Op::LDW, { r(3), Operand::addr(3, Stack::GS) });
+    STRCMP_EQUAL("\tldw r3 r4(gs)\n", optimize().c_str());
+    UNSIGNED_LONGS_EQUAL(3, hits(DEL::PeepholeStats::MOV_CHAIN));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(PeepholeTests, movChainStillReadIsKept)
+{
+    // r3 is read after the copy, so it can't be computed straight into r6
+    code.instruction(Op::ADD, { r(3), r(4), r(5) });
+    code.instruction(Op::MOV, { r(6), r(3) });
+    code.instruction(Op::STW, { SP, r(3) });
+    STRCMP_EQUAL("\tadd r3 r4 r5\n\tmov r6 r3\n\tstw $0(ls) r3\n", optimize().c_str());
+    UNSIGNED_LONGS_EQUAL(0, total_hits());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(PeepholeTests, jumpToNextIsDropped)
+{
+    code.instruction(Op::JMP, { Operand::label("done") });
+    code.label("other");
+    code.label("done");
+    code.instruction(Op::MOV, { r(3), r(4) });
+    STRCMP_EQUAL("other:\ndone:\n\tmov r3 r4\n", optimize().c_str());
+    UNSIGNED_LONGS_EQUAL(1, hits(DEL::PeepholeStats::JUMP_NEXT));
+
+    code.instruction(Op::BEQ, { r(3), r(4), Operand::label("done") });
+    code.label("done");
+    STRCMP_EQUAL("done:\n", optimize().c_str());
+    UNSIGNED_LONGS_EQUAL(2, hits(DEL::PeepholeStats::JUMP_NEXT));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(PeepholeTests, jumpOverCodeIsKept)
+{
+    code.instruction(Op::JMP, { Operand::label("done") });
+    code.instruction(Op::MOV, { r(3), r(4) });
+    code.label("done");
+    STRCMP_EQUAL("\tjmp done\n\tmov r3 r4\ndone:\n", optimize().c_str());
+    UNSIGNED_LONGS_EQUAL(0, total_hits());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(PeepholeTests, callsAreWalls)
+{
+    // The callee reads the stack, so the push must stay ahead of the call
+    code.instruction(Op::PUSHW, { LS, r(3) });
+    code.instruction(Op::CALL,  { Operand::label("__del__ds__free") });
+    code.instruction(Op::POPW,  { r(4), LS });
+    STRCMP_EQUAL("\tpushw ls r3\n\tcall __del__ds__free\n\tpopw r4 ls\n", optimize().c_str());
+    UNSIGNED_LONGS_EQUAL(0, total_hits());
+
+    UNSIGNED_LONGS_EQUAL(3, peephole.get_stats().instructions_before);
+    UNSIGNED_LONGS_EQUAL(3, peephole.get_stats().instructions_after);
+}
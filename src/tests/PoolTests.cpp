@@ -0,0 +1,142 @@
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "JobPool.hpp"
+#include "WorkPool.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+TEST_GROUP(WorkPoolTests)
+{
+    DEL::WorkPool pool{4};
+};
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(WorkPoolTests, runsEveryTask)
+{
+    std::atomic<int> count{0};
+
+    for(int i = 0; i < 1000; ++i)
+    {
+        pool.submit([&]() { ++count; });
+    }
+    pool.wait();
+
+    LONGS_EQUAL(1000, count.load());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(WorkPoolTests, waitCoversNestedSubmissions)
+{
+    std::atomic<int> count{0};
+
+    for(int i = 0; i < 10; ++i)
+    {
+        pool.submit([&]()
+        {
+            for(int j = 0; j < 10; ++j)
+            {
+                pool.submit([&]() { ++count; });
+            }
+        });
+    }
+    pool.wait();
+
+    LONGS_EQUAL(100, count.load());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(WorkPoolTests, waitRethrowsTaskFailure)
+{
+    std::atomic<int> count{0};
+
+    pool.submit([]() { throw std::runtime_error("task failed"); });
+    for(int i = 0; i < 10; ++i)
+    {
+        pool.submit([&]() { ++count; });
+    }
+
+    bool thrown = false;
+    try
+    {
+        pool.wait();
+    }
+    catch(std::runtime_error & e)
+    {
+        thrown = true;
+        STRCMP_EQUAL("task failed", e.what());
+    }
+    CHECK_TRUE(thrown);
+
+    // The rest of the work still ran, and the failure is only reported once
+    LONGS_EQUAL(10, count.load());
+
+    pool.submit([&]() { ++count; });
+    pool.wait();
+    LONGS_EQUAL(11, count.load());
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(WorkPoolTests, unwaitedFailureIsDropped)
+{
+    // The destructor waits but must not throw
+    DEL::WorkPool local(2);
+    local.submit([]() { throw std::runtime_error("no one waits"); });
+}
+
+TEST_GROUP(JobPoolTests)
+{
+};
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(JobPoolTests, runsEachJobOnce)
+{
+    DEL::JobPool pool(4);
+
+    // More jobs than workers, and a count that doesn't divide evenly between them
+    std::vector<std::atomic<int>> runs(1003);
+    pool.run(runs.size(), [&](std::size_t job) { ++runs[job]; });
+
+    for(auto & r : runs)
+    {
+        LONGS_EQUAL(1, r.load());
+    }
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(JobPoolTests, fewerJobsThanWorkers)
+{
+    DEL::JobPool pool(8);
+
+    std::vector<std::atomic<int>> runs(3);
+    pool.run(runs.size(), [&](std::size_t job) { ++runs[job]; });
+
+    for(auto & r : runs)
+    {
+        LONGS_EQUAL(1, r.load());
+    }
+
+    // Nothing to do returns straight away, and the pool can be used again
+    pool.run(0, [&](std::size_t) { FAIL("No jobs were asked for"); });
+    pool.run(runs.size(), [&](std::size_t job) { ++runs[job]; });
+    LONGS_EQUAL(2, runs[0].load());
+}
@@ -0,0 +1,246 @@
+#include "Codeblock.hpp"
+#include "RegisterAllocator.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+namespace
+{
+    constexpr int FIRST  = DEL::CODE::REG_ALLOCATABLE[0];
+    constexpr int SECOND = DEL::CODE::REG_ALLOCATABLE[1];
+    constexpr int NONE   = DEL::CODE::Registers::NONE;
+}
+
+TEST_GROUP(RegisterAllocatorTests)
+{
+    DEL::RegisterAllocator allocator;
+
+    //  Walk a straight line of points, one call per point
+    void at(uint64_t point)
+    {
+        while(point-- > 0) { allocator.step(); }
+    }
+};
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(RegisterAllocatorTests, disjointLifetimesShareARegister)
+{
+    allocator.define(0);    // 0
+    at(1);
+    allocator.use(0);       // 1
+    at(2);
+    allocator.define(8);    // 3
+    at(1);
+    allocator.use(8);       // 4
+
+    DEL::CODE::Registers result = allocator.allocate();
+    LONGS_EQUAL(FIRST, result.find(0));
+    LONGS_EQUAL(FIRST, result.find(8));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(RegisterAllocatorTests, overlappingLifetimesDoNot)
+{
+    allocator.define(0);    // 0
+    at(1);
+    allocator.define(8);    // 1
+    at(1);
+    allocator.use(0);       // 2
+    allocator.use(8);
+
+    DEL::CODE::Registers result = allocator.allocate();
+    LONGS_EQUAL(FIRST,  result.find(0));
+    LONGS_EQUAL(SECOND, result.find(8));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(RegisterAllocatorTests, pinnedSlotsStayInTheFrame)
+{
+    allocator.define(0);
+    allocator.pin(0);
+    at(1);
+    allocator.use(0);
+
+    LONGS_EQUAL(NONE, allocator.allocate().find(0));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(RegisterAllocatorTests, runningOutLeavesTheLongestInTheFrame)
+{
+    // One more slot live at once than there are registers. Slot 0 lives the longest
+    for(uint64_t slot = 0; slot <= 4; slot++)
+    {
+        allocator.define(slot * 8);
+        at(1);
+    }
+    for(uint64_t slot = 4; slot > 0; slot--)
+    {
+        allocator.use(slot * 8);
+        at(1);
+    }
+    allocator.use(0);
+
+    DEL::CODE::Registers result = allocator.allocate();
+    LONGS_EQUAL(NONE, result.find(0));
+    for(uint64_t slot = 1; slot <= 4; slot++)
+    {
+        CHECK(result.find(slot * 8) != NONE);
+    }
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(RegisterAllocatorTests, loopCarriedValueLivesToTheEndOfTheLoop)
+{
+    // Slot 0 is last read at point 2, but the loop jumps back to that read, so it is still live when
+    // slot 8 is written at point 3. Without the loop the two could share a register
+    allocator.define(0);    // 0
+    at(1);
+    allocator.begin_loop(); // 1
+    at(1);
+    allocator.use(0);       // 2
+    at(1);
+    allocator.define(8);    // 3
+    at(1);
+    allocator.use(8);       // 4
+    at(1);
+    allocator.end_loop();   // 5
+
+    DEL::CODE::Registers result = allocator.allocate();
+    LONGS_EQUAL(FIRST,  result.find(0));
+    LONGS_EQUAL(SECOND, result.find(8));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(RegisterAllocatorTests, valueReadBeforeWrittenInLoopIsCarried)
+{
+    // Slot 8 is only seen inside the loop, but is read before it is written so the value comes from the
+    // previous iteration. Slot 16 is written first and so starts over each time
+    allocator.begin_loop(); // 0
+    at(1);
+    allocator.use(8);       // 1
+    at(1);
+    allocator.define(8);    // 2
+    at(1);
+    allocator.define(16);   // 3
+    at(1);
+    allocator.use(16);      // 4
+    at(1);
+    allocator.end_loop();   // 5
+    at(1);
+    allocator.define(24);   // 6
+    at(1);
+    allocator.use(24);      // 7
+
+    // The loop extends slot 8 to point 6, so slot 24 can't have its register, while slot 16 ended at 4
+    DEL::CODE::Registers result = allocator.allocate();
+    LONGS_EQUAL(FIRST,  result.find(8));
+    LONGS_EQUAL(SECOND, result.find(16));
+    LONGS_EQUAL(SECOND, result.find(24));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(RegisterAllocatorTests, clobberedRegisterIsAvoided)
+{
+    allocator.define(0);    // 0
+    at(1);
+    allocator.clobber(FIRST);
+    at(1);
+    allocator.use(0);       // 2
+
+    LONGS_EQUAL(SECOND, allocator.allocate().find(0));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(RegisterAllocatorTests, clobberAtTheEndsIsAllowed)
+{
+    // Destroyed where the value is first written, and where it is last read
+    allocator.clobber_all();
+    allocator.define(0);    // 0
+    at(2);
+    allocator.use(0);       // 2
+    allocator.clobber_all();
+
+    LONGS_EQUAL(FIRST, allocator.allocate().find(0));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(RegisterAllocatorTests, clobberAllKeepsLiveSlotsInTheFrame)
+{
+    allocator.define(0);    // 0
+    at(1);
+    allocator.clobber_all();
+    at(1);
+    allocator.use(0);       // 2
+
+    LONGS_EQUAL(NONE, allocator.allocate().find(0));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(RegisterAllocatorTests, clobberLaterInLoopReachesCarriedValue)
+{
+    // The call at point 3 is after the last read of slot 0, but the loop comes back round to that read
+    allocator.define(0);    // 0
+    at(1);
+    allocator.begin_loop(); // 1
+    at(1);
+    allocator.use(0);       // 2
+    at(1);
+    allocator.clobber_all();// 3
+    at(1);
+    allocator.end_loop();   // 4
+
+    LONGS_EQUAL(NONE, allocator.allocate().find(0));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(RegisterAllocatorTests, nestedLoopsExtendToTheOuterLoop)
+{
+    // Read in the inner loop only, yet the outer loop comes back to it after the call at point 6
+    allocator.define(0);    // 0
+    at(1);
+    allocator.begin_loop(); // 1
+    at(1);
+    allocator.begin_loop(); // 2
+    at(1);
+    allocator.use(0);       // 3
+    at(1);
+    allocator.end_loop();   // 4
+    at(2);
+    allocator.clobber(FIRST);   // 6
+    at(1);
+    allocator.end_loop();   // 7
+
+    LONGS_EQUAL(SECOND, allocator.allocate().find(0));
+}
@@ -0,0 +1,208 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "del_driver.hpp"
+#include "Errors.hpp"
+#include "Interner.hpp"
+#include "Memory.hpp"
+#include "SymbolTable.hpp"
+
+#include "CppUTest/TestHarness.h"
+
+TEST_GROUP(SymbolTableTests)
+{
+    std::ostringstream diagnostics;
+    DEL::DEL_Driver driver;
+    DEL::Errors errors{driver};
+    DEL::Memory memory;
+    DEL::Interner interner;
+    DEL::SymbolTable table{errors, memory, interner};
+
+    void setup()
+    {
+        // Fatal errors throw rather than exit
+        errors.set_batch_mode(diagnostics);
+        table.new_context(interner.intern("global"));
+        table.new_context(interner.intern("main"));
+    }
+};
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(SymbolTableTests, addAndFind)
+{
+    DEL::SymbolId a = interner.intern("a");
+    DEL::SymbolId b = interner.intern("b");
+    DEL::SymbolId missing = interner.intern("missing");
+
+    table.add_symbol(a, DEL::ValType::INTEGER);
+    table.add_symbol(b, DEL::ValType::REAL);
+
+    CHECK_TRUE(table.does_symbol_exist(a));
+    CHECK_TRUE(table.does_symbol_exist(b));
+    CHECK_FALSE(table.does_symbol_exist(missing));
+
+    CHECK_TRUE(table.get_value_type(a) == DEL::ValType::INTEGER);
+    CHECK_TRUE(table.get_value_type(b) == DEL::ValType::REAL);
+    CHECK_TRUE(table.get_value_type(missing) == DEL::ValType::NONE);
+
+    CHECK_TRUE(table.is_existing_symbol_of_type(a, DEL::ValType::INTEGER));
+    CHECK_FALSE(table.is_existing_symbol_of_type(a, DEL::ValType::REAL));
+    CHECK_FALSE(table.is_existing_symbol_of_type(missing, DEL::ValType::INTEGER));
+
+    CHECK_TRUE(memory.is_id_mapped(a));
+    CHECK_TRUE(memory.is_id_mapped(b));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(SymbolTableTests, redeclarationIsRejected)
+{
+    DEL::SymbolId x = interner.intern("x");
+
+    table.add_symbol(x, DEL::ValType::INTEGER);
+
+    // Not in the same scope, nor in one nested within it
+    CHECK_THROWS(DEL::CompilationFailure, table.add_symbol(x, DEL::ValType::REAL));
+
+    table.new_context(interner.intern("inner"));
+    CHECK_THROWS(DEL::CompilationFailure, table.add_symbol(x, DEL::ValType::REAL));
+    CHECK_TRUE(table.get_value_type(x) == DEL::ValType::INTEGER);
+
+    // Leaving the inner scope doesn't take the outer declaration, or its memory, with it
+    table.remove_current_context();
+    CHECK_TRUE(table.does_symbol_exist(x));
+    CHECK_TRUE(table.get_value_type(x) == DEL::ValType::INTEGER);
+    CHECK_TRUE(memory.is_id_mapped(x));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(SymbolTableTests, popRemovesOnlyTheInnerScope)
+{
+    DEL::SymbolId outer = interner.intern("outer");
+    DEL::SymbolId inner = interner.intern("inner_var");
+    DEL::SymbolId scope = interner.intern("scope");
+
+    table.add_symbol(outer, DEL::ValType::INTEGER);
+
+    table.new_context(scope);
+    table.add_symbol(inner, DEL::ValType::INTEGER);
+
+    CHECK_TRUE(table.does_context_exist(scope));
+    CHECK_TRUE(table.get_current_context_name() == scope);
+    CHECK_TRUE(table.does_symbol_exist(inner));
+
+    table.remove_current_context();
+
+    CHECK_FALSE(table.does_context_exist(scope));
+    CHECK_TRUE(table.get_current_context_name() == interner.intern("main"));
+    CHECK_FALSE(table.does_symbol_exist(inner));
+    CHECK_TRUE(table.does_symbol_exist(outer));
+
+    // The memory manager forgets the popped symbols too
+    CHECK_FALSE(memory.is_id_mapped(inner));
+    CHECK_TRUE(memory.is_id_mapped(outer));
+
+    // A popped name can be declared again
+    table.add_symbol(inner, DEL::ValType::REAL);
+    CHECK_TRUE(table.get_value_type(inner) == DEL::ValType::REAL);
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(SymbolTableTests, indexHandlesManySymbols)
+{
+    DEL::SymbolId kept = interner.intern("kept");
+    table.add_symbol(kept, DEL::ValType::REAL);
+
+    // Enough symbols to make the index grow several times
+    std::vector<DEL::SymbolId> symbols;
+    table.new_context(interner.intern("many"));
+    for(int i = 0; i < 5000; i++)
+    {
+        symbols.push_back(interner.intern("s_" + std::to_string(i)));
+        table.add_symbol(symbols.back(), (i % 2 == 0) ? DEL::ValType::INTEGER : DEL::ValType::CHAR);
+    }
+
+    for(int i = 0; i < 5000; i++)
+    {
+        CHECK_TRUE(table.get_value_type(symbols[i]) == ((i % 2 == 0) ? DEL::ValType::INTEGER : DEL::ValType::CHAR));
+    }
+    CHECK_TRUE(table.get_value_type(kept) == DEL::ValType::REAL);
+
+    table.remove_current_context();
+
+    for(auto & symbol : symbols)
+    {
+        CHECK_FALSE(table.does_symbol_exist(symbol));
+    }
+    CHECK_TRUE(table.get_value_type(kept) == DEL::ValType::REAL);
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(SymbolTableTests, resetForgetsEverything)
+{
+    DEL::SymbolId a = interner.intern("a");
+    DEL::SymbolId f = interner.intern("f");
+
+    table.add_symbol(a, DEL::ValType::INTEGER);
+    table.add_function_signature(f, {}, DEL::ValType::INTEGER);
+    CHECK_TRUE(table.does_function_exist(f));
+
+    table.reset();
+    memory.reset();
+
+    CHECK_FALSE(table.does_symbol_exist(a));
+    CHECK_FALSE(table.does_function_exist(f));
+    CHECK_FALSE(memory.is_id_mapped(a));
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(SymbolTableTests, functionSignatures)
+{
+    DEL::SymbolId f = interner.intern("f");
+    DEL::SymbolId p = interner.intern("p");
+
+    std::vector<DEL::FunctionParam> params;
+    params.push_back(DEL::FunctionParam(DEL::ValType::REAL, p));
+
+    table.add_function_signature(f, params, DEL::ValType::CHAR);
+
+    CHECK_TRUE(table.does_function_exist(f));
+    CHECK_TRUE(table.does_context_exist(f));
+    CHECK_TRUE(table.get_function_return_type(f) == DEL::ValType::CHAR);
+    LONGS_EQUAL(1, table.get_function_parameters(f).size());
+    CHECK_TRUE(table.get_function_parameters(f)[0].type == DEL::ValType::REAL);
+}
+
+// ---------------------------------------------------------------
+//
+// ---------------------------------------------------------------
+
+TEST(SymbolTableTests, errorsGoToTheDiagnosticsStream)
+{
+    // Anything but a word can't be generated yet
+    CHECK_THROWS(DEL::CompilationFailure, table.add_symbol(interner.intern("wide"), DEL::ValType::INTEGER, 16));
+
+    CHECK(diagnostics.str().find("You just attempted to allocate \"16\" bytes") != std::string::npos);
+    CHECK(diagnostics.str().find("Requires further development") != std::string::npos);
+
+    // Asking about an undeclared function is a developer error
+    CHECK_THROWS(DEL::CompilationFailure, table.get_function_return_type(interner.intern("nothing")));
+}
@@ -0,0 +1,11 @@
+#include "CppUTest/CommandLineTestRunner.h"
+#include "CppUTest/MemoryLeakWarningPlugin.h"
+
+int main(int ac, char** av)
+{
+    // The compiler starts worker threads and builds some tables on first use, which the leak
+    // checker would report against whichever test happened to get there first
+    MemoryLeakWarningPlugin::turnOffNewDeleteOverloads();
+
+    return CommandLineTestRunner::RunAllTests(ac, av);
+}
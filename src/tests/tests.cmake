@@ -0,0 +1,42 @@
+set(DEL_TEST_DIR
+    ${CMAKE_CURRENT_SOURCE_DIR}/tests
+)
+
+set(DEL_TEST_SOURCES
+    ${DEL_TEST_DIR}/main.cpp
+    ${DEL_TEST_DIR}/ArenaTests.cpp
+    ${DEL_TEST_DIR}/FoldTests.cpp
+    ${DEL_TEST_DIR}/IncludeResolverTests.cpp
+    ${DEL_TEST_DIR}/InternerTests.cpp
+    ${DEL_TEST_DIR}/MemoryTests.cpp
+    ${DEL_TEST_DIR}/OutputFileTests.cpp
+    ${DEL_TEST_DIR}/PeepholeTests.cpp
+    ${DEL_TEST_DIR}/PoolTests.cpp
+    ${DEL_TEST_DIR}/RegisterAllocatorTests.cpp
+    ${DEL_TEST_DIR}/SymbolTableTests.cpp
+)
+
+include_directories(${CPPUTEST_INCLUDE_DIRS})
+link_directories(${CPPUTEST_LIBRARIES})
+
+add_executable(del_tests
+        ${DEL_TEST_SOURCES}
+        ${DEL_COMPILER_SOURCES}
+)
+
+target_link_libraries(del_tests
+    PRIVATE
+        ${LIBNABLA_LIBRARIES}
+        Threads::Threads
+        ${CPPUTEST_LDFLAGS}
+)
+
+enable_testing()
+
+add_test(NAME del_tests COMMAND del_tests)
+
+# Run the tests as part of the build so a failure stops it
+add_custom_command(TARGET del_tests POST_BUILD
+    COMMAND del_tests
+    COMMENT "Running DEL unit tests"
+)